@@ -0,0 +1,266 @@
+#include "AnimationKernel.h"
+#include "SceneStore.h"
+#include <cmath>
+#include <cstring>
+
+#ifdef ANIMATION_KERNEL_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+const float PI_F = 3.14159265358979f;
+const float HALF_PI = PI_F / 2.0f;
+const float TWO_PI = PI_F * 2.0f;
+const float INV_TWO_PI = 1.0f / TWO_PI;
+const float HALF_DEG_TO_RAD = PI_F / 360.0f; // unghi in grade -> jumatate de unghi in radiani
+
+// Coeficientii Taylor pana la x^9, suficienti pe [-pi/2, pi/2]
+const float SIN_C3 = -1.0f / 6.0f;
+const float SIN_C5 = 1.0f / 120.0f;
+const float SIN_C7 = -1.0f / 5040.0f;
+const float SIN_C9 = 1.0f / 362880.0f;
+
+// Parametrii animatiilor (aceiasi ca in varianta initiala din updateAnimations)
+const float ROTATE_SPEED = 30.0f; // grade pe secunda
+const float BOUNCE_SPEED = 2.0f;
+const float BOUNCE_HEIGHT = 2.0f;
+const float FLOAT_SPEED = 0.5f;
+const float FLOAT_HEIGHT = 1.0f;
+const float PULSE_SPEED = 3.0f;
+const float PULSE_AMOUNT = 0.2f;
+const float GLOW_SPEED = 2.0f;
+const float SWING_SPEED = 1.5f;
+const float SWING_ANGLE = 15.0f; // grade
+
+// Fazele sunt pastrate in [0, 2pi), altfel precizia sinusului scade in timp
+inline float wrapPhase(float phase)
+{
+    return phase >= TWO_PI ? phase - TWO_PI : phase;
+}
+
+#ifdef ANIMATION_KERNEL_SSE2
+
+inline __m128 select(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline __m128 sin4(__m128 x)
+{
+    // Reducere la [-pi, pi] (rotunjire la cel mai apropiat intreg), apoi reflexie in [-pi/2, pi/2]
+    const __m128 turns = _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(INV_TWO_PI))));
+    x = _mm_sub_ps(x, _mm_mul_ps(turns, _mm_set1_ps(TWO_PI)));
+
+    const __m128 pi = _mm_set1_ps(PI_F);
+    const __m128 negPi = _mm_set1_ps(-PI_F);
+    x = select(_mm_cmpgt_ps(x, _mm_set1_ps(HALF_PI)), _mm_sub_ps(pi, x), x);
+    x = select(_mm_cmplt_ps(x, _mm_set1_ps(-HALF_PI)), _mm_sub_ps(negPi, x), x);
+
+    const __m128 x2 = _mm_mul_ps(x, x);
+    __m128 poly = _mm_add_ps(_mm_set1_ps(SIN_C7), _mm_mul_ps(x2, _mm_set1_ps(SIN_C9)));
+    poly = _mm_add_ps(_mm_set1_ps(SIN_C5), _mm_mul_ps(x2, poly));
+    poly = _mm_add_ps(_mm_set1_ps(SIN_C3), _mm_mul_ps(x2, poly));
+    poly = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(x2, poly));
+    return _mm_mul_ps(x, poly);
+}
+
+inline __m128 wrapPhase4(__m128 phase)
+{
+    const __m128 twoPi = _mm_set1_ps(TWO_PI);
+    return _mm_sub_ps(phase, _mm_and_ps(_mm_cmpge_ps(phase, twoPi), twoPi));
+}
+
+inline __m128 flagMask(__m128i flags, int flag)
+{
+    const __m128i bit = _mm_set1_epi32(flag);
+    return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(flags, bit), bit));
+}
+
+#endif
+
+} // namespace
+
+float AnimationKernel::fastSin(float x)
+{
+    x -= TWO_PI * std::nearbyint(x * INV_TWO_PI);
+    if (x > HALF_PI) {
+        x = PI_F - x;
+    } else if (x < -HALF_PI) {
+        x = -PI_F - x;
+    }
+
+    const float x2 = x * x;
+    return x * (1.0f + x2 * (SIN_C3 + x2 * (SIN_C5 + x2 * (SIN_C7 + x2 * SIN_C9))));
+}
+
+bool AnimationKernel::isVectorized()
+{
+#ifdef ANIMATION_KERNEL_SSE2
+    return true;
+#else
+    return false;
+#endif
+}
+
+void AnimationKernel::evaluate(SceneStore &store, float deltaTime)
+{
+    const int count = store.size();
+    m_offsetY.resize(count);
+    m_scale.resize(count);
+    m_rotationW.resize(count);
+    m_rotationX.resize(count);
+    m_rotationY.resize(count);
+    m_rotationZ.resize(count);
+
+#ifdef ANIMATION_KERNEL_SSE2
+    const int vectorEnd = m_scalarOnly ? 0 : count & ~3;
+    evaluateSse2(store, vectorEnd, deltaTime);
+    evaluateScalar(store, vectorEnd, count, deltaTime);
+#else
+    evaluateScalar(store, 0, count, deltaTime);
+#endif
+}
+
+void AnimationKernel::evaluateScalar(SceneStore &store, int begin, int end, float deltaTime)
+{
+    for (int i = begin; i < end; ++i) {
+        const quint8 program = store.animationFlags[i];
+        float offset = 0.0f;
+        float scale = store.baseScales[i];
+        float rotateHalfAngle = 0.0f;
+        float swingHalfAngle = 0.0f;
+
+        if (program & SceneStore::AnimateRotate) {
+            float &angle = store.rotationAngles[i];
+            angle += ROTATE_SPEED * deltaTime;
+            if (angle > 360.0f) {
+                angle -= 360.0f;
+            }
+            rotateHalfAngle = angle * HALF_DEG_TO_RAD;
+        }
+        if (program & SceneStore::AnimateBounce) {
+            float &phase = store.bouncePhases[i];
+            phase = wrapPhase(phase + BOUNCE_SPEED * deltaTime);
+            offset += std::fabs(fastSin(phase)) * BOUNCE_HEIGHT;
+        }
+        if (program & SceneStore::AnimateFloat) {
+            float &phase = store.floatPhases[i];
+            phase = wrapPhase(phase + FLOAT_SPEED * deltaTime);
+            offset += fastSin(phase) * FLOAT_HEIGHT;
+        }
+        if (program & SceneStore::AnimatePulse) {
+            float &phase = store.pulsePhases[i];
+            phase = wrapPhase(phase + PULSE_SPEED * deltaTime);
+            scale *= 1.0f + fastSin(phase) * PULSE_AMOUNT;
+        }
+        if (program & SceneStore::AnimateGlow) {
+            store.pulsePhases[i] = wrapPhase(store.pulsePhases[i] + GLOW_SPEED * deltaTime);
+        }
+        if (program & SceneStore::AnimateSwing) {
+            float &phase = store.swingPhases[i];
+            phase = wrapPhase(phase + SWING_SPEED * deltaTime);
+            swingHalfAngle = fastSin(phase) * SWING_ANGLE * HALF_DEG_TO_RAD;
+        }
+
+        // q = rotY(a) * rotZ(b), scris direct pe componente
+        const float sinY = fastSin(rotateHalfAngle);
+        const float cosY = fastSin(rotateHalfAngle + HALF_PI);
+        const float sinZ = fastSin(swingHalfAngle);
+        const float cosZ = fastSin(swingHalfAngle + HALF_PI);
+
+        m_offsetY[i] = offset;
+        m_scale[i] = scale;
+        m_rotationW[i] = cosY * cosZ;
+        m_rotationX[i] = sinY * sinZ;
+        m_rotationY[i] = sinY * cosZ;
+        m_rotationZ[i] = cosY * sinZ;
+    }
+}
+
+#ifdef ANIMATION_KERNEL_SSE2
+
+void AnimationKernel::evaluateSse2(SceneStore &store, int end, float deltaTime)
+{
+    const quint8 *flags = store.animationFlags.constData();
+    float *rotationAngles = store.rotationAngles.data();
+    float *bouncePhases = store.bouncePhases.data();
+    float *floatPhases = store.floatPhases.data();
+    float *pulsePhases = store.pulsePhases.data();
+    float *swingPhases = store.swingPhases.data();
+    const float *baseScales = store.baseScales.constData();
+
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 halfPi = _mm_set1_ps(HALF_PI);
+    const __m128 halfDegToRad = _mm_set1_ps(HALF_DEG_TO_RAD);
+    const __m128 fullTurn = _mm_set1_ps(360.0f);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+    const __m128 rotateStep = _mm_set1_ps(ROTATE_SPEED * deltaTime);
+    const __m128 bounceStep = _mm_set1_ps(BOUNCE_SPEED * deltaTime);
+    const __m128 floatStep = _mm_set1_ps(FLOAT_SPEED * deltaTime);
+    const __m128 pulseStep = _mm_set1_ps(PULSE_SPEED * deltaTime);
+    const __m128 glowStep = _mm_set1_ps(GLOW_SPEED * deltaTime);
+    const __m128 swingStep = _mm_set1_ps(SWING_SPEED * deltaTime);
+
+    for (int i = 0; i < end; i += 4) {
+        // 4 octeti de flag-uri -> 4 intregi pe 32 de biti
+        int packedFlags;
+        std::memcpy(&packedFlags, flags + i, sizeof(packedFlags));
+        __m128i program = _mm_cvtsi32_si128(packedFlags);
+        program = _mm_unpacklo_epi8(program, _mm_setzero_si128());
+        program = _mm_unpacklo_epi16(program, _mm_setzero_si128());
+
+        const __m128 rotateMask = flagMask(program, SceneStore::AnimateRotate);
+        const __m128 bounceMask = flagMask(program, SceneStore::AnimateBounce);
+        const __m128 floatMask = flagMask(program, SceneStore::AnimateFloat);
+        const __m128 pulseMask = flagMask(program, SceneStore::AnimatePulse);
+        const __m128 glowMask = flagMask(program, SceneStore::AnimateGlow);
+        const __m128 swingMask = flagMask(program, SceneStore::AnimateSwing);
+
+        // Rotatie continua pe Y
+        __m128 angle = _mm_add_ps(_mm_loadu_ps(rotationAngles + i), _mm_and_ps(rotateMask, rotateStep));
+        angle = _mm_sub_ps(angle, _mm_and_ps(_mm_cmpgt_ps(angle, fullTurn), fullTurn));
+        _mm_storeu_ps(rotationAngles + i, angle);
+        const __m128 rotateHalfAngle = _mm_and_ps(rotateMask, _mm_mul_ps(angle, halfDegToRad));
+
+        // Bounce si float se aduna pe Y
+        __m128 bounce = wrapPhase4(_mm_add_ps(_mm_loadu_ps(bouncePhases + i), _mm_and_ps(bounceMask, bounceStep)));
+        _mm_storeu_ps(bouncePhases + i, bounce);
+        __m128 floating = wrapPhase4(_mm_add_ps(_mm_loadu_ps(floatPhases + i), _mm_and_ps(floatMask, floatStep)));
+        _mm_storeu_ps(floatPhases + i, floating);
+
+        __m128 offset = _mm_and_ps(bounceMask,
+                                   _mm_mul_ps(_mm_and_ps(sin4(bounce), absMask), _mm_set1_ps(BOUNCE_HEIGHT)));
+        offset = _mm_add_ps(offset, _mm_and_ps(floatMask, _mm_mul_ps(sin4(floating), _mm_set1_ps(FLOAT_HEIGHT))));
+
+        // Pulse modifica scala; glow doar avanseaza aceeasi faza
+        __m128 pulse = wrapPhase4(_mm_add_ps(_mm_loadu_ps(pulsePhases + i), _mm_and_ps(pulseMask, pulseStep)));
+        const __m128 pulseFactor = _mm_add_ps(one, _mm_and_ps(pulseMask,
+                                                              _mm_mul_ps(sin4(pulse), _mm_set1_ps(PULSE_AMOUNT))));
+        const __m128 scale = _mm_mul_ps(_mm_loadu_ps(baseScales + i), pulseFactor);
+        pulse = wrapPhase4(_mm_add_ps(pulse, _mm_and_ps(glowMask, glowStep)));
+        _mm_storeu_ps(pulsePhases + i, pulse);
+
+        // Pendul pe Z
+        __m128 swing = wrapPhase4(_mm_add_ps(_mm_loadu_ps(swingPhases + i), _mm_and_ps(swingMask, swingStep)));
+        _mm_storeu_ps(swingPhases + i, swing);
+        const __m128 swingHalfAngle = _mm_and_ps(swingMask,
+                                                 _mm_mul_ps(sin4(swing), _mm_set1_ps(SWING_ANGLE * HALF_DEG_TO_RAD)));
+
+        // q = rotY(a) * rotZ(b)
+        const __m128 sinY = sin4(rotateHalfAngle);
+        const __m128 cosY = sin4(_mm_add_ps(rotateHalfAngle, halfPi));
+        const __m128 sinZ = sin4(swingHalfAngle);
+        const __m128 cosZ = sin4(_mm_add_ps(swingHalfAngle, halfPi));
+
+        _mm_storeu_ps(m_offsetY.data() + i, offset);
+        _mm_storeu_ps(m_scale.data() + i, scale);
+        _mm_storeu_ps(m_rotationW.data() + i, _mm_mul_ps(cosY, cosZ));
+        _mm_storeu_ps(m_rotationX.data() + i, _mm_mul_ps(sinY, sinZ));
+        _mm_storeu_ps(m_rotationY.data() + i, _mm_mul_ps(sinY, cosZ));
+        _mm_storeu_ps(m_rotationZ.data() + i, _mm_mul_ps(cosY, sinZ));
+    }
+}
+
+#endif
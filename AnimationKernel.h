@@ -0,0 +1,52 @@
+#ifndef ANIMATIONKERNEL_H
+#define ANIMATIONKERNEL_H
+
+#include <QVector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ANIMATION_KERNEL_SSE2
+#endif
+
+class SceneStore;
+
+// Evaluator pe loturi pentru animatiile individuale (rotate/bounce/float/pulse/swing/glow).
+// Avanseaza fazele din SceneStore si calculeaza pentru fiecare obiect deplasarea pe Y,
+// scala si rotatia finala (Y apoi Z, ca in updateAnimations), cate 4 obiecte pe instructiune
+// cu SSE2, sau scalar pe platformele fara SSE2. Rezultatele raman in vectori proprii
+// (structure of arrays) si sunt scrise in QTransform de apelant.
+class AnimationKernel
+{
+public:
+    void evaluate(SceneStore &store, float deltaTime);
+
+    int size() const { return m_offsetY.size(); }
+    const float *offsetY() const { return m_offsetY.constData(); }
+    const float *scale() const { return m_scale.constData(); }
+    // Componentele cuaternionului de rotatie (w, x, y, z)
+    const float *rotationW() const { return m_rotationW.constData(); }
+    const float *rotationX() const { return m_rotationX.constData(); }
+    const float *rotationY() const { return m_rotationY.constData(); }
+    const float *rotationZ() const { return m_rotationZ.constData(); }
+
+    // Aproximare polinomiala a sinusului (eroare < 1e-5 dupa reducerea la [-pi/2, pi/2])
+    static float fastSin(float x);
+    static bool isVectorized();
+    // Evalueaza totul pe calea scalara chiar daca SSE2 este disponibil (pentru comparatii, vezi animbench)
+    void setScalarOnly(bool scalarOnly) { m_scalarOnly = scalarOnly; }
+
+private:
+    void evaluateScalar(SceneStore &store, int begin, int end, float deltaTime);
+#ifdef ANIMATION_KERNEL_SSE2
+    void evaluateSse2(SceneStore &store, int end, float deltaTime);
+#endif
+
+    QVector<float> m_offsetY;
+    QVector<float> m_scale;
+    QVector<float> m_rotationW;
+    QVector<float> m_rotationX;
+    QVector<float> m_rotationY;
+    QVector<float> m_rotationZ;
+    bool m_scalarOnly = false;
+};
+
+#endif // ANIMATIONKERNEL_H
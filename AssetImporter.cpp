@@ -0,0 +1,731 @@
+#include "AssetImporter.h"
+#include "MeshCooker.h"
+#include "MeshData.h"
+#include "ModelBounds.h"
+#include "ModelCatalog.h"
+#include "ModelLod.h"
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QMatrix4x4>
+#include <QPainter>
+#include <QPolygonF>
+#include <QRunnable>
+#include <QSet>
+#include <QThread>
+#include <QUuid>
+#include <algorithm>
+#include <cstdio>
+
+#if defined(Q_OS_LINUX)
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#elif defined(Q_OS_MACOS)
+#include <sys/clonefile.h>
+#include <unistd.h>
+#elif defined(Q_OS_WIN)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace {
+
+constexpr qint64 COPY_BLOCK_SIZE = 4 * 1024 * 1024;
+constexpr int THUMBNAIL_SIZE = 128;
+
+QString stagingPathOf(const QString &primitivesPath)
+{
+    return QDir::cleanPath(primitivesPath + "/../.importing") + "/";
+}
+
+// Clona copy-on-write (btrfs/XFS pe Linux, APFS pe macOS): datele nu sunt copiate, iar
+// o modificare ulterioara a sursei nu afecteaza modelul importat
+bool cloneFile(const QString &source, const QString &destination)
+{
+#if defined(Q_OS_LINUX) && defined(FICLONE)
+    QFile in(source);
+    QFile out(destination);
+    if (!in.open(QIODevice::ReadOnly) || !out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    const bool cloned = ::ioctl(out.handle(), FICLONE, in.handle()) == 0;
+    out.close();
+    if (!cloned) {
+        QFile::remove(destination);
+    }
+    return cloned;
+#elif defined(Q_OS_MACOS)
+    return ::clonefile(QFile::encodeName(source).constData(), QFile::encodeName(destination).constData(), 0) == 0;
+#else
+    Q_UNUSED(source);
+    Q_UNUSED(destination);
+    return false;
+#endif
+}
+
+bool hardlinkFile(const QString &source, const QString &destination)
+{
+#if defined(Q_OS_WIN)
+    const QString nativeSource = QDir::toNativeSeparators(source);
+    const QString nativeDestination = QDir::toNativeSeparators(destination);
+    return ::CreateHardLinkW(reinterpret_cast<LPCWSTR>(nativeDestination.utf16()),
+                             reinterpret_cast<LPCWSTR>(nativeSource.utf16()), nullptr) != 0;
+#elif defined(Q_OS_UNIX)
+    return ::link(QFile::encodeName(source).constData(), QFile::encodeName(destination).constData()) == 0;
+#else
+    Q_UNUSED(source);
+    Q_UNUSED(destination);
+    return false;
+#endif
+}
+
+// Muta fisierul copiat peste destinatie; daca mutarea esueaza, originalul ramane neatins.
+// Pe POSIX rename() inlocuieste atomic destinatia; altfel originalul este mutat deoparte si
+// pus la loc la esec.
+bool replaceFile(const QString &staged, const QString &destination)
+{
+#if defined(Q_OS_UNIX)
+    return ::rename(QFile::encodeName(staged).constData(), QFile::encodeName(destination).constData()) == 0;
+#else
+    if (!QFileInfo::exists(destination)) {
+        return QFile::rename(staged, destination);
+    }
+    const QString backup = staged + ".previous";
+    if (!QFile::rename(destination, backup)) {
+        return false;
+    }
+    if (!QFile::rename(staged, destination)) {
+        QFile::rename(backup, destination);
+        return false;
+    }
+    QFile::remove(backup);
+    return true;
+#endif
+}
+
+// Copie pe blocuri, ca un fisier mare sa poata fi anulat la jumatate
+bool copyFile(const QString &source, const QString &destination, const QSharedPointer<QAtomicInt> &token,
+              bool &cancelled, QString &error)
+{
+    QFile in(source);
+    if (!in.open(QIODevice::ReadOnly)) {
+        error = in.errorString();
+        return false;
+    }
+    QFile out(destination);
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        error = out.errorString();
+        return false;
+    }
+
+    QByteArray buffer(int(qMin(COPY_BLOCK_SIZE, qMax<qint64>(in.size(), 1))), Qt::Uninitialized);
+    while (!in.atEnd()) {
+        if (token->loadAcquire()) {
+            cancelled = true;
+            return false;
+        }
+        const qint64 read = in.read(buffer.data(), buffer.size());
+        if (read < 0 || out.write(buffer.constData(), read) != read) {
+            error = read < 0 ? in.errorString() : out.errorString();
+            return false;
+        }
+    }
+    return true;
+}
+
+// Proiectie ortografica din directia (1, 1, 1); triunghiurile sunt desenate de la cel mai
+// departat la cel mai apropiat, cu o lumina din directia privirii
+QImage renderThumbnail(const MeshData &mesh, const ModelBounds &bounds)
+{
+    QImage image(THUMBNAIL_SIZE, THUMBNAIL_SIZE, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    if (!bounds.valid || bounds.sphereRadius <= 0.0f) {
+        return image;
+    }
+
+    QMatrix4x4 view;
+    const QVector3D direction = QVector3D(1.0f, 1.0f, 1.0f).normalized();
+    view.lookAt(bounds.sphereCenter + direction * bounds.sphereRadius * 2.0f, bounds.sphereCenter,
+                QVector3D(0.0f, 1.0f, 0.0f));
+
+    const float scale = THUMBNAIL_SIZE * 0.48f / bounds.sphereRadius;
+    QVector<QVector3D> projected(mesh.vertexCount());
+    for (int i = 0; i < mesh.vertexCount(); ++i) {
+        const QVector3D p = view.map(mesh.positions[i]);
+        projected[i] = QVector3D(THUMBNAIL_SIZE * 0.5f + p.x() * scale, THUMBNAIL_SIZE * 0.5f - p.y() * scale, p.z());
+    }
+
+    // Camera priveste spre -z: adancimea cea mai mica este cea mai departata
+    const int triangleCount = mesh.triangleCount();
+    QVector<int> order(triangleCount);
+    QVector<float> depths(triangleCount);
+    for (int t = 0; t < triangleCount; ++t) {
+        order[t] = t;
+        depths[t] = projected[mesh.indices[t * 3]].z() + projected[mesh.indices[t * 3 + 1]].z()
+                    + projected[mesh.indices[t * 3 + 2]].z();
+    }
+    std::sort(order.begin(), order.end(), [&depths](int a, int b) { return depths[a] < depths[b]; });
+
+    QPainter painter(&image);
+    painter.setPen(Qt::NoPen);
+    for (int t : order) {
+        const QVector3D &a = projected[mesh.indices[t * 3]];
+        const QVector3D &b = projected[mesh.indices[t * 3 + 1]];
+        const QVector3D &c = projected[mesh.indices[t * 3 + 2]];
+
+        // Normala in spatiul camerei; ordinea varfurilor nu e garantata, deci folosim valoarea absoluta
+        const QVector3D normal = QVector3D::crossProduct(
+            view.mapVector(mesh.positions[mesh.indices[t * 3 + 1]] - mesh.positions[mesh.indices[t * 3]]),
+            view.mapVector(mesh.positions[mesh.indices[t * 3 + 2]] - mesh.positions[mesh.indices[t * 3]]));
+        const float length = normal.length();
+        if (length <= 0.0f) {
+            continue;
+        }
+        const int shade = int(255.0f * (0.25f + 0.75f * qAbs(normal.z()) / length));
+        painter.setBrush(QColor(shade, shade, shade));
+        painter.drawPolygon(QPolygonF({ QPointF(a.x(), a.y()), QPointF(b.x(), b.y()), QPointF(c.x(), c.y()) }));
+    }
+    painter.end();
+    return image;
+}
+
+// Manifestul nivelurilor si antetul blob-urilor gatite retin dimensiunea si mtime-ul sursei;
+// o copie a unui fisier existent primeste mtime-ul lui, ca fisierele derivate sa ramana valide
+void copyModificationTime(const QString &from, const QString &to)
+{
+    QFile file(to);
+    if (file.open(QIODevice::ReadWrite | QIODevice::ExistingOnly)) {
+        file.setFileTime(QFileInfo(from).lastModified(), QFileDevice::FileModificationTime);
+    }
+}
+
+// Clona copy-on-write, hardlink (doar daca sunt permise) sau copie; true daca datele sunt partajate
+bool shareOrCopyFile(const QString &from, const QString &to, bool allowHardlinks)
+{
+    if (cloneFile(from, to)) {
+        copyModificationTime(from, to);
+        return true;
+    }
+    if (allowHardlinks && hardlinkFile(from, to)) {
+        return true;
+    }
+    if (!QFile::copy(from, to)) {
+        return false;
+    }
+    copyModificationTime(from, to);
+    return false;
+}
+
+// Un fisier cu acelasi continut (si acelasi mtime) ca tinta lui preia nivelurile de detaliu
+// si modelele gatite ale acesteia in loc sa le genereze din nou. Ruleaza pe ModelLod::queue,
+// dupa generarea nivelurilor tintei.
+void aliasDerivedFiles(const QString &target, const QString &alias, bool allowHardlinks)
+{
+    ModelLod::removeLods(alias);
+    const ModelLod::Info info = ModelLod::info(target);
+    if (info.isValid()) {
+        ModelLod::makeLodDirectory(alias);
+        for (int level = 1; level < info.levelCount(); ++level) {
+            shareOrCopyFile(ModelLod::levelPath(target, level), ModelLod::levelPath(alias, level), allowHardlinks);
+        }
+        QFile::copy(ModelLod::manifestPath(target), ModelLod::manifestPath(alias));
+    }
+
+    // La fel blob-urile gatite, valide cat timp nivelurile au dimensiunea si mtime-ul tintei
+    for (int level = 0; level < qMax(1, info.levelCount()); ++level) {
+        const QString cooked = MeshCooker::cookedPath(ModelLod::levelPath(alias, level));
+        QDir().mkpath(QFileInfo(cooked).absolutePath());
+        QFile::remove(cooked);
+        QFile::copy(MeshCooker::cookedPath(ModelLod::levelPath(target, level)), cooked);
+    }
+}
+
+} // namespace
+
+AssetImporter::AssetImporter(const QString &primitivesPath, QObject *parent)
+    : QObject(parent), m_primitivesPath(primitivesPath), m_token(CancelToken::create(0)), m_state(State::Idle),
+      m_hardlinksAllowed(false), m_scheduled(0), m_done(0), m_bytesTotal(0), m_bytesDone(0)
+{
+    // Copierea este limitata de disc; restul nucleelor raman pentru GUI si Qt3D
+    m_pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount() - 1, 4));
+
+    // Copii ramase de la un import intrerupt (ex. aplicatia a fost inchisa fortat)
+    QDir(stagingPathOf(m_primitivesPath)).removeRecursively();
+}
+
+AssetImporter::~AssetImporter()
+{
+    m_token->storeRelease(1);
+    m_pool.waitForDone();
+}
+
+const QStringList &AssetImporter::nameFilters()
+{
+    static const QStringList filters = {
+        "*.obj", "*.fbx", "*.gltf", "*.glb", "*.3ds", "*.dae", "*.ply", "*.stl"
+    };
+    return filters;
+}
+
+QString AssetImporter::thumbnailsPath(const QString &primitivesPath)
+{
+    return QDir::cleanPath(primitivesPath + "/../Thumbnails") + "/";
+}
+
+QString AssetImporter::thumbnailPath(const QString &primitivesPath, const QString &modelPath)
+{
+    return thumbnailsPath(primitivesPath) + QFileInfo(modelPath).fileName() + ".png";
+}
+
+bool AssetImporter::start(const QStringList &sources, ConflictPolicy policy)
+{
+    if (isRunning()) {
+        return false;
+    }
+
+    m_state = State::Scanning;
+    m_summary = Summary();
+    m_timer.start();
+
+    const CancelToken token = m_token;
+    const QString primitivesPath = m_primitivesPath;
+    const QHash<QString, AssetStore::Entry> library = AssetStore::instance()->snapshot();
+    m_pool.start(QRunnable::create([this, sources, primitivesPath, library, token, policy]() {
+        const auto reportProgress = [this](int hashed, int total) {
+            QMetaObject::invokeMethod(this, [this, hashed, total]() {
+                emit scanProgress(hashed, total);
+            }, Qt::QueuedConnection);
+        };
+        const ScanResult result = scan(sources, primitivesPath, library, token, reportProgress);
+        QMetaObject::invokeMethod(this, [this, result, policy]() {
+            onScanned(result);
+            if (m_state != State::Scanning) {
+                return;
+            }
+
+            int conflicts = 0;
+            QStringList names;
+            for (const Item &item : m_items) {
+                if (item.conflict) {
+                    ++conflicts;
+                    names.append(item.fileName);
+                }
+            }
+            if (conflicts > 0 && policy == ConflictPolicy::Ask) {
+                m_state = State::AwaitingPolicy;
+                emit conflictsFound(names, m_items.size());
+            } else {
+                schedule(policy);
+            }
+        }, Qt::QueuedConnection);
+    }));
+    return true;
+}
+
+AssetImporter::ScanResult AssetImporter::scan(const QStringList &sources, const QString &primitivesPath,
+                                              const QHash<QString, AssetStore::Entry> &library,
+                                              const CancelToken &token,
+                                              const std::function<void(int, int)> &reportProgress)
+{
+    ScanResult result;
+
+    QStringList files;
+    for (const QString &source : sources) {
+        const QFileInfo info(source);
+        if (info.isDir()) {
+            QDirIterator iterator(source, nameFilters(), QDir::Files, QDirIterator::Subdirectories);
+            while (iterator.hasNext() && !token->loadAcquire()) {
+                files.append(iterator.next());
+            }
+        } else if (info.isFile()) {
+            files.append(info.absoluteFilePath());
+        }
+    }
+
+    // Doar modelele din primitives cu aceeasi dimensiune pot avea acelasi continut; hash-ul lor
+    // vine din index, iar cele lipsa sunt calculate aici si intoarse pentru AssetStore
+    QHash<qint64, QStringList> librarySizes;
+    QDirIterator iterator(primitivesPath, nameFilters(), QDir::Files, QDirIterator::Subdirectories);
+    while (iterator.hasNext() && !token->loadAcquire()) {
+        const QString path = QFileInfo(iterator.next()).absoluteFilePath();
+        if (!ModelLod::isLodFile(path)) {
+            librarySizes[QFileInfo(path).size()].append(path);
+        }
+    }
+
+    QHash<QString, QByteArray> libraryHashes;
+    const auto libraryHash = [&](const QString &path) {
+        auto cached = libraryHashes.constFind(path);
+        if (cached != libraryHashes.constEnd()) {
+            return *cached;
+        }
+        QByteArray hash;
+        auto known = library.constFind(path);
+        if (known != library.constEnd() && AssetStore::matches(*known, path)) {
+            hash = known->hash;
+        } else {
+            hash = AssetStore::hashFile(path, token);
+            if (!hash.isEmpty()) {
+                result.libraryHashes.append(qMakePair(path, hash));
+            }
+        }
+        libraryHashes.insert(path, hash);
+        return hash;
+    };
+
+    // Un nume este in conflict daca exista deja in primitives cu alt continut sau apare de mai
+    // multe ori in lot
+    const QString destinationDir = QDir(primitivesPath).absolutePath() + "/";
+    result.items.reserve(files.size());
+    QSet<QString> names;
+    for (int i = 0; i < files.size() && !token->loadAcquire(); ++i) {
+        const QFileInfo info(files[i]);
+        Item item;
+        item.source = files[i];
+        item.fileName = info.fileName();
+        item.size = info.size();
+        item.hash = AssetStore::hashFile(item.source, token);
+
+        const QString destination = destinationDir + item.fileName;
+        if (!item.hash.isEmpty()) {
+            for (const QString &path : librarySizes.value(item.size)) {
+                if (libraryHash(path) != item.hash) {
+                    continue;
+                }
+                if (path.compare(destination, Qt::CaseInsensitive) == 0) {
+                    item.identical = true;
+                    break;
+                }
+                if (item.libraryCopy.isEmpty()) {
+                    item.libraryCopy = path;
+                }
+            }
+        }
+
+        const QString key = item.fileName.toLower();
+        item.conflict = !item.identical && (names.contains(key) || QFileInfo::exists(destination));
+        names.insert(key);
+        result.items.append(item);
+        reportProgress(i + 1, files.size());
+    }
+    return result;
+}
+
+void AssetImporter::onScanned(const ScanResult &result)
+{
+    m_items = result.items;
+    for (const auto &hashed : result.libraryHashes) {
+        AssetStore::instance()->record(hashed.first, hashed.second);
+    }
+
+    if (m_token->loadAcquire()) {
+        m_summary.cancelled = true;
+        finish();
+    } else if (m_items.isEmpty()) {
+        finish();
+    }
+}
+
+void AssetImporter::resolveConflicts(ConflictPolicy policy)
+{
+    if (m_state != State::AwaitingPolicy) {
+        return;
+    }
+    if (policy == ConflictPolicy::Ask) {
+        m_summary.cancelled = true;
+        finish();
+        return;
+    }
+    schedule(policy);
+}
+
+void AssetImporter::cancel()
+{
+    if (m_state == State::Idle) {
+        return;
+    }
+    m_token->storeRelease(1);
+    m_summary.cancelled = true;
+    if (m_state == State::AwaitingPolicy) {
+        finish();
+    }
+}
+
+void AssetImporter::schedule(ConflictPolicy policy)
+{
+    m_state = State::Importing;
+    m_scheduled = 0;
+    m_done = 0;
+    m_bytesTotal = 0;
+    m_bytesDone = 0;
+    m_waiting.clear();
+
+    struct BatchCopy {
+        QString fileName; // lowercase
+        QString destination;
+    };
+
+    // Destinatiile sunt alese aici, secvential, ca doua joburi sa nu scrie acelasi fisier
+    QSet<QString> claimed;
+    QHash<QByteArray, BatchCopy> batchCopies; // primul fisier din lot cu un anumit continut
+    QVector<Job> jobs;
+    for (const Item &item : m_items) {
+        // Acelasi nume si acelasi continut: nu este nimic nou de importat
+        if (item.identical) {
+            ++m_summary.deduplicated;
+            m_summary.bytesSaved += item.size;
+            continue;
+        }
+        const auto batchCopy = item.hash.isEmpty() ? batchCopies.constEnd() : batchCopies.constFind(item.hash);
+        if (batchCopy != batchCopies.constEnd() && batchCopy->fileName == item.fileName.toLower()) {
+            ++m_summary.deduplicated;
+            m_summary.bytesSaved += item.size;
+            continue;
+        }
+
+        QString destination = m_primitivesPath + item.fileName;
+        // Un nume deja ales in lot (inclusiv unul redenumit) nu poate fi suprascris
+        const bool inBatch = claimed.contains(destination.toLower());
+        if (inBatch || (item.conflict && policy != ConflictPolicy::Overwrite)) {
+            if (policy == ConflictPolicy::Skip) {
+                ++m_summary.skipped;
+                continue;
+            }
+
+            const QFileInfo info(item.fileName);
+            int counter = 1;
+            do {
+                destination = m_primitivesPath + QString("%1_%2.%3").arg(info.completeBaseName()).arg(counter++).arg(info.suffix());
+            } while (claimed.contains(destination.toLower()) || QFileInfo::exists(destination));
+        }
+        claimed.insert(destination.toLower());
+        m_bytesTotal += item.size;
+
+        Job job{ item, destination, item.libraryCopy };
+        if (job.linkTarget.isEmpty() && batchCopy != batchCopies.constEnd()) {
+            // Continutul va exista in primitives abia dupa jobul primului fisier
+            m_waiting[batchCopy->destination].append(job);
+        } else {
+            jobs.append(job);
+        }
+        if (batchCopy == batchCopies.constEnd() && !item.hash.isEmpty()) {
+            batchCopies.insert(item.hash, BatchCopy{ item.fileName.toLower(), destination });
+        }
+    }
+
+    m_scheduled = jobs.size();
+    for (const QVector<Job> &waiting : std::as_const(m_waiting)) {
+        m_scheduled += waiting.size();
+    }
+    if (m_scheduled == 0) {
+        finish();
+        return;
+    }
+
+    QDir().mkpath(m_primitivesPath);
+    QDir().mkpath(thumbnailsPath(m_primitivesPath));
+    emit progress(0, m_scheduled, 0, m_bytesTotal);
+
+    for (const Job &job : jobs) {
+        startJob(job);
+    }
+}
+
+void AssetImporter::startJob(const Job &job)
+{
+    const CancelToken token = m_token;
+    const QString primitivesPath = m_primitivesPath;
+    const bool allowHardlinks = m_hardlinksAllowed;
+    m_pool.start(QRunnable::create([this, job, primitivesPath, allowHardlinks, token]() {
+        const JobResult result = importFile(job, primitivesPath, allowHardlinks, token);
+        QMetaObject::invokeMethod(this, [this, result, job]() {
+            onJobFinished(result, job);
+        }, Qt::QueuedConnection);
+    }));
+}
+
+AssetImporter::JobResult AssetImporter::importFile(const Job &job, const QString &primitivesPath,
+                                                   bool allowHardlinks, const CancelToken &token)
+{
+    const Item &item = job.item;
+    const QString &destination = job.destination;
+
+    JobResult result;
+    result.destination = destination;
+    if (token->loadAcquire()) {
+        result.cancelled = true;
+        return result;
+    }
+
+    // Fisierul ajunge mai intai intr-un director de lucru de pe acelasi volum: primitives (si
+    // catalogul) nu vad niciodata o copie partiala, iar mutarea finala este atomica
+    const QString stagingPath = stagingPathOf(primitivesPath);
+    QDir().mkpath(stagingPath);
+    const QString staged = stagingPath + QUuid::createUuid().toString(QUuid::WithoutBraces) + "."
+                           + QFileInfo(item.fileName).suffix();
+
+    // Un continut deja prezent in primitives nu mai este validat din nou. Datele sunt partajate
+    // cu fisierul existent doar printr-o clona copy-on-write sau, daca utilizatorul le-a permis,
+    // printr-un hardlink (o editare pe loc ar schimba ambele modele); altfel sunt copiate.
+    if (!job.linkTarget.isEmpty()) {
+        if (cloneFile(job.linkTarget, staged)) {
+            result.shared = true;
+            copyModificationTime(job.linkTarget, staged);
+        } else if (allowHardlinks && hardlinkFile(job.linkTarget, staged)) {
+            result.shared = true;
+        } else if (copyFile(job.linkTarget, staged, token, result.cancelled, result.error)) {
+            copyModificationTime(job.linkTarget, staged);
+        } else {
+            QFile::remove(staged);
+            return result;
+        }
+        result.linkedTo = job.linkTarget;
+    } else if (cloneFile(item.source, staged) || (allowHardlinks && hardlinkFile(item.source, staged))) {
+        result.cloned = true;
+    } else if (!copyFile(item.source, staged, token, result.cancelled, result.error)) {
+        QFile::remove(staged);
+        return result;
+    }
+
+    // Validare inainte de a atinge primitives (la suprascriere originalul ramane intact)
+    MeshData mesh;
+    if (result.linkedTo.isEmpty()) {
+        if (QFileInfo(staged).size() == 0) {
+            result.error = "empty file";
+        } else if (ObjLoader::canLoad(staged) && !ObjLoader::load(staged, mesh)) {
+            result.error = "no triangles could be read";
+        }
+    }
+    if (!result.error.isEmpty()) {
+        QFile::remove(staged);
+        return result;
+    }
+
+    if (!replaceFile(staged, destination)) {
+        QFile::remove(staged);
+        result.error = "could not move into primitives";
+        return result;
+    }
+    result.ok = true;
+    result.bytes = item.size;
+
+    // Indexare: volumele si miniatura sunt gata inainte de prima scena; nivelurile de detaliu
+    // si blob-urile gatite sunt scrise pe coada comuna a fisierelor derivate
+    const QString thumbnail = thumbnailPath(primitivesPath, destination);
+    if (!result.linkedTo.isEmpty()) {
+        const QString target = result.linkedTo;
+        QFile::remove(thumbnail);
+        QFile::copy(thumbnailPath(primitivesPath, target), thumbnail);
+        ModelLod::queue()->start(QRunnable::create([target, destination, allowHardlinks]() {
+            aliasDerivedFiles(target, destination, allowHardlinks);
+        }));
+    } else if (!mesh.isEmpty()) {
+        result.bounds = ModelBounds::fromPositions(mesh.positions);
+        renderThumbnail(mesh, result.bounds).save(thumbnail);
+        ModelLod::queue()->start(QRunnable::create([destination, mesh]() {
+            ModelLod::generate(destination, mesh);
+            MeshCooker::cook(destination, mesh);
+        }));
+    } else {
+        // Alte formate nu au niveluri sau blob-uri gatite; doar o eventuala miniatura veche
+        QFile::remove(thumbnail);
+    }
+    return result;
+}
+
+void AssetImporter::onJobFinished(const JobResult &result, const Job &job)
+{
+    ++m_done;
+    if (result.ok) {
+        ++m_summary.imported;
+        m_summary.bytes += result.bytes;
+        if (result.cloned) {
+            ++m_summary.cloned;
+        }
+        if (!job.item.hash.isEmpty()) {
+            AssetStore::instance()->record(result.destination, job.item.hash);
+        }
+        if (!result.linkedTo.isEmpty()) {
+            if (result.shared) {
+                ++m_summary.linked;
+                m_summary.bytesSaved += result.bytes;
+            } else {
+                ++m_summary.deduplicated;
+            }
+            ModelBoundsIndex::instance()->store(result.destination,
+                                                ModelBoundsIndex::instance()->bounds(result.linkedTo));
+        } else {
+            ModelBoundsIndex::instance()->store(result.destination, result.bounds);
+        }
+    } else if (!result.cancelled) {
+        ++m_summary.failed;
+        m_summary.failedFiles.append(job.item.fileName + ": " + result.error);
+        qDebug() << "Import failed:" << job.item.fileName << "-" << result.error;
+    }
+    m_bytesDone += job.item.size;
+
+    // Fisierele din lot cu acelasi continut il folosesc ca sursa; daca importul lui a
+    // esuat, sunt importate normal
+    const QVector<Job> waiting = m_waiting.take(job.destination);
+    for (Job dependent : waiting) {
+        if (result.ok) {
+            dependent.linkTarget = result.destination;
+        }
+        startJob(dependent);
+    }
+
+    emit progress(m_done, m_scheduled, m_bytesDone, m_bytesTotal);
+    if (m_done == m_scheduled) {
+        finish();
+    }
+}
+
+void AssetImporter::finish()
+{
+    m_summary.elapsedMs = m_timer.elapsed();
+    const Summary summary = m_summary;
+
+    m_state = State::Idle;
+    m_items.clear();
+    m_token = CancelToken::create(0);
+
+    // Catalogul este reindexat o singura data, la finalul lotului, si inca o data dupa ce
+    // coada a scris nivelurile de detaliu ale lotului (scenele deschise le afla prin catalogChanged)
+    if (summary.imported > 0) {
+        ModelCatalog *catalog = ModelCatalog::instance();
+        catalog->rescan();
+        ModelLod::queue()->start(QRunnable::create([catalog]() {
+            QMetaObject::invokeMethod(catalog, [catalog]() { catalog->rescan(); }, Qt::QueuedConnection);
+        }));
+    }
+
+    qDebug() << "Import finished:" << summary.imported << "imported," << summary.skipped << "skipped,"
+             << summary.failed << "failed," << summary.cloned << "without copying data,"
+             << summary.deduplicated << "deduplicated," << summary.linked << "linked ("
+             << summary.bytesSaved / (1024 * 1024) << "MB saved),"
+             << summary.bytes / (1024 * 1024) << "MB in" << summary.elapsedMs << "ms"
+             << (summary.cancelled ? "(cancelled)" : "");
+    emit finished(summary);
+}
+
+ModelThumbnailProvider::ModelThumbnailProvider(const QString &primitivesPath)
+    : m_primitivesPath(primitivesPath)
+{
+}
+
+QIcon ModelThumbnailProvider::icon(const QFileInfo &info) const
+{
+    if (info.isFile()) {
+        const QString thumbnail = AssetImporter::thumbnailPath(m_primitivesPath, info.absoluteFilePath());
+        if (QFileInfo::exists(thumbnail)) {
+            return QIcon(thumbnail);
+        }
+    }
+    return QFileIconProvider::icon(info);
+}
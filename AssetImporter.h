@@ -0,0 +1,168 @@
+#ifndef ASSETIMPORTER_H
+#define ASSETIMPORTER_H
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QFileIconProvider>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVector>
+#include <functional>
+
+#include "AssetStore.h"
+#include "ModelBounds.h"
+
+// Import de modele in Models/primitives, in afara thread-ului GUI.
+// Sursele (fisiere si directoare, parcurse recursiv) sunt scanate in fundal, iar continutul lor
+// este comparat cu cel din primitives prin hash (vezi AssetStore):
+//   - un fisier identic cu cel care are deja acelasi nume nu mai este importat
+//   - un continut existent sub alt nume (sau repetat in lot) este luat din fisierul existent,
+//     cu nivelurile de detaliu si miniatura acestuia: clona copy-on-write, hardlink daca este
+//     activat, altfel copie
+// Fiecare fisier ramas devine apoi un job in pool-ul propriu care:
+//   1. aduce fisierul intr-un director de lucru (Models/.importing): clona copy-on-write unde
+//      sistemul de fisiere o permite, hardlink daca este activat, altfel copie pe blocuri
+//   2. il valideaza (OBJ-urile trebuie sa aiba triunghiuri, celelalte sa nu fie goale)
+//   3. il muta in primitives si calculeaza volumele de incadrare si o miniatura; nivelurile de
+//      detaliu (ModelLod) si blob-ul gatit (MeshCooker) sunt scrise apoi pe ModelLod::queue
+// Conflictele de nume nu deschid un dialog pe fisier: importul se opreste o singura data
+// (conflictsFound) si continua cu politica primita prin resolveConflicts.
+class AssetImporter : public QObject
+{
+    Q_OBJECT
+public:
+    enum class ConflictPolicy {
+        Ask,       // emite conflictsFound si asteapta resolveConflicts
+        Overwrite,
+        Rename,    // <nume>_1.<ext>, <nume>_2.<ext>, ...
+        Skip
+    };
+
+    struct Summary {
+        int imported = 0;
+        int skipped = 0;
+        int failed = 0;
+        int cloned = 0;  // clone copy-on-write sau hardlink-uri, fara copierea datelor
+        int deduplicated = 0; // continut deja existent: identice neimportate sau copiate din biblioteca
+        int linked = 0;       // nume noi pentru un continut existent, cu datele partajate (clona/hardlink)
+        qint64 bytesSaved = 0;
+        qint64 bytes = 0;
+        qint64 elapsedMs = 0;
+        bool cancelled = false;
+        QStringList failedFiles; // "nume: motiv"
+    };
+
+    explicit AssetImporter(const QString &primitivesPath, QObject *parent = nullptr);
+    ~AssetImporter();
+
+    // false daca un import este deja in curs
+    bool start(const QStringList &sources, ConflictPolicy policy = ConflictPolicy::Ask);
+    // Raspunsul la conflictsFound; Ask abandoneaza importul
+    void resolveConflicts(ConflictPolicy policy);
+    // Joburile care nu au inceput sunt sarite, cel in curs isi sterge copia partiala
+    void cancel();
+    bool isRunning() const { return m_state != State::Idle; }
+
+    // Hardlink-ul partajeaza datele cu sursa: o modificare ulterioara a sursei schimba si modelul
+    void setHardlinksAllowed(bool allowed) { m_hardlinksAllowed = allowed; }
+    bool hardlinksAllowed() const { return m_hardlinksAllowed; }
+
+    static const QStringList &nameFilters();
+    static QString thumbnailsPath(const QString &primitivesPath);
+    static QString thumbnailPath(const QString &primitivesPath, const QString &modelPath);
+
+signals:
+    void conflictsFound(const QStringList &fileNames, int total);
+    void scanProgress(int hashed, int total);
+    void progress(int done, int total, qint64 bytesDone, qint64 bytesTotal);
+    void finished(const AssetImporter::Summary &summary);
+
+private:
+    enum class State {
+        Idle,
+        Scanning,
+        AwaitingPolicy,
+        Importing
+    };
+
+    struct Item {
+        QString source;
+        QString fileName;
+        qint64 size = 0;
+        QByteArray hash;
+        QString libraryCopy;    // un fisier din primitives cu acelasi continut, sub alt nume
+        bool identical = false; // primitives/<fileName> are deja acest continut
+        bool conflict = false;  // exista deja in primitives (cu alt continut) sau apare de doua ori in lot
+    };
+
+    struct ScanResult {
+        QVector<Item> items;
+        QVector<QPair<QString, QByteArray>> libraryHashes; // hash-uri noi pentru AssetStore
+    };
+
+    struct Job {
+        Item item;
+        QString destination;
+        QString linkTarget; // fisierul din primitives cu acelasi continut
+    };
+
+    struct JobResult {
+        QString destination;
+        QString linkedTo;
+        bool shared = false; // datele lui linkedTo sunt partajate, nu copiate
+        qint64 bytes = 0;
+        bool ok = false;
+        bool cancelled = false;
+        bool cloned = false;
+        QString error;
+        ModelBounds bounds;
+    };
+
+    using CancelToken = AssetStore::CancelToken;
+
+    void onScanned(const ScanResult &result);
+    void schedule(ConflictPolicy policy);
+    void startJob(const Job &job);
+    void onJobFinished(const JobResult &result, const Job &job);
+    void finish();
+
+    static ScanResult scan(const QStringList &sources, const QString &primitivesPath,
+                           const QHash<QString, AssetStore::Entry> &library, const CancelToken &token,
+                           const std::function<void(int, int)> &reportProgress);
+    static JobResult importFile(const Job &job, const QString &primitivesPath, bool allowHardlinks,
+                                const CancelToken &token);
+
+    QString m_primitivesPath;
+    QThreadPool m_pool;
+    CancelToken m_token;
+    State m_state;
+    bool m_hardlinksAllowed;
+
+    QVector<Item> m_items;
+    // Joburile care preiau continutul unui fisier din acelasi lot asteapta terminarea acestuia
+    QHash<QString, QVector<Job>> m_waiting;
+    int m_scheduled;
+    int m_done;
+    qint64 m_bytesTotal;
+    qint64 m_bytesDone;
+    Summary m_summary;
+    QElapsedTimer m_timer;
+};
+
+// Iconita din arborele de modele: miniatura generata la import, daca exista
+class ModelThumbnailProvider : public QFileIconProvider
+{
+public:
+    explicit ModelThumbnailProvider(const QString &primitivesPath);
+
+    QIcon icon(const QFileInfo &info) const override;
+    using QFileIconProvider::icon;
+
+private:
+    QString m_primitivesPath;
+};
+
+#endif // ASSETIMPORTER_H
@@ -0,0 +1,267 @@
+#include "AssetStore.h"
+#include "ModelCatalog.h"
+#include "ModelLod.h"
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPointer>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QThreadPool>
+#include <QVector>
+
+namespace {
+
+constexpr int INDEX_VERSION = 1;
+constexpr int SAVE_DELAY_MS = 1000;
+constexpr qint64 HASH_BLOCK_SIZE = 1024 * 1024;
+const char KEY_PREFIX[] = "blake2b:";
+
+} // namespace
+
+AssetStore *AssetStore::instance()
+{
+    static AssetStore *store = new AssetStore(QCoreApplication::instance());
+    return store;
+}
+
+AssetStore::AssetStore(QObject *parent)
+    : QObject(parent), m_dirty(false)
+{
+    m_primitivesPath = QDir(ModelCatalog::instance()->primitivesPath()).absolutePath() + "/";
+    m_indexPath = QDir::cleanPath(m_primitivesPath + "../asset_index.json");
+
+    m_saveTimer = new QTimer(this);
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(SAVE_DELAY_MS);
+    connect(m_saveTimer, &QTimer::timeout, this, &AssetStore::save);
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &AssetStore::save);
+
+    load();
+}
+
+QString AssetStore::keyFor(const QString &modelPath) const
+{
+    const QString absolutePath = QFileInfo(modelPath).absoluteFilePath();
+    if (absolutePath.startsWith(m_primitivesPath)) {
+        return absolutePath.mid(m_primitivesPath.size());
+    }
+    return absolutePath;
+}
+
+bool AssetStore::matches(const Entry &entry, const QString &filePath)
+{
+    const QFileInfo info(filePath);
+    return info.exists() && info.size() == entry.fileSize
+           && info.lastModified().toMSecsSinceEpoch() == entry.lastModified;
+}
+
+QByteArray AssetStore::hashOf(const QString &modelPath) const
+{
+    auto it = m_entries.constFind(keyFor(modelPath));
+    if (it == m_entries.constEnd() || !matches(*it, modelPath)) {
+        return QByteArray();
+    }
+    return it->hash;
+}
+
+QString AssetStore::contentKey(const QString &modelPath) const
+{
+    const QByteArray hash = hashOf(modelPath);
+    return hash.isEmpty() ? modelPath : QString::fromLatin1(KEY_PREFIX) + QString::fromLatin1(hash);
+}
+
+QStringList AssetStore::pathsOf(const QByteArray &hash) const
+{
+    QStringList paths;
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        if (it->hash == hash) {
+            const QString path = m_primitivesPath + it.key();
+            if (matches(*it, path)) {
+                paths.append(path);
+            }
+        }
+    }
+    return paths;
+}
+
+void AssetStore::record(const QString &modelPath, const QByteArray &hash)
+{
+    const QFileInfo info(modelPath);
+    Entry entry;
+    entry.hash = hash;
+    entry.fileSize = info.size();
+    entry.lastModified = info.lastModified().toMSecsSinceEpoch();
+
+    const QString key = keyFor(modelPath);
+    const bool changed = m_entries.value(key).hash != hash;
+    m_entries.insert(key, entry);
+    scheduleSave();
+    if (changed) {
+        emit entryChanged(QDir::cleanPath(info.absoluteFilePath()));
+    }
+}
+
+void AssetStore::forget(const QString &modelPath)
+{
+    if (m_entries.remove(keyFor(modelPath)) > 0) {
+        scheduleSave();
+        emit entryChanged(QDir::cleanPath(QFileInfo(modelPath).absoluteFilePath()));
+    }
+}
+
+QHash<QString, AssetStore::Entry> AssetStore::snapshot() const
+{
+    QHash<QString, Entry> entries;
+    entries.reserve(m_entries.size());
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        entries.insert(m_primitivesPath + it.key(), *it);
+    }
+    return entries;
+}
+
+QByteArray AssetStore::hashFile(const QString &filePath, const CancelToken &token)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Blake2b_256);
+    QByteArray buffer(int(qMin(HASH_BLOCK_SIZE, qMax<qint64>(file.size(), 1))), Qt::Uninitialized);
+    while (!file.atEnd()) {
+        if (token && token->loadAcquire()) {
+            return QByteArray();
+        }
+        const qint64 read = file.read(buffer.data(), buffer.size());
+        if (read < 0) {
+            return QByteArray();
+        }
+        hash.addData(QByteArrayView(buffer.constData(), read));
+    }
+    return hash.result().toHex();
+}
+
+void AssetStore::indexLibrary()
+{
+    const QHash<QString, Entry> known = snapshot();
+    const QString primitivesPath = m_primitivesPath;
+    QPointer<AssetStore> store(this);
+
+    QThreadPool::globalInstance()->start(QRunnable::create([known, primitivesPath, store]() {
+        QElapsedTimer timer;
+        timer.start();
+
+        QStringList filters;
+        for (const QString &extension : ModelCatalog::supportedExtensions()) {
+            filters.append("*." + extension);
+        }
+
+        QVector<QPair<QString, QByteArray>> hashed;
+        QDirIterator iterator(primitivesPath, filters, QDir::Files, QDirIterator::Subdirectories);
+        while (iterator.hasNext()) {
+            const QString path = iterator.next();
+            if (ModelLod::isLodFile(path)) {
+                continue;
+            }
+            auto it = known.constFind(path);
+            if (it != known.constEnd() && matches(*it, path)) {
+                continue;
+            }
+            const QByteArray hash = hashFile(path);
+            if (!hash.isEmpty()) {
+                hashed.append(qMakePair(path, hash));
+            }
+        }
+
+        if (!hashed.isEmpty()) {
+            QMetaObject::invokeMethod(QCoreApplication::instance(), [store, hashed]() {
+                if (!store) {
+                    return;
+                }
+                for (const auto &item : hashed) {
+                    store->record(item.first, item.second);
+                }
+            }, Qt::QueuedConnection);
+        }
+        qDebug() << "Asset store indexed" << hashed.size() << "new or changed models in" << timer.elapsed() << "ms";
+    }));
+}
+
+void AssetStore::scheduleSave()
+{
+    m_dirty = true;
+    m_saveTimer->start();
+}
+
+void AssetStore::load()
+{
+    QFile file(m_indexPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("version").toInt() != INDEX_VERSION) {
+        qDebug() << "Ignoring asset index with unknown version:" << m_indexPath;
+        return;
+    }
+
+    const QJsonObject assets = root.value("assets").toObject();
+    for (auto it = assets.constBegin(); it != assets.constEnd(); ++it) {
+        const QJsonObject asset = it.value().toObject();
+
+        Entry entry;
+        entry.hash = asset.value("hash").toString().toLatin1();
+        entry.fileSize = qint64(asset.value("fileSize").toDouble());
+        entry.lastModified = qint64(asset.value("lastModified").toDouble());
+
+        // Fisierele sterse intre timp nu mai sunt incarcate
+        if (!entry.hash.isEmpty() && QFileInfo::exists(m_primitivesPath + it.key())) {
+            m_entries.insert(it.key(), entry);
+        } else {
+            m_dirty = true;
+        }
+    }
+
+    qDebug() << "Asset index loaded" << m_entries.size() << "entries from" << m_indexPath;
+}
+
+void AssetStore::save()
+{
+    m_saveTimer->stop();
+    if (!m_dirty) {
+        return;
+    }
+
+    QJsonObject assets;
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        QJsonObject asset;
+        asset["hash"] = QString::fromLatin1(it->hash);
+        asset["fileSize"] = double(it->fileSize);
+        asset["lastModified"] = double(it->lastModified);
+        assets[it.key()] = asset;
+    }
+
+    QJsonObject root;
+    root["version"] = INDEX_VERSION;
+    root["assets"] = assets;
+
+    QSaveFile file(m_indexPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Could not write asset index:" << m_indexPath;
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (file.commit()) {
+        m_dirty = false;
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef ASSETSTORE_H
+#define ASSETSTORE_H
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+// Index de continut pentru Models/primitives: fiecare fisier de model are hash-ul BLAKE2b-256
+// al octetilor sai, retinut in Models/asset_index.json impreuna cu dimensiunea si mtime-ul.
+// Numele logice (caile din primitives) trimit astfel la continut:
+//   - AssetImporter nu mai copiaza un fisier identic cu unul existent; un nume nou pentru un
+//     continut existent devine un hardlink, deci octetii sunt stocati o singura data
+//   - GeometryCache foloseste contentKey(), deci doua nume cu acelasi continut partajeaza mesh-ul
+// O intrare este folosita doar cat timp fisierul are aceeasi dimensiune si acelasi mtime;
+// un fisier modificat pe loc pierde hash-ul pana la urmatoarea indexare.
+class AssetStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    using CancelToken = QSharedPointer<QAtomicInt>;
+
+    struct Entry {
+        QByteArray hash; // hex
+        qint64 fileSize = 0;
+        qint64 lastModified = 0; // ms since epoch
+    };
+
+    static AssetStore *instance();
+
+    // Hash-ul continutului, gol daca nu este cunoscut sau fisierul s-a schimbat
+    QByteArray hashOf(const QString &modelPath) const;
+    // "blake2b:<hash>" pentru fisierele indexate, altfel chiar calea
+    QString contentKey(const QString &modelPath) const;
+    // Fisierele din primitives cu acest continut (doar intrarile valide)
+    QStringList pathsOf(const QByteArray &hash) const;
+
+    void record(const QString &modelPath, const QByteArray &hash);
+    void forget(const QString &modelPath);
+    // Copie a intrarilor (cale absoluta -> intrare), pentru thread-urile de import
+    QHash<QString, Entry> snapshot() const;
+
+    // Calculeaza in fundal hash-urile fisierelor din primitives care lipsesc din index
+    void indexLibrary();
+
+    void save();
+
+    int entryCount() const { return m_entries.size(); }
+
+    // BLAKE2b-256 citit pe blocuri; gol la eroare sau la anulare
+    static QByteArray hashFile(const QString &filePath, const CancelToken &token = CancelToken());
+    static bool matches(const Entry &entry, const QString &filePath);
+
+signals:
+    // Hash-ul unui fisier a aparut, s-a schimbat sau a fost uitat; calea este absoluta
+    void entryChanged(const QString &modelPath);
+
+private:
+    explicit AssetStore(QObject *parent = nullptr);
+
+    void load();
+    QString keyFor(const QString &modelPath) const;
+    void scheduleSave();
+
+    QString m_indexPath;
+    QString m_primitivesPath;
+    QHash<QString, Entry> m_entries; // cale relativa la primitives -> intrare
+    QTimer *m_saveTimer;
+    bool m_dirty;
+};
+
+#endif // ASSETSTORE_H
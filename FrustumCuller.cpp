@@ -0,0 +1,327 @@
+#include "FrustumCuller.h"
+#include <QElapsedTimer>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+constexpr int LEAF_SIZE = 4;
+
+float axisOf(const QVector3D &vector, int axis)
+{
+    return axis == 0 ? vector.x() : (axis == 1 ? vector.y() : vector.z());
+}
+
+} // namespace
+
+FrustumCuller::FrustumCuller()
+    : m_maxDistance(0.0f), m_topologyDirty(true), m_boundsDirty(true), m_reportAll(true)
+{
+}
+
+void FrustumCuller::markMoved(int handle)
+{
+    // Dupa un build sau o invalidare toate volumele sunt oricum recalculate
+    if (m_topologyDirty || m_boundsDirty) {
+        return;
+    }
+    if (handle < 0 || handle >= m_leafOf.size()) {
+        m_boundsDirty = true;
+        return;
+    }
+    const int leaf = m_leafOf[handle];
+    if (!m_nodeMoved[leaf]) {
+        m_nodeMoved[leaf] = 1;
+        m_movedNodes.append(leaf);
+    }
+}
+
+void FrustumCuller::build(const QVector<QVector3D> &centers)
+{
+    m_order.resize(centers.size());
+    for (int i = 0; i < m_order.size(); ++i) {
+        m_order[i] = i;
+    }
+
+    m_nodes.resize(0);
+    m_nodes.reserve(qMax(1, 2 * int(centers.size()) / LEAF_SIZE + 1));
+    if (!centers.isEmpty()) {
+        buildNode(centers, 0, int(centers.size()));
+    }
+
+    m_parent.fill(-1, m_nodes.size());
+    m_leafOf.resize(centers.size());
+    for (int n = 0; n < m_nodes.size(); ++n) {
+        const Node &node = m_nodes[n];
+        if (node.left >= 0) {
+            m_parent[node.left] = n;
+            m_parent[node.right] = n;
+            continue;
+        }
+        for (int i = node.first; i < node.first + node.count; ++i) {
+            m_leafOf[m_order[i]] = n;
+        }
+    }
+    m_nodeMoved.fill(0, m_nodes.size());
+    m_movedNodes.resize(0);
+
+    m_topologyDirty = false;
+    m_boundsDirty = true;
+    m_reportAll = true;
+}
+
+int FrustumCuller::buildNode(const QVector<QVector3D> &centers, int first, int count)
+{
+    const int index = m_nodes.size();
+    m_nodes.append(Node{ QVector3D(), QVector3D(), -1, -1, first, count });
+    if (count <= LEAF_SIZE) {
+        return index;
+    }
+
+    // Impartire la mediana, pe axa cu cea mai mare intindere a centrelor
+    QVector3D low = centers[m_order[first]];
+    QVector3D high = low;
+    for (int i = first + 1; i < first + count; ++i) {
+        const QVector3D &c = centers[m_order[i]];
+        low = QVector3D(qMin(low.x(), c.x()), qMin(low.y(), c.y()), qMin(low.z(), c.z()));
+        high = QVector3D(qMax(high.x(), c.x()), qMax(high.y(), c.y()), qMax(high.z(), c.z()));
+    }
+    const QVector3D extent = high - low;
+    const int axis = extent.x() >= extent.y() && extent.x() >= extent.z() ? 0 : (extent.y() >= extent.z() ? 1 : 2);
+
+    const int half = count / 2;
+    std::nth_element(m_order.begin() + first, m_order.begin() + first + half, m_order.begin() + first + count,
+                     [&centers, axis](int a, int b) { return axisOf(centers[a], axis) < axisOf(centers[b], axis); });
+
+    // Copiii sunt adaugati dupa parinte, deci refit-ul poate parcurge nodurile invers
+    const int left = buildNode(centers, first, half);
+    const int right = buildNode(centers, first + half, count - half);
+    m_nodes[index].left = left;
+    m_nodes[index].right = right;
+    return index;
+}
+
+void FrustumCuller::fitLeaf(Node &node, const QVector<QVector3D> &centers, const QVector<float> &radii) const
+{
+    const float inf = std::numeric_limits<float>::max();
+    node.minimum = QVector3D(inf, inf, inf);
+    node.maximum = QVector3D(-inf, -inf, -inf);
+    for (int i = node.first; i < node.first + node.count; ++i) {
+        const QVector3D &c = centers[m_order[i]];
+        const float r = radii[m_order[i]];
+        node.minimum = QVector3D(qMin(node.minimum.x(), c.x() - r), qMin(node.minimum.y(), c.y() - r),
+                                 qMin(node.minimum.z(), c.z() - r));
+        node.maximum = QVector3D(qMax(node.maximum.x(), c.x() + r), qMax(node.maximum.y(), c.y() + r),
+                                 qMax(node.maximum.z(), c.z() + r));
+    }
+}
+
+void FrustumCuller::fitInner(Node &node) const
+{
+    const Node &a = m_nodes[node.left];
+    const Node &b = m_nodes[node.right];
+    node.minimum = QVector3D(qMin(a.minimum.x(), b.minimum.x()), qMin(a.minimum.y(), b.minimum.y()),
+                             qMin(a.minimum.z(), b.minimum.z()));
+    node.maximum = QVector3D(qMax(a.maximum.x(), b.maximum.x()), qMax(a.maximum.y(), b.maximum.y()),
+                             qMax(a.maximum.z(), b.maximum.z()));
+}
+
+void FrustumCuller::refit(const QVector<QVector3D> &centers, const QVector<float> &radii)
+{
+    for (int n = m_nodes.size() - 1; n >= 0; --n) {
+        Node &node = m_nodes[n];
+        if (node.left >= 0) {
+            fitInner(node);
+        } else {
+            fitLeaf(node, centers, radii);
+        }
+    }
+}
+
+void FrustumCuller::refitMoved(const QVector<QVector3D> &centers, const QVector<float> &radii)
+{
+    // Parintii au indici mai mici decat copiii, deci nodurile sunt procesate descrescator:
+    // un nod este recalculat o singura data, dupa toti copiii lui marcati
+    std::make_heap(m_movedNodes.begin(), m_movedNodes.end());
+    while (!m_movedNodes.isEmpty()) {
+        std::pop_heap(m_movedNodes.begin(), m_movedNodes.end());
+        const int n = m_movedNodes.takeLast();
+        m_nodeMoved[n] = 0;
+
+        Node &node = m_nodes[n];
+        if (node.left >= 0) {
+            fitInner(node);
+        } else {
+            fitLeaf(node, centers, radii);
+        }
+
+        const int parent = m_parent[n];
+        if (parent >= 0 && !m_nodeMoved[parent]) {
+            m_nodeMoved[parent] = 1;
+            m_movedNodes.append(parent);
+            std::push_heap(m_movedNodes.begin(), m_movedNodes.end());
+        }
+    }
+}
+
+void FrustumCuller::extractPlanes(const QMatrix4x4 &viewProjection)
+{
+    // Gribb/Hartmann: planele din randurile matricei, normalele orientate spre interior
+    const QVector4D row0 = viewProjection.row(0);
+    const QVector4D row1 = viewProjection.row(1);
+    const QVector4D row2 = viewProjection.row(2);
+    const QVector4D row3 = viewProjection.row(3);
+
+    m_planes[0] = row3 + row0; // stanga
+    m_planes[1] = row3 - row0; // dreapta
+    m_planes[2] = row3 + row1; // jos
+    m_planes[3] = row3 - row1; // sus
+    m_planes[4] = row3 + row2; // aproape
+    m_planes[5] = row3 - row2; // departe
+
+    for (QVector4D &plane : m_planes) {
+        const float length = plane.toVector3D().length();
+        if (length > 0.0f) {
+            plane /= length;
+        }
+    }
+}
+
+FrustumCuller::Containment FrustumCuller::testBox(const QVector3D &minimum, const QVector3D &maximum) const
+{
+    Containment result = Containment::Inside;
+
+    for (const QVector4D &plane : m_planes) {
+        // Coltul cel mai departe in directia normalei (p) si cel opus (n)
+        const QVector3D p(plane.x() >= 0.0f ? maximum.x() : minimum.x(),
+                          plane.y() >= 0.0f ? maximum.y() : minimum.y(),
+                          plane.z() >= 0.0f ? maximum.z() : minimum.z());
+        const QVector3D n(plane.x() >= 0.0f ? minimum.x() : maximum.x(),
+                          plane.y() >= 0.0f ? minimum.y() : maximum.y(),
+                          plane.z() >= 0.0f ? minimum.z() : maximum.z());
+
+        if (QVector3D::dotProduct(plane.toVector3D(), p) + plane.w() < 0.0f) {
+            return Containment::Outside;
+        }
+        if (QVector3D::dotProduct(plane.toVector3D(), n) + plane.w() < 0.0f) {
+            result = Containment::Intersecting;
+        }
+    }
+
+    if (m_maxDistance > 0.0f) {
+        // Cel mai apropiat si cel mai departat punct al cutiei fata de camera
+        const QVector3D nearest(qBound(minimum.x(), m_eye.x(), maximum.x()),
+                                qBound(minimum.y(), m_eye.y(), maximum.y()),
+                                qBound(minimum.z(), m_eye.z(), maximum.z()));
+        if ((nearest - m_eye).lengthSquared() > m_maxDistance * m_maxDistance) {
+            return Containment::Outside;
+        }
+        const QVector3D farthest(qMax(qAbs(minimum.x() - m_eye.x()), qAbs(maximum.x() - m_eye.x())),
+                                 qMax(qAbs(minimum.y() - m_eye.y()), qAbs(maximum.y() - m_eye.y())),
+                                 qMax(qAbs(minimum.z() - m_eye.z()), qAbs(maximum.z() - m_eye.z())));
+        if (farthest.lengthSquared() > m_maxDistance * m_maxDistance) {
+            result = Containment::Intersecting;
+        }
+    }
+
+    return result;
+}
+
+bool FrustumCuller::testSphere(const QVector3D &center, float radius) const
+{
+    for (const QVector4D &plane : m_planes) {
+        if (QVector3D::dotProduct(plane.toVector3D(), center) + plane.w() < -radius) {
+            return false;
+        }
+    }
+    return m_maxDistance <= 0.0f || (center - m_eye).length() - radius <= m_maxDistance;
+}
+
+void FrustumCuller::setVisible(int handle, bool value, QVector<bool> &visible)
+{
+    if (visible[handle] != value) {
+        visible[handle] = value;
+        if (!m_reportAll) {
+            m_changed.append(handle);
+        }
+    }
+}
+
+void FrustumCuller::markRange(const Node &node, bool value, QVector<bool> &visible)
+{
+    for (int i = node.first; i < node.first + node.count; ++i) {
+        setVisible(m_order[i], value, visible);
+    }
+    (value ? m_stats.visible : m_stats.culled) += node.count;
+}
+
+void FrustumCuller::update(const QMatrix4x4 &viewProjection, const QVector3D &eye,
+                           const QVector<QVector3D> &centers, const QVector<float> &radii, QVector<bool> &visible)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    m_stats = CullingStats();
+    m_changed.resize(0);
+    if (visible.size() != centers.size()) {
+        visible.resize(centers.size());
+        m_reportAll = true;
+    }
+    if (m_topologyDirty || m_order.size() != centers.size()) {
+        build(centers);
+    }
+    if (m_nodes.isEmpty()) {
+        return;
+    }
+
+    if (m_boundsDirty) {
+        refit(centers, radii);
+        for (int n : std::as_const(m_movedNodes)) {
+            m_nodeMoved[n] = 0;
+        }
+        m_movedNodes.resize(0);
+        m_boundsDirty = false;
+    } else {
+        refitMoved(centers, radii);
+    }
+    extractPlanes(viewProjection);
+    m_eye = eye;
+
+    // Parcurgere cu stiva explicita; nodurile decise complet nu mai sunt deschise
+    int stack[64];
+    int depth = 0;
+    stack[depth++] = 0;
+    while (depth > 0) {
+        const Node &node = m_nodes[stack[--depth]];
+        ++m_stats.nodesTested;
+
+        const Containment containment = testBox(node.minimum, node.maximum);
+        if (containment != Containment::Intersecting) {
+            markRange(node, containment == Containment::Inside, visible);
+            continue;
+        }
+
+        if (node.left >= 0 && depth + 2 <= int(sizeof(stack) / sizeof(stack[0]))) {
+            stack[depth++] = node.left;
+            stack[depth++] = node.right;
+            continue;
+        }
+
+        for (int i = node.first; i < node.first + node.count; ++i) {
+            const int handle = m_order[i];
+            setVisible(handle, testSphere(centers[handle], radii[handle]), visible);
+            ++(visible[handle] ? m_stats.visible : m_stats.culled);
+            ++m_stats.objectsTested;
+        }
+    }
+
+    if (m_reportAll) {
+        m_changed.resize(centers.size());
+        for (int h = 0; h < m_changed.size(); ++h) {
+            m_changed[h] = h;
+        }
+        m_reportAll = false;
+    }
+
+    m_stats.elapsedMicroseconds = timer.nsecsElapsed() / 1000;
+}
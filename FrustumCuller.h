@@ -0,0 +1,92 @@
+#ifndef FRUSTUMCULLER_H
+#define FRUSTUMCULLER_H
+
+#include <QMatrix4x4>
+#include <QVector>
+#include <QVector3D>
+#include <QVector4D>
+
+struct CullingStats {
+    int visible = 0;
+    int culled = 0;
+    int nodesTested = 0;   // noduri BVH testate la ultima actualizare
+    int objectsTested = 0; // sfere testate individual (restul au fost decise la nivel de nod)
+    qint64 elapsedMicroseconds = 0;
+};
+
+// Culling pentru obiectele scenei: frustum-ul camerei si, optional, o distanta maxima.
+// Obiectele sunt sfere (centru + raza) intr-un BVH. Topologia se construieste doar cand se
+// schimba setul de obiecte; la fiecare cadru sunt reajustate (refit) doar frunzele obiectelor
+// marcate cu markMoved si stramosii lor, apoi arborele este parcurs: un nod complet in afara
+// elimina tot subarborele, unul complet inauntru il accepta fara a mai testa obiectele.
+// changedHandles() spune ce obiecte si-au schimbat vizibilitatea, ca apelantul sa nu le mai
+// parcurga pe toate.
+class FrustumCuller
+{
+public:
+    FrustumCuller();
+
+    // 0 dezactiveaza culling-ul dupa distanta
+    void setMaxDistance(float distance) { m_maxDistance = distance; }
+    float maxDistance() const { return m_maxDistance; }
+
+    // Setul de obiecte s-a schimbat (adaugari, stergeri, handle-uri mutate)
+    void invalidate() { m_topologyDirty = true; }
+    // Toate volumele sunt recalculate la urmatorul update (ex. razele s-au schimbat)
+    void invalidateBounds() { m_boundsDirty = true; }
+    // Centrul obiectului s-a mutat de la ultimul update
+    void markMoved(int handle);
+
+    // centers/radii sunt indexate dupa handle; visible primeste rezultatul pentru fiecare handle
+    void update(const QMatrix4x4 &viewProjection, const QVector3D &eye,
+                const QVector<QVector3D> &centers, const QVector<float> &radii, QVector<bool> &visible);
+
+    const CullingStats &stats() const { return m_stats; }
+    // Handle-urile a caror valoare din visible s-a schimbat la ultimul update (toate dupa build)
+    const QVector<int> &changedHandles() const { return m_changed; }
+
+private:
+    enum class Containment {
+        Outside,
+        Intersecting,
+        Inside
+    };
+
+    struct Node {
+        QVector3D minimum;
+        QVector3D maximum;
+        int left;  // -1 pentru frunze
+        int right;
+        int first; // intervalul din m_order acoperit de nod
+        int count;
+    };
+
+    void build(const QVector<QVector3D> &centers);
+    int buildNode(const QVector<QVector3D> &centers, int first, int count);
+    void refit(const QVector<QVector3D> &centers, const QVector<float> &radii);
+    void refitMoved(const QVector<QVector3D> &centers, const QVector<float> &radii);
+    void fitLeaf(Node &node, const QVector<QVector3D> &centers, const QVector<float> &radii) const;
+    void fitInner(Node &node) const;
+    void setVisible(int handle, bool value, QVector<bool> &visible);
+    void extractPlanes(const QMatrix4x4 &viewProjection);
+    Containment testBox(const QVector3D &minimum, const QVector3D &maximum) const;
+    bool testSphere(const QVector3D &center, float radius) const;
+    void markRange(const Node &node, bool value, QVector<bool> &visible);
+
+    QVector<Node> m_nodes;
+    QVector<int> m_order; // handle-urile, grupate pe frunze
+    QVector<int> m_parent; // per nod; -1 pentru radacina
+    QVector<int> m_leafOf; // per handle: frunza care il contine
+    QVector<int> m_movedNodes;
+    QVector<quint8> m_nodeMoved;
+    QVector<int> m_changed;
+    QVector4D m_planes[6];
+    QVector3D m_eye;
+    float m_maxDistance;
+    bool m_topologyDirty;
+    bool m_boundsDirty;
+    bool m_reportAll; // dupa build toate handle-urile sunt raportate ca schimbate
+    CullingStats m_stats;
+};
+
+#endif // FRUSTUMCULLER_H
@@ -0,0 +1,200 @@
+#include "GeometryCache.h"
+#include "AssetStore.h"
+#include "MeshCooker.h"
+#include <Qt3DCore/QAttribute>
+#include <Qt3DCore/QBuffer>
+#include <Qt3DCore/QGeometry>
+#include <Qt3DRender/QMesh>
+#include <QDir>
+#include <QFileInfo>
+#include <QUrl>
+#include <QDebug>
+#include <cstddef>
+
+namespace {
+
+void addVertexAttribute(Qt3DCore::QGeometry *geometry, Qt3DCore::QBuffer *buffer, const QString &name,
+                        Qt3DCore::QAttribute::VertexBaseType type, uint size, uint offset, uint count)
+{
+    auto *attribute = new Qt3DCore::QAttribute(geometry);
+    attribute->setName(name);
+    attribute->setAttributeType(Qt3DCore::QAttribute::VertexAttribute);
+    attribute->setVertexBaseType(type);
+    attribute->setVertexSize(size);
+    attribute->setBuffer(buffer);
+    attribute->setByteOffset(offset);
+    attribute->setByteStride(MeshCooker::VERTEX_STRIDE);
+    attribute->setCount(count);
+    geometry->addAttribute(attribute);
+}
+
+// Geometrie construita direct din blob-ul gatit, cu aceleasi nume de atribute ca QMesh.
+// Qt3D trimite atributele intregi normalizate, deci normala si tangenta SNORM8 ajung in
+// shader ca vectori in [-1, 1].
+Qt3DRender::QGeometryRenderer *createCookedRenderer(const MeshCooker::CookedMesh &mesh, Qt3DCore::QNode *owner)
+{
+    auto *renderer = new Qt3DRender::QGeometryRenderer(owner);
+    auto *geometry = new Qt3DCore::QGeometry(renderer);
+
+    auto *vertexBuffer = new Qt3DCore::QBuffer(geometry);
+    vertexBuffer->setData(mesh.vertexData);
+    addVertexAttribute(geometry, vertexBuffer, Qt3DCore::QAttribute::defaultPositionAttributeName(),
+                       Qt3DCore::QAttribute::Float, 3, offsetof(MeshCooker::Vertex, position), mesh.vertexCount);
+    addVertexAttribute(geometry, vertexBuffer, Qt3DCore::QAttribute::defaultNormalAttributeName(),
+                       Qt3DCore::QAttribute::Byte, 3, offsetof(MeshCooker::Vertex, normal), mesh.vertexCount);
+    addVertexAttribute(geometry, vertexBuffer, Qt3DCore::QAttribute::defaultTangentAttributeName(),
+                       Qt3DCore::QAttribute::Byte, 4, offsetof(MeshCooker::Vertex, tangent), mesh.vertexCount);
+    addVertexAttribute(geometry, vertexBuffer, Qt3DCore::QAttribute::defaultTextureCoordinateAttributeName(),
+                       Qt3DCore::QAttribute::Float, 2, offsetof(MeshCooker::Vertex, texCoord), mesh.vertexCount);
+
+    auto *indexBuffer = new Qt3DCore::QBuffer(geometry);
+    indexBuffer->setData(mesh.indexData);
+    auto *indexAttribute = new Qt3DCore::QAttribute(geometry);
+    indexAttribute->setAttributeType(Qt3DCore::QAttribute::IndexAttribute);
+    indexAttribute->setVertexBaseType(mesh.wideIndices ? Qt3DCore::QAttribute::UnsignedInt
+                                                       : Qt3DCore::QAttribute::UnsignedShort);
+    indexAttribute->setBuffer(indexBuffer);
+    indexAttribute->setCount(mesh.indexCount);
+    geometry->addAttribute(indexAttribute);
+
+    renderer->setGeometry(geometry);
+    renderer->setPrimitiveType(Qt3DRender::QGeometryRenderer::Triangles);
+    return renderer;
+}
+
+} // namespace
+
+GeometryCache::GeometryCache(Qt3DCore::QNode *owner)
+    : m_owner(owner), m_bytesResident(0), m_hits(0), m_misses(0), m_cookedLoads(0)
+{
+}
+
+GeometryCache::~GeometryCache()
+{
+    // Nodurile sunt copii ai owner-ului si sunt distruse odata cu scena
+    m_entries.clear();
+}
+
+Qt3DRender::QGeometryRenderer *GeometryCache::acquire(const QString &modelPath)
+{
+    auto alias = m_aliases.find(modelPath);
+    if (alias == m_aliases.end()) {
+        alias = m_aliases.insert(modelPath, Alias{ AssetStore::instance()->contentKey(modelPath), 0 });
+    }
+    ++alias->refCount;
+    const QString key = alias->key;
+
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        ++it->refCount;
+        ++m_hits;
+        return it->renderer;
+    }
+
+    ++m_misses;
+
+    Entry entry;
+    entry.refCount = 1;
+
+    MeshCooker::CookedMesh cooked;
+    if (MeshCooker::load(modelPath, cooked)) {
+        entry.renderer = createCookedRenderer(cooked, m_owner);
+        entry.bytes = cooked.vertexData.size() + cooked.indexData.size();
+        ++m_cookedLoads;
+    } else {
+        Qt3DRender::QMesh *mesh = new Qt3DRender::QMesh(m_owner);
+        mesh->setSource(QUrl::fromLocalFile(modelPath));
+        entry.renderer = mesh;
+        // Estimare: datele de varf incarcate sunt proportionale cu dimensiunea fisierului sursa
+        entry.bytes = QFileInfo(modelPath).size();
+    }
+
+    m_entries.insert(key, entry);
+    m_bytesResident += entry.bytes;
+
+    qDebug() << "Geometry cache: loaded" << modelPath << (cooked.isEmpty() ? "" : "(cooked)") << "("
+             << m_entries.size() << "entries," << m_bytesResident << "bytes resident )";
+    return entry.renderer;
+}
+
+void GeometryCache::release(const QString &modelPath)
+{
+    auto alias = m_aliases.find(modelPath);
+    if (alias == m_aliases.end()) {
+        return;
+    }
+    const QString key = alias->key;
+    if (--alias->refCount == 0) {
+        m_aliases.erase(alias);
+    }
+
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return;
+    }
+
+    if (--it->refCount > 0) {
+        return;
+    }
+
+    m_bytesResident -= it->bytes;
+    delete it->renderer;
+    m_entries.erase(it);
+
+    qDebug() << "Geometry cache: evicted" << modelPath << "(" << m_entries.size() << "entries left )";
+}
+
+void GeometryCache::updateKey(const QString &modelPath)
+{
+    for (auto alias = m_aliases.begin(); alias != m_aliases.end(); ++alias) {
+        if (QDir::cleanPath(QFileInfo(alias.key()).absoluteFilePath()) != modelPath) {
+            continue;
+        }
+
+        const QString key = AssetStore::instance()->contentKey(alias.key());
+        auto it = m_entries.find(alias->key);
+        if (key == alias->key || it == m_entries.end() || it->refCount != alias->refCount
+            || m_entries.contains(key)) {
+            continue;
+        }
+
+        const Entry entry = *it;
+        m_entries.erase(it);
+        m_entries.insert(key, entry);
+        qDebug() << "Geometry cache: re-keyed" << alias.key() << "from" << alias->key << "to" << key;
+        alias->key = key;
+    }
+}
+
+void GeometryCache::clear()
+{
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        delete it->renderer;
+    }
+    m_entries.clear();
+    m_aliases.clear();
+    m_bytesResident = 0;
+}
+
+int GeometryCache::pendingCount() const
+{
+    return pendingMeshes().size();
+}
+
+QVector<Qt3DRender::QMesh *> GeometryCache::pendingMeshes() const
+{
+    QVector<Qt3DRender::QMesh *> pending;
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        Qt3DRender::QMesh *mesh = qobject_cast<Qt3DRender::QMesh *>(it->renderer);
+        if (mesh && (mesh->status() == Qt3DRender::QMesh::None || mesh->status() == Qt3DRender::QMesh::Loading)) {
+            pending.append(mesh);
+        }
+    }
+    return pending;
+}
+
+float GeometryCache::hitRate() const
+{
+    const quint64 total = m_hits + m_misses;
+    return total > 0 ? float(m_hits) / float(total) : 0.0f;
+}
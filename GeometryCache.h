@@ -0,0 +1,73 @@
+#ifndef GEOMETRYCACHE_H
+#define GEOMETRYCACHE_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <Qt3DCore/QNode>
+#include <Qt3DRender/QGeometryRenderer>
+#include <Qt3DRender/QMesh>
+
+// Cache cu numarare de referinte pentru geometria modelelor.
+// Toate entitatile de acelasi tip partajeaza un singur QGeometryRenderer, deci
+// fisierul este parsat si incarcat pe GPU o singura data. Intrarea este eliberata
+// cand ultimul utilizator renunta la ea (clearScene / removeObject).
+// Intrarile sunt indexate dupa continut (AssetStore::contentKey): doua nume de model cu
+// aceiasi octeti partajeaza acelasi QGeometryRenderer. Cheia unei cai este rezolvata la
+// fiecare acquire fara referinte active si mutata prin updateKey cand indexul de continut
+// afla hash-ul caii (ex. dupa indexarea din fundal).
+// Un model cu blob gatit valid (MeshCooker) este copiat direct in buffer-ele geometriei;
+// restul formatelor (si modelele inca negatite) trec prin parser-ul QMesh.
+class GeometryCache
+{
+public:
+    // owner trebuie sa faca parte din scena in care vor fi folosite mesh-urile
+    explicit GeometryCache(Qt3DCore::QNode *owner);
+    ~GeometryCache();
+
+    // Returneaza geometria partajata pentru modelPath si incrementeaza numarul de utilizatori
+    Qt3DRender::QGeometryRenderer *acquire(const QString &modelPath);
+    // Decrementeaza numarul de utilizatori; la zero geometria este distrusa
+    void release(const QString &modelPath);
+    // Indexul de continut s-a schimbat pentru modelPath (cale absoluta): intrarea folosita doar
+    // de aceasta cale trece sub noua cheie. O intrare partajata cu alte cai, sau o cheie deja
+    // ocupata, ramane pe vechea cheie pana la eliberare (renderer-ul este deja in scena).
+    void updateKey(const QString &modelPath);
+    void clear();
+
+    int entryCount() const { return m_entries.size(); }
+    // Mesh-uri al caror fisier nu a terminat inca de incarcat
+    int pendingCount() const;
+    // Aceleasi mesh-uri, pentru a astepta statusChanged (ex. renderToImage)
+    QVector<Qt3DRender::QMesh *> pendingMeshes() const;
+    qint64 bytesResident() const { return m_bytesResident; }
+    quint64 hits() const { return m_hits; }
+    quint64 misses() const { return m_misses; }
+    // Intrari incarcate din blob-uri gatite, fara parser
+    quint64 cookedLoads() const { return m_cookedLoads; }
+    float hitRate() const;
+
+private:
+    struct Entry {
+        Qt3DRender::QGeometryRenderer *renderer;
+        int refCount;
+        qint64 bytes;
+    };
+
+    Qt3DCore::QNode *m_owner;
+    struct Alias {
+        QString key; // cheia de continut aleasa la primul acquire al caii
+        int refCount;
+    };
+
+    QHash<QString, Entry> m_entries;
+    // Calea -> cheia folosita la acquire, ca release sa gaseasca aceeasi intrare chiar daca
+    // indexul de continut s-a schimbat intre timp
+    QHash<QString, Alias> m_aliases;
+    qint64 m_bytesResident;
+    quint64 m_hits;
+    quint64 m_misses;
+    quint64 m_cookedLoads;
+};
+
+#endif // GEOMETRYCACHE_H
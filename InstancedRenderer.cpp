@@ -0,0 +1,294 @@
+#include "InstancedRenderer.h"
+#include <Qt3DCore/QGeometry>
+#include <Qt3DCore/QAttribute>
+#include <Qt3DRender/QEffect>
+#include <Qt3DRender/QTechnique>
+#include <Qt3DRender/QRenderPass>
+#include <Qt3DRender/QShaderProgram>
+#include <Qt3DRender/QGraphicsApiFilter>
+#include <Qt3DRender/QFilterKey>
+#include <Qt3DRender/QParameter>
+#include <QCoreApplication>
+#include <QUrl>
+#include <QDebug>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+Qt3DCore::QAttribute *createAttribute(Qt3DCore::QGeometry *geometry, Qt3DCore::QBuffer *buffer,
+                                      const QString &name, uint size, uint offset, uint stride, uint count)
+{
+    auto *attribute = new Qt3DCore::QAttribute(geometry);
+    attribute->setName(name);
+    attribute->setAttributeType(Qt3DCore::QAttribute::VertexAttribute);
+    attribute->setVertexBaseType(Qt3DCore::QAttribute::Float);
+    attribute->setVertexSize(size);
+    attribute->setBuffer(buffer);
+    attribute->setByteOffset(offset);
+    attribute->setByteStride(stride);
+    attribute->setCount(count);
+    geometry->addAttribute(attribute);
+    return attribute;
+}
+
+} // namespace
+
+InstancedRenderer::InstancedRenderer(Qt3DCore::QEntity *rootEntity)
+    : m_rootEntity(rootEntity), m_material(nullptr), m_lastUpdatedInstances(0)
+{
+}
+
+InstancedRenderer::~InstancedRenderer()
+{
+    // Entitatile si materialul sunt copii ai rootEntity si sunt distruse odata cu scena
+    qDeleteAll(m_batches);
+}
+
+Qt3DRender::QMaterial *InstancedRenderer::createInstancedMaterial()
+{
+    auto *material = new Qt3DRender::QMaterial(m_rootEntity);
+    auto *effect = new Qt3DRender::QEffect(material);
+    auto *technique = new Qt3DRender::QTechnique(effect);
+    technique->graphicsApiFilter()->setApi(Qt3DRender::QGraphicsApiFilter::OpenGL);
+    technique->graphicsApiFilter()->setMajorVersion(3);
+    technique->graphicsApiFilter()->setMinorVersion(3);
+    technique->graphicsApiFilter()->setProfile(Qt3DRender::QGraphicsApiFilter::CoreProfile);
+
+    // QForwardRenderer selecteaza doar tehnicile marcate cu renderingStyle=forward
+    auto *filterKey = new Qt3DRender::QFilterKey(technique);
+    filterKey->setName(QStringLiteral("renderingStyle"));
+    filterKey->setValue(QStringLiteral("forward"));
+    technique->addFilterKey(filterKey);
+
+    auto *renderPass = new Qt3DRender::QRenderPass(technique);
+    auto *shader = new Qt3DRender::QShaderProgram(renderPass);
+    QString shaderBase = QCoreApplication::applicationDirPath() + "/../../../";
+    shader->setVertexShaderCode(Qt3DRender::QShaderProgram::loadSource(QUrl::fromLocalFile(shaderBase + "pbr_instanced.vert")));
+    shader->setFragmentShaderCode(Qt3DRender::QShaderProgram::loadSource(QUrl::fromLocalFile(shaderBase + "pbr_instanced.frag")));
+    renderPass->setShaderProgram(shader);
+
+    technique->addRenderPass(renderPass);
+    effect->addTechnique(technique);
+    material->setEffect(effect);
+
+    // Aceeasi lumina principala ca in setupLighting()
+    material->addParameter(new Qt3DRender::QParameter(QStringLiteral("lightPositions[0]"), QVector3D(0.0f, 20.0f, 15.0f)));
+    material->addParameter(new Qt3DRender::QParameter(QStringLiteral("lightColors[0]"), QVector3D(1.0f, 1.0f, 1.0f)));
+    material->addParameter(new Qt3DRender::QParameter(QStringLiteral("lightIntensity"), 0.8f));
+
+    return material;
+}
+
+InstancedRenderer::Batch *InstancedRenderer::createBatch(const QString &modelPath)
+{
+    MeshData mesh;
+    if (!ObjLoader::load(modelPath, mesh)) {
+        m_unsupported.insert(modelPath, true);
+        qDebug() << "Instancing not available for" << modelPath << "- using per-entity rendering";
+        return nullptr;
+    }
+
+    if (!m_material) {
+        m_material = createInstancedMaterial();
+    }
+
+    Batch *batch = new Batch;
+    batch->entity = new Qt3DCore::QEntity(m_rootEntity);
+    batch->renderer = new Qt3DRender::QGeometryRenderer(batch->entity);
+
+    auto *geometry = new Qt3DCore::QGeometry(batch->renderer);
+
+    auto *vertexBuffer = new Qt3DCore::QBuffer(geometry);
+    vertexBuffer->setData(mesh.interleavedVertexData());
+    const uint vertexCount = uint(mesh.vertexCount());
+    const uint stride = MeshData::INTERLEAVED_STRIDE;
+    createAttribute(geometry, vertexBuffer, Qt3DCore::QAttribute::defaultPositionAttributeName(), 3, 0, stride, vertexCount);
+    createAttribute(geometry, vertexBuffer, Qt3DCore::QAttribute::defaultNormalAttributeName(), 3, 3 * sizeof(float), stride, vertexCount);
+    createAttribute(geometry, vertexBuffer, Qt3DCore::QAttribute::defaultTextureCoordinateAttributeName(), 2, 6 * sizeof(float), stride, vertexCount);
+
+    auto *indexBuffer = new Qt3DCore::QBuffer(geometry);
+    indexBuffer->setData(mesh.indexData());
+    auto *indexAttribute = new Qt3DCore::QAttribute(geometry);
+    indexAttribute->setAttributeType(Qt3DCore::QAttribute::IndexAttribute);
+    indexAttribute->setVertexBaseType(Qt3DCore::QAttribute::UnsignedInt);
+    indexAttribute->setBuffer(indexBuffer);
+    indexAttribute->setCount(uint(mesh.indices.size()));
+    geometry->addAttribute(indexAttribute);
+
+    batch->instanceBuffer = new Qt3DCore::QBuffer(geometry);
+    const uint instanceStride = INSTANCE_STRIDE;
+    batch->instanceAttributes << createAttribute(geometry, batch->instanceBuffer, QStringLiteral("instanceTranslationScale"), 4, 0, instanceStride, 0)
+                              << createAttribute(geometry, batch->instanceBuffer, QStringLiteral("instanceRotation"), 4, 4 * sizeof(float), instanceStride, 0)
+                              << createAttribute(geometry, batch->instanceBuffer, QStringLiteral("instanceColor"), 4, 8 * sizeof(float), instanceStride, 0);
+    for (Qt3DCore::QAttribute *attribute : batch->instanceAttributes) {
+        attribute->setDivisor(1);
+    }
+
+    batch->renderer->setGeometry(geometry);
+    batch->renderer->setPrimitiveType(Qt3DRender::QGeometryRenderer::Triangles);
+
+    // Volumul calculat de Qt3D ar acoperi doar mesh-ul din origine, nu toate instantele
+    batch->boundingVolume = new Qt3DCore::QBoundingVolume(batch->entity);
+
+    float radius = 0.0f;
+    for (const QVector3D &p : mesh.positions) {
+        radius = qMax(radius, p.length());
+    }
+    batch->meshRadius = radius;
+
+    batch->entity->addComponent(batch->renderer);
+    batch->entity->addComponent(m_material);
+    batch->entity->addComponent(batch->boundingVolume);
+
+    m_batches.insert(modelPath, batch);
+    return batch;
+}
+
+void InstancedRenderer::beginRebuild()
+{
+    for (Batch *batch : std::as_const(m_batches)) {
+        batch->transforms.clear();
+        batch->colors.clear();
+    }
+}
+
+bool InstancedRenderer::addInstance(const QString &modelPath, Qt3DCore::QTransform *transform, const QColor &color)
+{
+    if (!transform || m_unsupported.contains(modelPath)) {
+        return false;
+    }
+
+    Batch *batch = m_batches.value(modelPath, nullptr);
+    if (!batch) {
+        batch = createBatch(modelPath);
+        if (!batch) {
+            return false;
+        }
+    }
+
+    batch->transforms.append(transform);
+    batch->colors.append(color);
+    return true;
+}
+
+void InstancedRenderer::endRebuild()
+{
+    for (auto it = m_batches.begin(); it != m_batches.end();) {
+        Batch *batch = it.value();
+        if (batch->transforms.isEmpty()) {
+            delete batch->entity;
+            delete batch;
+            it = m_batches.erase(it);
+            continue;
+        }
+        uploadAll(*batch);
+        ++it;
+    }
+
+    qDebug() << "Instanced rendering:" << instanceCount() << "instances in" << m_batches.size() << "draw calls";
+}
+
+bool InstancedRenderer::packInstance(const Qt3DCore::QTransform *transform, const QColor &color, float *out)
+{
+    const QVector3D t = transform->translation();
+    const QQuaternion q = transform->rotation();
+    const float packed[INSTANCE_FLOATS] = {
+        t.x(), t.y(), t.z(), transform->scale3D().x(), // scalare uniforma
+        q.x(), q.y(), q.z(), q.scalar(),
+        float(color.redF()), float(color.greenF()), float(color.blueF()), float(color.alphaF())
+    };
+
+    if (std::memcmp(out, packed, sizeof(packed)) == 0) {
+        return false;
+    }
+    std::memcpy(out, packed, sizeof(packed));
+    return true;
+}
+
+void InstancedRenderer::uploadAll(Batch &batch)
+{
+    const int count = batch.transforms.size();
+    batch.instanceData.fill(0.0f, count * INSTANCE_FLOATS);
+    for (int i = 0; i < count; ++i) {
+        packInstance(batch.transforms[i], batch.colors[i], batch.instanceData.data() + i * INSTANCE_FLOATS);
+    }
+
+    batch.instanceBuffer->setData(QByteArray(reinterpret_cast<const char *>(batch.instanceData.constData()),
+                                             count * INSTANCE_STRIDE));
+    for (Qt3DCore::QAttribute *attribute : std::as_const(batch.instanceAttributes)) {
+        attribute->setCount(uint(count));
+    }
+    batch.renderer->setInstanceCount(count);
+    updateBounds(batch);
+}
+
+void InstancedRenderer::updateBounds(Batch &batch)
+{
+    const int count = batch.transforms.size();
+    if (count == 0) {
+        return;
+    }
+
+    QVector3D minPoint(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+    QVector3D maxPoint = -minPoint;
+    for (int i = 0; i < count; ++i) {
+        const float *instance = batch.instanceData.constData() + i * INSTANCE_FLOATS;
+        const QVector3D center(instance[0], instance[1], instance[2]);
+        const float r = batch.meshRadius * qAbs(instance[3]);
+        minPoint = QVector3D(qMin(minPoint.x(), center.x() - r), qMin(minPoint.y(), center.y() - r), qMin(minPoint.z(), center.z() - r));
+        maxPoint = QVector3D(qMax(maxPoint.x(), center.x() + r), qMax(maxPoint.y(), center.y() + r), qMax(maxPoint.z(), center.z() + r));
+    }
+
+    batch.boundingVolume->setMinPoint(minPoint);
+    batch.boundingVolume->setMaxPoint(maxPoint);
+}
+
+void InstancedRenderer::sync()
+{
+    m_lastUpdatedInstances = 0;
+
+    for (Batch *batch : std::as_const(m_batches)) {
+        const int count = batch->transforms.size();
+        int firstDirty = -1;
+        int lastDirty = -1;
+
+        for (int i = 0; i < count; ++i) {
+            if (packInstance(batch->transforms[i], batch->colors[i], batch->instanceData.data() + i * INSTANCE_FLOATS)) {
+                if (firstDirty < 0)
+                    firstDirty = i;
+                lastDirty = i;
+                ++m_lastUpdatedInstances;
+            }
+        }
+
+        if (firstDirty < 0) {
+            continue;
+        }
+
+        // Un singur upload pentru intervalul continuu de instante modificate
+        const int offset = firstDirty * INSTANCE_STRIDE;
+        const int length = (lastDirty - firstDirty + 1) * INSTANCE_STRIDE;
+        batch->instanceBuffer->updateData(offset, QByteArray(reinterpret_cast<const char *>(batch->instanceData.constData()) + offset, length));
+        updateBounds(*batch);
+    }
+}
+
+void InstancedRenderer::clear()
+{
+    for (Batch *batch : std::as_const(m_batches)) {
+        delete batch->entity;
+        delete batch;
+    }
+    m_batches.clear();
+    m_unsupported.clear();
+}
+
+int InstancedRenderer::instanceCount() const
+{
+    int total = 0;
+    for (const Batch *batch : m_batches) {
+        total += batch->transforms.size();
+    }
+    return total;
+}
@@ -0,0 +1,73 @@
+#ifndef INSTANCEDRENDERER_H
+#define INSTANCEDRENDERER_H
+
+#include <QColor>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <Qt3DCore/QEntity>
+#include <Qt3DCore/QTransform>
+#include <Qt3DCore/QBuffer>
+#include <Qt3DCore/QBoundingVolume>
+#include <Qt3DRender/QGeometryRenderer>
+#include <Qt3DRender/QMaterial>
+
+#include "MeshData.h"
+
+// Randare instantiata pentru obiecte repetate.
+// Obiectele cu acelasi model sunt grupate intr-un singur draw call; transformarile si
+// culorile fiecarei instante stau intr-un buffer de atribute cu divisor 1 (vezi pbr_instanced.vert).
+class InstancedRenderer
+{
+public:
+    explicit InstancedRenderer(Qt3DCore::QEntity *rootEntity);
+    ~InstancedRenderer();
+
+    // Porneste o noua constructie a loturilor; instantele se adauga apoi cu addInstance()
+    void beginRebuild();
+    // Returneaza false daca modelul nu poate fi instantiat (ex. format fara cititor CPU)
+    bool addInstance(const QString &modelPath, Qt3DCore::QTransform *transform, const QColor &color);
+    void endRebuild();
+
+    // Rescrie doar instantele ale caror transformari s-au schimbat
+    void sync();
+    void clear();
+
+    int batchCount() const { return m_batches.size(); }
+    int instanceCount() const;
+    int lastUpdatedInstances() const { return m_lastUpdatedInstances; }
+
+private:
+    // 4 floats translatie+scala, 4 floats rotatie (quaternion xyzw), 4 floats culoare
+    static constexpr int INSTANCE_FLOATS = 12;
+    static constexpr int INSTANCE_STRIDE = INSTANCE_FLOATS * sizeof(float);
+
+    struct Batch {
+        Qt3DCore::QEntity *entity = nullptr;
+        Qt3DRender::QGeometryRenderer *renderer = nullptr;
+        Qt3DCore::QBuffer *instanceBuffer = nullptr;
+        Qt3DCore::QBoundingVolume *boundingVolume = nullptr;
+        QVector<Qt3DCore::QAttribute *> instanceAttributes;
+        float meshRadius = 1.0f;
+
+        QVector<Qt3DCore::QTransform *> transforms;
+        QVector<QColor> colors;
+        QVector<float> instanceData; // copia CPU a buffer-ului de instante
+    };
+
+    Batch *createBatch(const QString &modelPath);
+    void uploadAll(Batch &batch);
+    static bool packInstance(const Qt3DCore::QTransform *transform, const QColor &color, float *out);
+    static void updateBounds(Batch &batch);
+
+    Qt3DRender::QMaterial *createInstancedMaterial();
+
+    Qt3DCore::QEntity *m_rootEntity;
+    Qt3DRender::QMaterial *m_material;
+    QHash<QString, Batch *> m_batches;
+    // Modele care nu pot fi citite pe CPU; nu mai incercam de fiecare data
+    QHash<QString, bool> m_unsupported;
+    int m_lastUpdatedInstances;
+};
+
+#endif // INSTANCEDRENDERER_H
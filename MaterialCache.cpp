@@ -0,0 +1,99 @@
+#include "MaterialCache.h"
+#include "PBRMaterial.h"
+#include <Qt3DExtras/QPhongMaterial>
+#include <QDebug>
+
+MaterialCache::MaterialCache(Qt3DCore::QNode *owner)
+    : m_owner(owner), m_pbrEffect(nullptr), m_textureToken(TextureLoader::createToken()), m_phongCount(0)
+{
+}
+
+MaterialCache::~MaterialCache()
+{
+    // Nodurile sunt copii ai owner-ului si sunt distruse odata cu scena
+    m_entries.clear();
+    m_keys.clear();
+}
+
+Qt3DRender::QMaterial *MaterialCache::acquire(const QString &modelType, const QColor &color, Kind kind)
+{
+    Key key;
+    // Materialul Phong depinde doar de culoare; texturile PBR depind si de tipul modelului
+    key.modelType = kind == Kind::PBR ? modelType : QString();
+    key.color = color.rgba();
+    key.kind = kind;
+
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        ++it->refCount;
+        return it->material;
+    }
+
+    Entry entry;
+    entry.material = createMaterial(key, color);
+    entry.refCount = 1;
+
+    m_entries.insert(key, entry);
+    m_keys.insert(entry.material, key);
+    return entry.material;
+}
+
+Qt3DRender::QMaterial *MaterialCache::createMaterial(const Key &key, const QColor &color)
+{
+    if (key.kind == Kind::PBR) {
+        if (!m_pbrEffect) {
+            m_pbrEffect = PBRMaterial::createEffect(m_owner);
+        }
+        return new PBRMaterial(m_owner, key.modelType, color, m_pbrEffect, m_textureToken);
+    }
+
+    Qt3DExtras::QPhongMaterial *phongMaterial = new Qt3DExtras::QPhongMaterial(m_owner);
+    phongMaterial->setDiffuse(color);
+    phongMaterial->setSpecular(color.lighter(110));
+    phongMaterial->setShininess(50.0f);
+    phongMaterial->setAmbient(color.darker(150));
+    ++m_phongCount;
+    return phongMaterial;
+}
+
+void MaterialCache::release(Qt3DRender::QMaterial *material)
+{
+    auto keyIt = m_keys.find(material);
+    if (keyIt == m_keys.end()) {
+        return;
+    }
+
+    auto it = m_entries.find(keyIt.value());
+    if (it == m_entries.end() || --it->refCount > 0) {
+        return;
+    }
+
+    if (it.key().kind == Kind::Phong) {
+        --m_phongCount;
+    }
+    m_entries.erase(it);
+    m_keys.erase(keyIt);
+    delete material;
+}
+
+void MaterialCache::clear()
+{
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        delete it->material;
+    }
+    m_entries.clear();
+    m_keys.clear();
+    m_phongCount = 0;
+}
+
+void MaterialCache::cancelPendingTextures()
+{
+    // Cererile deja trimise pastreaza vechiul token; materialele noi primesc unul proaspat
+    TextureLoader::cancel(m_textureToken);
+    m_textureToken = TextureLoader::createToken();
+}
+
+int MaterialCache::uniqueEffectCount() const
+{
+    return m_phongCount + (m_pbrEffect ? 1 : 0);
+}
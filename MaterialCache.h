@@ -0,0 +1,69 @@
+#ifndef MATERIALCACHE_H
+#define MATERIALCACHE_H
+
+#include <QColor>
+#include <QHash>
+#include <QString>
+#include <Qt3DCore/QNode>
+#include <Qt3DRender/QEffect>
+#include <Qt3DRender/QMaterial>
+
+#include "TextureLoader.h"
+
+// Cache de materiale cu numarare de referinte.
+// Obiectele cu aceiasi parametri (tip model, culoare, tip material) folosesc acelasi nod
+// de material, iar toate materialele PBR partajeaza un singur QEffect compilat.
+class MaterialCache
+{
+public:
+    enum class Kind {
+        Phong,
+        PBR
+    };
+
+    explicit MaterialCache(Qt3DCore::QNode *owner);
+    ~MaterialCache();
+
+    Qt3DRender::QMaterial *acquire(const QString &modelType, const QColor &color, Kind kind);
+    void release(Qt3DRender::QMaterial *material);
+    void clear();
+    // Abandoneaza texturile PBR care inca se decodeaza (ex. la clearScene)
+    void cancelPendingTextures();
+
+    int uniqueMaterialCount() const { return m_entries.size(); }
+    // QPhongMaterial isi creeaza propriul efect; materialele PBR impart unul singur
+    int uniqueEffectCount() const;
+
+private:
+    struct Key {
+        QString modelType;
+        QRgb color;
+        Kind kind;
+
+        bool operator==(const Key &other) const
+        {
+            return color == other.color && kind == other.kind && modelType == other.modelType;
+        }
+
+        friend size_t qHash(const Key &key, size_t seed = 0)
+        {
+            return qHashMulti(seed, key.modelType, key.color, int(key.kind));
+        }
+    };
+
+    struct Entry {
+        Qt3DRender::QMaterial *material;
+        int refCount;
+    };
+
+    Qt3DRender::QMaterial *createMaterial(const Key &key, const QColor &color);
+
+    Qt3DCore::QNode *m_owner;
+    Qt3DRender::QEffect *m_pbrEffect;
+    TextureLoader::CancelToken m_textureToken;
+    QHash<Key, Entry> m_entries;
+    QHash<Qt3DRender::QMaterial *, Key> m_keys;
+    int m_phongCount;
+};
+
+#endif // MATERIALCACHE_H
@@ -0,0 +1,333 @@
+#include "MeshCooker.h"
+#include "MeshData.h"
+#include "ModelLod.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QSysInfo>
+#include <QThreadPool>
+#include <QVector>
+#include <QVector4D>
+#include <QtEndian>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr char MAGIC[4] = { 'M', 'S', 'H', 'C' };
+constexpr quint32 VERSION = 1;
+
+// Varfurile sunt scrise in ordinea nativa si copiate direct in buffer-ul GPU, deci antetul
+// foloseste tot little-endian, iar pe o masina big-endian blob-urile nu sunt folosite
+struct Header {
+    char magic[4];
+    quint32_le version;
+    qint64_le sourceSize;
+    qint64_le sourceModified; // ms since epoch
+    quint32_le vertexCount;
+    quint32_le indexCount;
+    quint32_le indexSize; // 2 sau 4 octeti
+    quint32_le vertexOffset;
+    quint32_le indexOffset;
+    quint32_le reserved;
+    float minimum[3];
+    float maximum[3];
+};
+
+static_assert(sizeof(MeshCooker::Vertex) == 28, "cooked vertex layout changed");
+
+bool supportedByteOrder()
+{
+    return QSysInfo::ByteOrder == QSysInfo::LittleEndian;
+}
+
+bool matchesSource(const Header &header, const QFileInfo &source)
+{
+    return std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION
+           && header.sourceSize == source.size()
+           && header.sourceModified == source.lastModified().toMSecsSinceEpoch();
+}
+
+bool readHeader(QFile &file, Header &header)
+{
+    return file.read(reinterpret_cast<char *>(&header), sizeof(header)) == qint64(sizeof(header));
+}
+
+// Indicele maxim dintr-un buffer de indici; un blob corupt nu trebuie sa trimita GPU-ului
+// indici in afara buffer-ului de varfuri
+template <typename Index>
+quint32 maximumIndex(const uchar *data, quint32 count)
+{
+    Index maximum = 0;
+    for (quint32 i = 0; i < count; ++i) {
+        Index index;
+        std::memcpy(&index, data + i * sizeof(Index), sizeof(Index));
+        maximum = qMax(maximum, index);
+    }
+    return maximum;
+}
+
+inline qint8 packSnorm(float value)
+{
+    return qint8(std::lround(qBound(-1.0f, value, 1.0f) * 127.0f));
+}
+
+// Tangente per varf din coordonatele de textura (acumulate pe triunghiuri, apoi
+// ortogonalizate fata de normala); zero unde modelul nu are UV-uri utilizabile, caz in care
+// pbr.vert isi construieste singur o tangenta
+QVector<QVector4D> computeTangents(const MeshData &mesh)
+{
+    const int count = mesh.vertexCount();
+    QVector<QVector4D> tangents(count, QVector4D(0, 0, 0, 1));
+    if (mesh.texCoords.size() < count || mesh.normals.size() < count) {
+        return tangents;
+    }
+
+    QVector<QVector3D> sDirections(count, QVector3D(0, 0, 0));
+    QVector<QVector3D> tDirections(count, QVector3D(0, 0, 0));
+    for (int i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        const quint32 a = mesh.indices[i], b = mesh.indices[i + 1], c = mesh.indices[i + 2];
+        const QVector3D e1 = mesh.positions[b] - mesh.positions[a];
+        const QVector3D e2 = mesh.positions[c] - mesh.positions[a];
+        const QVector2D d1 = mesh.texCoords[b] - mesh.texCoords[a];
+        const QVector2D d2 = mesh.texCoords[c] - mesh.texCoords[a];
+
+        const float determinant = d1.x() * d2.y() - d2.x() * d1.y();
+        if (qAbs(determinant) < 1e-12f) {
+            continue;
+        }
+        const float r = 1.0f / determinant;
+        const QVector3D s = (e1 * d2.y() - e2 * d1.y()) * r;
+        const QVector3D t = (e2 * d1.x() - e1 * d2.x()) * r;
+        for (quint32 v : { a, b, c }) {
+            sDirections[v] += s;
+            tDirections[v] += t;
+        }
+    }
+
+    for (int v = 0; v < count; ++v) {
+        const QVector3D &n = mesh.normals[v];
+        const QVector3D tangent = sDirections[v] - n * QVector3D::dotProduct(n, sDirections[v]);
+        if (tangent.lengthSquared() < 1e-12f) {
+            tangents[v] = QVector4D(0, 0, 0, 1);
+            continue;
+        }
+        const float handedness = QVector3D::dotProduct(QVector3D::crossProduct(n, tangent), tDirections[v]) < 0.0f ? -1.0f : 1.0f;
+        tangents[v] = QVector4D(tangent.normalized(), handedness);
+    }
+    return tangents;
+}
+
+} // namespace
+
+QString MeshCooker::cookedPath(const QString &sourcePath)
+{
+    const QFileInfo info(sourcePath);
+    return info.absolutePath() + "/.cooked/" + info.fileName() + ".mesh";
+}
+
+bool MeshCooker::canCook(const QString &sourcePath)
+{
+    return supportedByteOrder() && ObjLoader::canLoad(sourcePath);
+}
+
+bool MeshCooker::isCooked(const QString &sourcePath)
+{
+    QFile file(cookedPath(sourcePath));
+    Header header;
+    return canCook(sourcePath) && file.open(QIODevice::ReadOnly) && readHeader(file, header)
+           && matchesSource(header, QFileInfo(sourcePath));
+}
+
+bool MeshCooker::load(const QString &sourcePath, CookedMesh &mesh)
+{
+    if (!canCook(sourcePath)) {
+        return false;
+    }
+
+    QFile file(cookedPath(sourcePath));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const qint64 size = file.size();
+    if (size < qint64(sizeof(Header))) {
+        return false;
+    }
+
+    // Fisierul mapat este copiat in bloc (fara parsare) in buffer-ele QByteArray: Qt3D le
+    // partajeaza cu thread-ul de randare, care poate trai mai mult decat maparea
+    const uchar *data = file.map(0, size);
+    if (!data) {
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, data, sizeof(header));
+    if (!matchesSource(header, QFileInfo(sourcePath))) {
+        qDebug() << "Cooked mesh is stale:" << cookedPath(sourcePath);
+        return false;
+    }
+
+    const quint32 indexSize = header.indexSize;
+    const qint64 vertexBytes = qint64(header.vertexCount) * VERTEX_STRIDE;
+    const qint64 indexBytes = qint64(header.indexCount) * indexSize;
+    if ((indexSize != 2 && indexSize != 4) || header.indexCount % 3 != 0
+        || header.vertexOffset + vertexBytes > size || header.indexOffset + indexBytes > size) {
+        qDebug() << "Cooked mesh is corrupt:" << cookedPath(sourcePath);
+        return false;
+    }
+    const uchar *indices = data + header.indexOffset;
+    const quint32 maximum = indexSize == 2 ? maximumIndex<quint16>(indices, header.indexCount)
+                                           : maximumIndex<quint32>(indices, header.indexCount);
+    if (header.indexCount > 0 && maximum >= header.vertexCount) {
+        qDebug() << "Cooked mesh has out-of-range indices:" << cookedPath(sourcePath);
+        return false;
+    }
+
+    mesh.vertexData = QByteArray(reinterpret_cast<const char *>(data + header.vertexOffset), int(vertexBytes));
+    mesh.indexData = QByteArray(reinterpret_cast<const char *>(data + header.indexOffset), int(indexBytes));
+    mesh.vertexCount = header.vertexCount;
+    mesh.indexCount = header.indexCount;
+    mesh.wideIndices = indexSize == 4;
+    mesh.minimum = QVector3D(header.minimum[0], header.minimum[1], header.minimum[2]);
+    mesh.maximum = QVector3D(header.maximum[0], header.maximum[1], header.maximum[2]);
+    return true;
+}
+
+bool MeshCooker::cook(const QString &sourcePath)
+{
+    if (!canCook(sourcePath)) {
+        return false;
+    }
+
+    MeshData mesh;
+    if (!ObjLoader::load(sourcePath, mesh)) {
+        return false;
+    }
+    return cook(sourcePath, mesh);
+}
+
+bool MeshCooker::cook(const QString &sourcePath, const MeshData &mesh)
+{
+    if (!canCook(sourcePath) || mesh.isEmpty()) {
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const int vertexCount = mesh.vertexCount();
+    const bool wideIndices = vertexCount > 0xFFFF;
+    const QVector<QVector4D> tangents = computeTangents(mesh);
+
+    QByteArray vertexData(vertexCount * VERTEX_STRIDE, Qt::Uninitialized);
+    Vertex *vertices = reinterpret_cast<Vertex *>(vertexData.data());
+    QVector3D minimum = mesh.positions.first();
+    QVector3D maximum = minimum;
+    for (int i = 0; i < vertexCount; ++i) {
+        const QVector3D &p = mesh.positions[i];
+        const QVector3D n = i < mesh.normals.size() ? mesh.normals[i] : QVector3D(0, 1, 0);
+        const QVector2D uv = i < mesh.texCoords.size() ? mesh.texCoords[i] : QVector2D(0, 0);
+        const QVector4D &t = tangents[i];
+
+        Vertex &vertex = vertices[i];
+        vertex.position[0] = p.x(); vertex.position[1] = p.y(); vertex.position[2] = p.z();
+        vertex.normal[0] = packSnorm(n.x()); vertex.normal[1] = packSnorm(n.y()); vertex.normal[2] = packSnorm(n.z());
+        vertex.normal[3] = 0;
+        vertex.tangent[0] = packSnorm(t.x()); vertex.tangent[1] = packSnorm(t.y()); vertex.tangent[2] = packSnorm(t.z());
+        vertex.tangent[3] = packSnorm(t.w());
+        vertex.texCoord[0] = uv.x(); vertex.texCoord[1] = uv.y();
+
+        minimum = QVector3D(qMin(minimum.x(), p.x()), qMin(minimum.y(), p.y()), qMin(minimum.z(), p.z()));
+        maximum = QVector3D(qMax(maximum.x(), p.x()), qMax(maximum.y(), p.y()), qMax(maximum.z(), p.z()));
+    }
+
+    QByteArray indexData;
+    if (wideIndices) {
+        indexData = mesh.indexData();
+    } else {
+        indexData.resize(mesh.indices.size() * int(sizeof(quint16)));
+        quint16 *out = reinterpret_cast<quint16 *>(indexData.data());
+        for (quint32 index : mesh.indices) {
+            *out++ = quint16(index);
+        }
+    }
+
+    const QFileInfo source(sourcePath);
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.sourceSize = source.size();
+    header.sourceModified = source.lastModified().toMSecsSinceEpoch();
+    header.vertexCount = quint32(vertexCount);
+    header.indexCount = quint32(mesh.indices.size());
+    header.indexSize = wideIndices ? 4 : 2;
+    header.vertexOffset = sizeof(Header);
+    header.indexOffset = quint32(sizeof(Header) + vertexData.size());
+    header.minimum[0] = minimum.x(); header.minimum[1] = minimum.y(); header.minimum[2] = minimum.z();
+    header.maximum[0] = maximum.x(); header.maximum[1] = maximum.y(); header.maximum[2] = maximum.z();
+
+    const QString cookedFilePath = cookedPath(sourcePath);
+    QDir().mkpath(QFileInfo(cookedFilePath).absolutePath());
+    QSaveFile file(cookedFilePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Failed to write cooked mesh:" << cookedFilePath << file.errorString();
+        return false;
+    }
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(vertexData);
+    file.write(indexData);
+    if (!file.commit()) {
+        qDebug() << "Failed to write cooked mesh:" << cookedFilePath;
+        return false;
+    }
+
+    qDebug() << "Cooked" << sourcePath << "-" << vertexCount << "vertices," << mesh.triangleCount()
+             << "triangles," << file.size() << "bytes in" << timer.elapsed() << "ms";
+    return true;
+}
+
+void MeshCooker::remove(const QString &sourcePath)
+{
+    QFile::remove(cookedPath(sourcePath));
+}
+
+QStringList MeshCooker::pendingModels(const QString &dirPath)
+{
+    QStringList pending;
+    // Nivelurile de detaliu sunt in directoare ascunse (.lod)
+    QDirIterator iterator(dirPath, QStringList() << "*.obj", QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+    while (iterator.hasNext()) {
+        const QString sourcePath = iterator.next();
+        if (canCook(sourcePath) && !isCooked(sourcePath)) {
+            pending.append(sourcePath);
+        }
+    }
+    return pending;
+}
+
+void MeshCooker::cookLibrary(const QString &dirPath)
+{
+    ModelLod::queue()->start(QRunnable::create([dirPath]() {
+        QElapsedTimer timer;
+        timer.start();
+
+        const QStringList pending = pendingModels(dirPath);
+        int cooked = 0;
+        for (const QString &sourcePath : pending) {
+            if (cook(sourcePath)) {
+                ++cooked;
+            }
+        }
+        if (!pending.isEmpty()) {
+            qDebug() << "Cooked" << cooked << "of" << pending.size() << "models in" << timer.elapsed() << "ms";
+        }
+    }));
+}
@@ -0,0 +1,61 @@
+#ifndef MESHCOOKER_H
+#define MESHCOOKER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QVector3D>
+#include <QtGlobal>
+
+struct MeshData;
+
+// Modele "gatite" (.cooked/<nume>.mesh langa fisierul sursa): varfurile si indicii unui OBJ,
+// gata de copiat intr-un QBuffer, ca GeometryCache sa nu mai treaca prin parser-ul QMesh.
+//   antet (sursa, numar de varfuri/indici, volum de incadrare) | varfuri | indici
+// Varfurile sunt intercalate ca in pbr.vert: pozitie float32, normala si tangenta SNORM8
+// (vectori unitari, eroare sub 1 grad), coordonate de textura float32 (pot depasi [0, 1]).
+// Indicii sunt pe 16 biti cand modelul are cel mult 65535 de varfuri.
+// Fisierul sursa ramane originalul: blob-ul retine dimensiunea si mtime-ul lui si este
+// ignorat (apoi regatit) cand acestea nu mai corespund.
+class MeshCooker
+{
+public:
+    struct Vertex {
+        float position[3];
+        qint8 normal[4];  // xyz, al patrulea octet nefolosit
+        qint8 tangent[4]; // xyz, w = sensul bitangentei
+        float texCoord[2];
+    };
+    static constexpr int VERTEX_STRIDE = sizeof(Vertex);
+
+    struct CookedMesh {
+        QByteArray vertexData; // Vertex[vertexCount]
+        QByteArray indexData;  // quint16 sau quint32
+        quint32 vertexCount = 0;
+        quint32 indexCount = 0;
+        bool wideIndices = false;
+        QVector3D minimum;
+        QVector3D maximum;
+
+        bool isEmpty() const { return indexCount == 0; }
+    };
+
+    static QString cookedPath(const QString &sourcePath);
+    static bool canCook(const QString &sourcePath);
+    // Exista un blob pentru versiunea curenta a sursei
+    static bool isCooked(const QString &sourcePath);
+
+    // Citeste blob-ul (fisier mapat in memorie); false daca lipseste sau este vechi
+    static bool load(const QString &sourcePath, CookedMesh &mesh);
+    static bool cook(const QString &sourcePath);
+    // Pentru apelantii care au deja varfurile citite (import, niveluri de detaliu)
+    static bool cook(const QString &sourcePath, const MeshData &mesh);
+    static void remove(const QString &sourcePath);
+
+    // Modelele dintr-un director (inclusiv nivelurile de detaliu) fara un blob valid
+    static QStringList pendingModels(const QString &dirPath);
+    // Gateste in fundal (pe ModelLod::queue) modelele care nu au inca blob
+    static void cookLibrary(const QString &dirPath);
+};
+
+#endif // MESHCOOKER_H
@@ -0,0 +1,285 @@
+#include "MeshData.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QSaveFile>
+#include <QDebug>
+#include <cstring>
+
+namespace {
+
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Citeste urmatorul token separat prin spatii din [cursor, end)
+inline bool nextToken(const char *&cursor, const char *end, const char *&tokenStart, int &tokenLength)
+{
+    while (cursor < end && isSpace(*cursor))
+        ++cursor;
+    if (cursor >= end)
+        return false;
+
+    tokenStart = cursor;
+    while (cursor < end && !isSpace(*cursor))
+        ++cursor;
+    tokenLength = int(cursor - tokenStart);
+    return true;
+}
+
+inline float parseFloat(const char *start, int length)
+{
+    // QByteArray::toFloat foloseste mereu locale-ul C, indiferent de setarile sistemului
+    return QByteArray::fromRawData(start, length).toFloat();
+}
+
+// Indice OBJ (1-based sau negativ/relativ) -> indice 0-based, -1 daca lipseste
+inline int resolveIndex(const char *start, int length, int count)
+{
+    if (length <= 0)
+        return -1;
+    bool ok = false;
+    int value = QByteArray::fromRawData(start, length).toInt(&ok);
+    if (!ok || value == 0)
+        return -1;
+    int index = value > 0 ? value - 1 : count + value;
+    return (index >= 0 && index < count) ? index : -1;
+}
+
+struct CornerKey {
+    int v, vt, vn;
+    bool operator==(const CornerKey &other) const
+    {
+        return v == other.v && vt == other.vt && vn == other.vn;
+    }
+};
+
+inline size_t qHash(const CornerKey &key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.v, key.vt, key.vn);
+}
+
+} // namespace
+
+QByteArray MeshData::interleavedVertexData() const
+{
+    const int count = positions.size();
+    QByteArray data(count * INTERLEAVED_STRIDE, Qt::Uninitialized);
+    float *out = reinterpret_cast<float *>(data.data());
+
+    for (int i = 0; i < count; ++i) {
+        const QVector3D &p = positions[i];
+        const QVector3D n = i < normals.size() ? normals[i] : QVector3D(0, 1, 0);
+        const QVector2D uv = i < texCoords.size() ? texCoords[i] : QVector2D(0, 0);
+        *out++ = p.x(); *out++ = p.y(); *out++ = p.z();
+        *out++ = n.x(); *out++ = n.y(); *out++ = n.z();
+        *out++ = uv.x(); *out++ = uv.y();
+    }
+    return data;
+}
+
+QByteArray MeshData::indexData() const
+{
+    return QByteArray(reinterpret_cast<const char *>(indices.constData()),
+                      indices.size() * int(sizeof(quint32)));
+}
+
+void MeshData::computeNormals()
+{
+    normals.fill(QVector3D(0, 0, 0), positions.size());
+
+    for (int i = 0; i + 2 < indices.size(); i += 3) {
+        const quint32 a = indices[i], b = indices[i + 1], c = indices[i + 2];
+        // Normala neponderata -> produsul vectorial pondereaza automat dupa arie
+        const QVector3D faceNormal = QVector3D::crossProduct(positions[b] - positions[a],
+                                                             positions[c] - positions[a]);
+        normals[a] += faceNormal;
+        normals[b] += faceNormal;
+        normals[c] += faceNormal;
+    }
+
+    for (QVector3D &n : normals) {
+        n = n.lengthSquared() > 0.0f ? n.normalized() : QVector3D(0, 1, 0);
+    }
+}
+
+bool ObjLoader::canLoad(const QString &filePath)
+{
+    return QFileInfo(filePath).suffix().compare("obj", Qt::CaseInsensitive) == 0;
+}
+
+bool ObjLoader::load(const QString &filePath, MeshData &mesh)
+{
+    mesh = MeshData();
+
+    if (!canLoad(filePath)) {
+        return false;
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "ObjLoader: could not open" << filePath;
+        return false;
+    }
+
+    const QByteArray content = file.readAll();
+    file.close();
+
+    QVector<QVector3D> filePositions;
+    QVector<QVector3D> fileNormals;
+    QVector<QVector2D> fileTexCoords;
+    QHash<CornerKey, quint32> cornerToVertex;
+    bool hasAllNormals = true;
+
+    QVector<quint32> polygon;
+
+    const char *cursor = content.constData();
+    const char *const end = cursor + content.size();
+
+    while (cursor < end) {
+        const char *lineEnd = static_cast<const char *>(std::memchr(cursor, '\n', size_t(end - cursor)));
+        if (!lineEnd)
+            lineEnd = end;
+
+        const char *token = nullptr;
+        int tokenLength = 0;
+        const char *lineCursor = cursor;
+        cursor = lineEnd + 1;
+
+        if (!nextToken(lineCursor, lineEnd, token, tokenLength))
+            continue;
+
+        if (tokenLength == 1 && token[0] == 'v') {
+            float xyz[3] = {0, 0, 0};
+            for (float &value : xyz) {
+                if (nextToken(lineCursor, lineEnd, token, tokenLength))
+                    value = parseFloat(token, tokenLength);
+            }
+            filePositions.append(QVector3D(xyz[0], xyz[1], xyz[2]));
+        }
+        else if (tokenLength == 2 && token[0] == 'v' && token[1] == 'n') {
+            float xyz[3] = {0, 0, 0};
+            for (float &value : xyz) {
+                if (nextToken(lineCursor, lineEnd, token, tokenLength))
+                    value = parseFloat(token, tokenLength);
+            }
+            fileNormals.append(QVector3D(xyz[0], xyz[1], xyz[2]));
+        }
+        else if (tokenLength == 2 && token[0] == 'v' && token[1] == 't') {
+            float uv[2] = {0, 0};
+            for (float &value : uv) {
+                if (nextToken(lineCursor, lineEnd, token, tokenLength))
+                    value = parseFloat(token, tokenLength);
+            }
+            fileTexCoords.append(QVector2D(uv[0], uv[1]));
+        }
+        else if (tokenLength == 1 && token[0] == 'f') {
+            polygon.clear();
+
+            while (nextToken(lineCursor, lineEnd, token, tokenLength)) {
+                // v, v/vt, v//vn sau v/vt/vn
+                const char *parts[3] = {token, nullptr, nullptr};
+                int lengths[3] = {tokenLength, 0, 0};
+                int part = 0;
+                for (int i = 0; i < tokenLength && part < 2; ++i) {
+                    if (token[i] == '/') {
+                        lengths[part] = int(&token[i] - parts[part]);
+                        ++part;
+                        parts[part] = &token[i + 1];
+                        lengths[part] = int(token + tokenLength - parts[part]);
+                    }
+                }
+
+                CornerKey key;
+                key.v = resolveIndex(parts[0], lengths[0], filePositions.size());
+                key.vt = parts[1] ? resolveIndex(parts[1], lengths[1], fileTexCoords.size()) : -1;
+                key.vn = parts[2] ? resolveIndex(parts[2], lengths[2], fileNormals.size()) : -1;
+                if (key.v < 0)
+                    continue;
+
+                auto it = cornerToVertex.constFind(key);
+                quint32 vertexIndex;
+                if (it != cornerToVertex.constEnd()) {
+                    vertexIndex = *it;
+                } else {
+                    vertexIndex = quint32(mesh.positions.size());
+                    mesh.positions.append(filePositions[key.v]);
+                    mesh.texCoords.append(key.vt >= 0 ? fileTexCoords[key.vt] : QVector2D(0, 0));
+                    mesh.normals.append(key.vn >= 0 ? fileNormals[key.vn] : QVector3D(0, 0, 0));
+                    if (key.vn < 0)
+                        hasAllNormals = false;
+                    cornerToVertex.insert(key, vertexIndex);
+                }
+                polygon.append(vertexIndex);
+            }
+
+            // Triangulare in evantai
+            for (int i = 1; i + 1 < polygon.size(); ++i) {
+                mesh.indices.append(polygon[0]);
+                mesh.indices.append(polygon[i]);
+                mesh.indices.append(polygon[i + 1]);
+            }
+        }
+    }
+
+    if (mesh.isEmpty()) {
+        qDebug() << "ObjLoader: no faces found in" << filePath;
+        return false;
+    }
+
+    if (!hasAllNormals) {
+        mesh.computeNormals();
+    }
+
+    qDebug() << "ObjLoader: loaded" << filePath << "-" << mesh.vertexCount() << "vertices,"
+             << mesh.triangleCount() << "triangles";
+    return true;
+}
+
+bool ObjWriter::save(const QString &filePath, const MeshData &mesh)
+{
+    if (mesh.isEmpty()) {
+        return false;
+    }
+
+    QByteArray content;
+    content.reserve(mesh.vertexCount() * 96 + mesh.triangleCount() * 40);
+
+    auto appendVector = [&content](const char *tag, std::initializer_list<float> values) {
+        content.append(tag);
+        for (float value : values) {
+            content.append(' ');
+            content.append(QByteArray::number(value, 'g', 7));
+        }
+        content.append('\n');
+    };
+
+    for (const QVector3D &p : mesh.positions) {
+        appendVector("v", { p.x(), p.y(), p.z() });
+    }
+    for (int i = 0; i < mesh.vertexCount(); ++i) {
+        const QVector2D uv = i < mesh.texCoords.size() ? mesh.texCoords[i] : QVector2D(0, 0);
+        appendVector("vt", { uv.x(), uv.y() });
+    }
+    for (int i = 0; i < mesh.vertexCount(); ++i) {
+        const QVector3D n = i < mesh.normals.size() ? mesh.normals[i] : QVector3D(0, 1, 0);
+        appendVector("vn", { n.x(), n.y(), n.z() });
+    }
+
+    for (int i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        content.append('f');
+        for (int k = 0; k < 3; ++k) {
+            const QByteArray index = QByteArray::number(mesh.indices[i + k] + 1);
+            content.append(' ').append(index).append('/').append(index).append('/').append(index);
+        }
+        content.append('\n');
+    }
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(content) != content.size() || !file.commit()) {
+        qDebug() << "ObjWriter: could not write" << filePath;
+        return false;
+    }
+    return true;
+}
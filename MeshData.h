@@ -0,0 +1,45 @@
+#ifndef MESHDATA_H
+#define MESHDATA_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <QVector2D>
+#include <QVector3D>
+
+// Date de varf citite pe CPU (pozitii, normale, coordonate de textura si indici de triunghi).
+// Folosite acolo unde QMesh nu ne ofera acces la geometrie (ex. randare instantiata).
+struct MeshData {
+    QVector<QVector3D> positions;
+    QVector<QVector3D> normals;
+    QVector<QVector2D> texCoords;
+    QVector<quint32> indices;
+
+    bool isEmpty() const { return indices.isEmpty(); }
+    int vertexCount() const { return positions.size(); }
+    int triangleCount() const { return indices.size() / 3; }
+
+    // position(3) normal(3) texCoord(2), float32
+    static constexpr int INTERLEAVED_STRIDE = 8 * sizeof(float);
+    QByteArray interleavedVertexData() const;
+    QByteArray indexData() const;
+
+    void computeNormals();
+};
+
+// Cititor minimal pentru Wavefront OBJ (v, vt, vn, f). Poligoanele sunt triangulate in evantai.
+class ObjLoader
+{
+public:
+    static bool canLoad(const QString &filePath);
+    static bool load(const QString &filePath, MeshData &mesh);
+};
+
+// Scrie un MeshData ca Wavefront OBJ (v, vt, vn, f cu indici identici pe cele trei canale)
+class ObjWriter
+{
+public:
+    static bool save(const QString &filePath, const MeshData &mesh);
+};
+
+#endif // MESHDATA_H
@@ -0,0 +1,409 @@
+#include "MeshSimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <vector>
+
+namespace {
+
+// Ponderea planelor perpendiculare pe muchiile de margine
+const double BOUNDARY_WEIGHT = 1000.0;
+// Un triunghi a carui normala se roteste mai mult decat atat la colapsare este considerat intors
+const double MIN_NORMAL_DOT = 0.2;
+
+struct Vec3 {
+    double x, y, z;
+
+    Vec3 operator+(const Vec3 &o) const { return { x + o.x, y + o.y, z + o.z }; }
+    Vec3 operator-(const Vec3 &o) const { return { x - o.x, y - o.y, z - o.z }; }
+    Vec3 operator*(double s) const { return { x * s, y * s, z * s }; }
+    double dot(const Vec3 &o) const { return x * o.x + y * o.y + z * o.z; }
+    Vec3 cross(const Vec3 &o) const { return { y * o.z - z * o.y, z * o.x - x * o.z, x * o.y - y * o.x }; }
+    double length() const { return std::sqrt(dot(*this)); }
+};
+
+// Matrice simetrica 4x4: aa ab ac ad bb bc bd cc cd dd
+struct Quadric {
+    double q[10] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+    static Quadric plane(const Vec3 &n, double d, double weight)
+    {
+        Quadric r;
+        const double a = n.x, b = n.y, c = n.z;
+        const double values[10] = { a * a, a * b, a * c, a * d, b * b, b * c, b * d, c * c, c * d, d * d };
+        for (int i = 0; i < 10; ++i) {
+            r.q[i] = values[i] * weight;
+        }
+        return r;
+    }
+
+    Quadric &operator+=(const Quadric &o)
+    {
+        for (int i = 0; i < 10; ++i) {
+            q[i] += o.q[i];
+        }
+        return *this;
+    }
+
+    double evaluate(const Vec3 &v) const
+    {
+        return q[0] * v.x * v.x + 2 * q[1] * v.x * v.y + 2 * q[2] * v.x * v.z + 2 * q[3] * v.x
+             + q[4] * v.y * v.y + 2 * q[5] * v.y * v.z + 2 * q[6] * v.y
+             + q[7] * v.z * v.z + 2 * q[8] * v.z
+             + q[9];
+    }
+
+    // Minimul cuadricei: A v = -b, rezolvat cu regula lui Cramer
+    bool optimal(Vec3 &v) const
+    {
+        const double a00 = q[0], a01 = q[1], a02 = q[2];
+        const double a11 = q[4], a12 = q[5], a22 = q[7];
+        const double b0 = -q[3], b1 = -q[6], b2 = -q[8];
+
+        const double det = a00 * (a11 * a22 - a12 * a12) - a01 * (a01 * a22 - a12 * a02)
+                         + a02 * (a01 * a12 - a11 * a02);
+        if (std::abs(det) < 1e-12) {
+            return false;
+        }
+
+        v.x = (b0 * (a11 * a22 - a12 * a12) - a01 * (b1 * a22 - a12 * b2) + a02 * (b1 * a12 - a11 * b2)) / det;
+        v.y = (a00 * (b1 * a22 - a12 * b2) - b0 * (a01 * a22 - a12 * a02) + a02 * (a01 * b2 - b1 * a02)) / det;
+        v.z = (a00 * (a11 * b2 - b1 * a12) - a01 * (a01 * b2 - b1 * a02) + b0 * (a01 * a12 - a11 * a02)) / det;
+        return true;
+    }
+};
+
+struct Candidate {
+    double cost;
+    int u, v;
+    quint32 stampU, stampV;
+    Vec3 position;
+
+    bool operator>(const Candidate &other) const { return cost > other.cost; }
+};
+
+quint64 edgeKey(int a, int b)
+{
+    return (quint64(quint32(std::min(a, b))) << 32) | quint32(std::max(a, b));
+}
+
+class Simplifier
+{
+public:
+    explicit Simplifier(const MeshData &source);
+    MeshSimplifier::Result run(int targetTriangles);
+
+private:
+    void weld();
+    void buildQuadrics();
+    void pushEdge(int u, int v);
+    bool flipsTriangles(int moved, int other, const Vec3 &position) const;
+    void collapse(const Candidate &candidate);
+    MeshData compact() const;
+
+    const MeshData &m_source;
+    std::vector<Vec3> m_positions;
+    std::vector<int> m_cornerVertex;     // varf original -> varf sudat
+    std::vector<int> m_representative;   // varf sudat -> primul varf original
+    std::vector<Quadric> m_quadrics;
+    std::vector<quint32> m_stamps;
+    std::vector<bool> m_removed;
+    std::vector<std::vector<int>> m_vertexTriangles;
+    std::vector<int> m_triangles;        // cate 3 varfuri sudate
+    std::vector<bool> m_deadTriangles;
+    int m_liveTriangles = 0;
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> m_heap;
+};
+
+Simplifier::Simplifier(const MeshData &source)
+    : m_source(source)
+{
+}
+
+void Simplifier::weld()
+{
+    const int count = m_source.vertexCount();
+    std::vector<int> order(count);
+    for (int i = 0; i < count; ++i) {
+        order[i] = i;
+    }
+
+    const QVector<QVector3D> &positions = m_source.positions;
+    auto less = [&positions](int a, int b) {
+        const QVector3D &pa = positions[a];
+        const QVector3D &pb = positions[b];
+        if (pa.x() != pb.x()) return pa.x() < pb.x();
+        if (pa.y() != pb.y()) return pa.y() < pb.y();
+        return pa.z() < pb.z();
+    };
+    std::sort(order.begin(), order.end(), less);
+
+    m_cornerVertex.assign(count, -1);
+    for (int i = 0; i < count; ++i) {
+        const int corner = order[i];
+        if (i == 0 || less(order[i - 1], corner)) {
+            const QVector3D &p = positions[corner];
+            m_positions.push_back({ p.x(), p.y(), p.z() });
+            m_representative.push_back(corner);
+        }
+        m_cornerVertex[corner] = int(m_positions.size()) - 1;
+        m_representative.back() = std::min(m_representative.back(), corner);
+    }
+}
+
+void Simplifier::buildQuadrics()
+{
+    const int vertexCount = int(m_positions.size());
+    m_quadrics.assign(vertexCount, Quadric());
+    m_stamps.assign(vertexCount, 0);
+    m_removed.assign(vertexCount, false);
+    m_vertexTriangles.assign(vertexCount, std::vector<int>());
+
+    const QVector<quint32> &indices = m_source.indices;
+    for (int i = 0; i + 2 < indices.size(); i += 3) {
+        const int a = m_cornerVertex[indices[i]];
+        const int b = m_cornerVertex[indices[i + 1]];
+        const int c = m_cornerVertex[indices[i + 2]];
+        if (a == b || b == c || a == c) {
+            continue;
+        }
+        const int triangle = int(m_triangles.size()) / 3;
+        m_triangles.insert(m_triangles.end(), { a, b, c });
+        m_vertexTriangles[a].push_back(triangle);
+        m_vertexTriangles[b].push_back(triangle);
+        m_vertexTriangles[c].push_back(triangle);
+    }
+    m_liveTriangles = int(m_triangles.size()) / 3;
+    m_deadTriangles.assign(m_liveTriangles, false);
+
+    // Planele triunghiurilor, ponderate cu aria
+    std::vector<quint64> edges;
+    edges.reserve(m_triangles.size());
+    for (int t = 0; t < m_liveTriangles; ++t) {
+        const int *v = &m_triangles[t * 3];
+        const Vec3 &p0 = m_positions[v[0]];
+        const Vec3 normal = (m_positions[v[1]] - p0).cross(m_positions[v[2]] - p0);
+        const double doubleArea = normal.length();
+        if (doubleArea > 0.0) {
+            const Vec3 n = normal * (1.0 / doubleArea);
+            const Quadric plane = Quadric::plane(n, -n.dot(p0), doubleArea * 0.5);
+            for (int k = 0; k < 3; ++k) {
+                m_quadrics[v[k]] += plane;
+            }
+        }
+        for (int k = 0; k < 3; ++k) {
+            edges.push_back(edgeKey(v[k], v[(k + 1) % 3]));
+        }
+    }
+
+    // Muchiile care apar o singura data sunt margini
+    std::vector<quint64> sorted = edges;
+    std::sort(sorted.begin(), sorted.end());
+    for (int t = 0; t < int(m_triangles.size()) / 3; ++t) {
+        const int *v = &m_triangles[t * 3];
+        const Vec3 &p0 = m_positions[v[0]];
+        const Vec3 faceNormal = (m_positions[v[1]] - p0).cross(m_positions[v[2]] - p0);
+        for (int k = 0; k < 3; ++k) {
+            const int a = v[k];
+            const int b = v[(k + 1) % 3];
+            const auto range = std::equal_range(sorted.begin(), sorted.end(), edgeKey(a, b));
+            if (range.second - range.first != 1) {
+                continue;
+            }
+            const Vec3 edge = m_positions[b] - m_positions[a];
+            const Vec3 perpendicular = edge.cross(faceNormal);
+            const double length = perpendicular.length();
+            if (length <= 0.0) {
+                continue;
+            }
+            const Vec3 n = perpendicular * (1.0 / length);
+            const Quadric plane = Quadric::plane(n, -n.dot(m_positions[a]), BOUNDARY_WEIGHT * edge.dot(edge));
+            m_quadrics[a] += plane;
+            m_quadrics[b] += plane;
+        }
+    }
+
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    for (quint64 key : sorted) {
+        pushEdge(int(key >> 32), int(key & 0xffffffffu));
+    }
+}
+
+void Simplifier::pushEdge(int u, int v)
+{
+    Quadric quadric = m_quadrics[u];
+    quadric += m_quadrics[v];
+
+    Candidate candidate;
+    candidate.u = u;
+    candidate.v = v;
+    candidate.stampU = m_stamps[u];
+    candidate.stampV = m_stamps[v];
+
+    Vec3 position;
+    if (quadric.optimal(position)) {
+        candidate.position = position;
+        candidate.cost = quadric.evaluate(position);
+    } else {
+        // Sistem singular (ex. zona plana): cel mai bun dintre capete si mijloc
+        const Vec3 options[3] = { m_positions[u], m_positions[v], (m_positions[u] + m_positions[v]) * 0.5 };
+        candidate.position = options[0];
+        candidate.cost = quadric.evaluate(options[0]);
+        for (int i = 1; i < 3; ++i) {
+            const double cost = quadric.evaluate(options[i]);
+            if (cost < candidate.cost) {
+                candidate.cost = cost;
+                candidate.position = options[i];
+            }
+        }
+    }
+    candidate.cost = std::max(candidate.cost, 0.0);
+    m_heap.push(candidate);
+}
+
+bool Simplifier::flipsTriangles(int moved, int other, const Vec3 &position) const
+{
+    for (int triangle : m_vertexTriangles[moved]) {
+        if (m_deadTriangles[triangle]) {
+            continue;
+        }
+        const int *v = &m_triangles[triangle * 3];
+        if (v[0] == other || v[1] == other || v[2] == other) {
+            continue; // dispare la colapsare
+        }
+
+        Vec3 before[3];
+        Vec3 after[3];
+        for (int k = 0; k < 3; ++k) {
+            before[k] = m_positions[v[k]];
+            after[k] = v[k] == moved ? position : before[k];
+        }
+        const Vec3 oldNormal = (before[1] - before[0]).cross(before[2] - before[0]);
+        const Vec3 newNormal = (after[1] - after[0]).cross(after[2] - after[0]);
+        const double oldLength = oldNormal.length();
+        const double newLength = newNormal.length();
+        if (newLength <= 0.0) {
+            return true;
+        }
+        if (oldLength > 0.0 && oldNormal.dot(newNormal) < MIN_NORMAL_DOT * oldLength * newLength) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Simplifier::collapse(const Candidate &candidate)
+{
+    const int u = candidate.u;
+    const int v = candidate.v;
+
+    m_positions[u] = candidate.position;
+    m_quadrics[u] += m_quadrics[v];
+    m_removed[v] = true;
+    ++m_stamps[u];
+
+    for (int triangle : m_vertexTriangles[v]) {
+        if (m_deadTriangles[triangle]) {
+            continue;
+        }
+        int *t = &m_triangles[triangle * 3];
+        if (t[0] == u || t[1] == u || t[2] == u) {
+            m_deadTriangles[triangle] = true;
+            --m_liveTriangles;
+            continue;
+        }
+        for (int k = 0; k < 3; ++k) {
+            if (t[k] == v) {
+                t[k] = u;
+            }
+        }
+        m_vertexTriangles[u].push_back(triangle);
+    }
+    m_vertexTriangles[v].clear();
+
+    // Lista lui u pastreaza doar triunghiurile vii; muchiile lui u primesc costuri noi
+    std::vector<int> &triangles = m_vertexTriangles[u];
+    triangles.erase(std::remove_if(triangles.begin(), triangles.end(),
+                                   [this](int triangle) { return m_deadTriangles[triangle]; }),
+                    triangles.end());
+
+    std::vector<int> neighbours;
+    for (int triangle : triangles) {
+        const int *t = &m_triangles[triangle * 3];
+        for (int k = 0; k < 3; ++k) {
+            if (t[k] != u) {
+                neighbours.push_back(t[k]);
+            }
+        }
+    }
+    std::sort(neighbours.begin(), neighbours.end());
+    neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+    for (int neighbour : neighbours) {
+        pushEdge(u, neighbour);
+    }
+}
+
+MeshData Simplifier::compact() const
+{
+    MeshData mesh;
+    std::vector<int> remap(m_positions.size(), -1);
+
+    for (int triangle = 0; triangle < int(m_deadTriangles.size()); ++triangle) {
+        if (m_deadTriangles[triangle]) {
+            continue;
+        }
+        for (int k = 0; k < 3; ++k) {
+            const int vertex = m_triangles[triangle * 3 + k];
+            if (remap[vertex] < 0) {
+                remap[vertex] = mesh.positions.size();
+                const Vec3 &p = m_positions[vertex];
+                mesh.positions.append(QVector3D(float(p.x), float(p.y), float(p.z)));
+                const int corner = m_representative[vertex];
+                mesh.texCoords.append(corner < m_source.texCoords.size() ? m_source.texCoords[corner] : QVector2D());
+            }
+            mesh.indices.append(quint32(remap[vertex]));
+        }
+    }
+
+    mesh.computeNormals();
+    return mesh;
+}
+
+MeshSimplifier::Result Simplifier::run(int targetTriangles)
+{
+    MeshSimplifier::Result result;
+    result.sourceTriangles = m_source.triangleCount();
+
+    weld();
+    buildQuadrics();
+
+    while (m_liveTriangles > targetTriangles && !m_heap.empty()) {
+        const Candidate candidate = m_heap.top();
+        m_heap.pop();
+
+        // Intrari vechi: unul dintre capete a fost eliminat sau mutat intre timp
+        if (m_removed[candidate.u] || m_removed[candidate.v] || candidate.stampU != m_stamps[candidate.u]
+            || candidate.stampV != m_stamps[candidate.v]) {
+            continue;
+        }
+        if (flipsTriangles(candidate.u, candidate.v, candidate.position)
+            || flipsTriangles(candidate.v, candidate.u, candidate.position)) {
+            continue;
+        }
+
+        collapse(candidate);
+        ++result.collapses;
+        result.maxError = std::max(result.maxError, candidate.cost);
+    }
+
+    result.mesh = compact();
+    return result;
+}
+
+} // namespace
+
+MeshSimplifier::Result MeshSimplifier::simplify(const MeshData &source, int targetTriangles)
+{
+    Simplifier simplifier(source);
+    return simplifier.run(qMax(0, targetTriangles));
+}
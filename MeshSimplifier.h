@@ -0,0 +1,29 @@
+#ifndef MESHSIMPLIFIER_H
+#define MESHSIMPLIFIER_H
+
+#include "MeshData.h"
+
+// Simplificare prin colapsarea muchiilor cu metrica de eroare patratica (Garland & Heckbert).
+// Fiecare varf acumuleaza o cuadrica din planele triunghiurilor vecine; muchia cu cea mai mica
+// eroare este colapsata intr-un singur varf, asezat in pozitia care minimizeaza eroarea.
+// Muchiile de margine primesc un plan perpendicular cu pondere mare, ca silueta sa ramana.
+//
+// Varfurile sunt sudate dupa pozitie inainte de simplificare, deci cusaturile de UV nu
+// despart plasa; normalele rezultatului sunt recalculate, iar coordonatele de textura sunt
+// cele ale primului colt al fiecarui varf sudat.
+class MeshSimplifier
+{
+public:
+    struct Result {
+        MeshData mesh;
+        int sourceTriangles = 0;
+        int collapses = 0;
+        double maxError = 0.0; // cea mai mare eroare patratica acceptata
+    };
+
+    // Colapseaza muchii pana cand raman cel mult targetTriangles triunghiuri (sau nu se mai
+    // poate colapsa nimic fara a intoarce triunghiuri)
+    static Result simplify(const MeshData &source, int targetTriangles);
+};
+
+#endif // MESHSIMPLIFIER_H
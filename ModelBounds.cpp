@@ -0,0 +1,397 @@
+#include "ModelBounds.h"
+#include "MeshData.h"
+#include "ModelCatalog.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QtMath>
+#include <QDebug>
+#include <limits>
+
+namespace {
+
+constexpr int INDEX_VERSION = 1;
+constexpr int SAVE_DELAY_MS = 1000;
+constexpr int JACOBI_SWEEPS = 16;
+
+// Vectorii proprii ai unei matrice simetrice 3x3 (rotatii Jacobi); coloanele lui vectors
+void symmetricEigenvectors(double m[3][3], double vectors[3][3])
+{
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            vectors[i][j] = i == j ? 1.0 : 0.0;
+        }
+    }
+
+    for (int sweep = 0; sweep < JACOBI_SWEEPS; ++sweep) {
+        const double offDiagonal = m[0][1] * m[0][1] + m[0][2] * m[0][2] + m[1][2] * m[1][2];
+        if (offDiagonal < 1e-18) {
+            break;
+        }
+
+        for (int p = 0; p < 2; ++p) {
+            for (int q = p + 1; q < 3; ++q) {
+                if (qAbs(m[p][q]) < 1e-12) {
+                    continue;
+                }
+
+                const double theta = (m[q][q] - m[p][p]) / (2.0 * m[p][q]);
+                const double t = (theta >= 0.0 ? 1.0 : -1.0) / (qAbs(theta) + qSqrt(theta * theta + 1.0));
+                const double c = 1.0 / qSqrt(t * t + 1.0);
+                const double s = t * c;
+
+                for (int k = 0; k < 3; ++k) {
+                    const double mkp = m[k][p];
+                    const double mkq = m[k][q];
+                    m[k][p] = c * mkp - s * mkq;
+                    m[k][q] = s * mkp + c * mkq;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const double mpk = m[p][k];
+                    const double mqk = m[q][k];
+                    m[p][k] = c * mpk - s * mqk;
+                    m[q][k] = s * mpk + c * mqk;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const double vkp = vectors[k][p];
+                    const double vkq = vectors[k][q];
+                    vectors[k][p] = c * vkp - s * vkq;
+                    vectors[k][q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+}
+
+// Sfera Ritter: doua treceri, raza cel mult ~5% peste cea minima
+void ritterSphere(const QVector<QVector3D> &positions, QVector3D &center, float &radius)
+{
+    const QVector3D &first = positions.first();
+    QVector3D farthest = first;
+    float farthestDistance = -1.0f;
+    for (const QVector3D &p : positions) {
+        const float d = (p - first).lengthSquared();
+        if (d > farthestDistance) {
+            farthestDistance = d;
+            farthest = p;
+        }
+    }
+
+    QVector3D opposite = farthest;
+    farthestDistance = -1.0f;
+    for (const QVector3D &p : positions) {
+        const float d = (p - farthest).lengthSquared();
+        if (d > farthestDistance) {
+            farthestDistance = d;
+            opposite = p;
+        }
+    }
+
+    center = (farthest + opposite) * 0.5f;
+    radius = (opposite - farthest).length() * 0.5f;
+
+    for (const QVector3D &p : positions) {
+        const float d = (p - center).length();
+        if (d > radius) {
+            const float newRadius = (radius + d) * 0.5f;
+            center += (p - center) * ((newRadius - radius) / d);
+            radius = newRadius;
+        }
+    }
+}
+
+QJsonArray toJson(const QVector3D &v)
+{
+    return QJsonArray{ v.x(), v.y(), v.z() };
+}
+
+QVector3D vectorFromJson(const QJsonValue &value)
+{
+    const QJsonArray array = value.toArray();
+    return QVector3D(array.at(0).toDouble(), array.at(1).toDouble(), array.at(2).toDouble());
+}
+
+} // namespace
+
+ModelBounds ModelBounds::fromPositions(const QVector<QVector3D> &positions)
+{
+    ModelBounds bounds;
+    if (positions.isEmpty()) {
+        return bounds;
+    }
+
+    // AABB si media pentru PCA
+    bounds.minimum = bounds.maximum = positions.first();
+    double mean[3] = { 0.0, 0.0, 0.0 };
+    for (const QVector3D &p : positions) {
+        bounds.minimum = QVector3D(qMin(bounds.minimum.x(), p.x()), qMin(bounds.minimum.y(), p.y()),
+                                   qMin(bounds.minimum.z(), p.z()));
+        bounds.maximum = QVector3D(qMax(bounds.maximum.x(), p.x()), qMax(bounds.maximum.y(), p.y()),
+                                   qMax(bounds.maximum.z(), p.z()));
+        mean[0] += p.x();
+        mean[1] += p.y();
+        mean[2] += p.z();
+    }
+    for (double &m : mean) {
+        m /= positions.size();
+    }
+
+    // Sfera: cea mai mica dintre sfera Ritter si sfera circumscrisa AABB-ului
+    ritterSphere(positions, bounds.sphereCenter, bounds.sphereRadius);
+    const float boxRadius = bounds.size().length() * 0.5f;
+    if (boxRadius < bounds.sphereRadius) {
+        bounds.sphereCenter = bounds.center();
+        bounds.sphereRadius = boxRadius;
+    }
+
+    // Cutia orientata: axele proprii ale covariantei, extinse pana la varfurile extreme
+    double covariance[3][3] = {};
+    for (const QVector3D &p : positions) {
+        const double d[3] = { p.x() - mean[0], p.y() - mean[1], p.z() - mean[2] };
+        for (int i = 0; i < 3; ++i) {
+            for (int j = i; j < 3; ++j) {
+                covariance[i][j] += d[i] * d[j];
+            }
+        }
+    }
+    covariance[1][0] = covariance[0][1];
+    covariance[2][0] = covariance[0][2];
+    covariance[2][1] = covariance[1][2];
+
+    double eigenvectors[3][3];
+    symmetricEigenvectors(covariance, eigenvectors);
+
+    QVector3D axisX(eigenvectors[0][0], eigenvectors[1][0], eigenvectors[2][0]);
+    QVector3D axisY(eigenvectors[0][1], eigenvectors[1][1], eigenvectors[2][1]);
+    axisX.normalize();
+    axisY = (axisY - axisX * QVector3D::dotProduct(axisX, axisY)).normalized();
+    const QVector3D axisZ = QVector3D::crossProduct(axisX, axisY); // baza dreapta
+
+    QVector3D low(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                  std::numeric_limits<float>::max());
+    QVector3D high = -low;
+    for (const QVector3D &p : positions) {
+        const QVector3D local(QVector3D::dotProduct(p, axisX), QVector3D::dotProduct(p, axisY),
+                              QVector3D::dotProduct(p, axisZ));
+        low = QVector3D(qMin(low.x(), local.x()), qMin(low.y(), local.y()), qMin(low.z(), local.z()));
+        high = QVector3D(qMax(high.x(), local.x()), qMax(high.y(), local.y()), qMax(high.z(), local.z()));
+    }
+
+    const QVector3D localCenter = (low + high) * 0.5f;
+    bounds.orientedRotation = QQuaternion::fromAxes(axisX, axisY, axisZ);
+    bounds.orientedCenter = axisX * localCenter.x() + axisY * localCenter.y() + axisZ * localCenter.z();
+    bounds.orientedHalfExtents = (high - low) * 0.5f;
+    bounds.valid = true;
+    return bounds;
+}
+
+ModelBoundsIndex *ModelBoundsIndex::instance()
+{
+    static ModelBoundsIndex *index = new ModelBoundsIndex(QCoreApplication::instance());
+    return index;
+}
+
+ModelBoundsIndex::ModelBoundsIndex(QObject *parent)
+    : QObject(parent), m_dirty(false), m_hits(0), m_misses(0)
+{
+    m_primitivesPath = QDir(ModelCatalog::instance()->primitivesPath()).absolutePath() + "/";
+    m_indexPath = QDir::cleanPath(m_primitivesPath + "../model_bounds.json");
+
+    // Mai multe modele noi intr-o scena inseamna o singura scriere a indexului
+    m_saveTimer = new QTimer(this);
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(SAVE_DELAY_MS);
+    connect(m_saveTimer, &QTimer::timeout, this, &ModelBoundsIndex::save);
+
+    connect(ModelCatalog::instance(), &ModelCatalog::catalogChanged,
+            this, &ModelBoundsIndex::onCatalogChanged);
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
+            this, &ModelBoundsIndex::save);
+
+    load();
+}
+
+QString ModelBoundsIndex::keyFor(const QString &modelPath) const
+{
+    const QString absolutePath = QFileInfo(modelPath).absoluteFilePath();
+    if (absolutePath.startsWith(m_primitivesPath)) {
+        return absolutePath.mid(m_primitivesPath.size());
+    }
+    return absolutePath;
+}
+
+ModelBoundsIndex::Entry ModelBoundsIndex::computeEntry(const QString &modelPath) const
+{
+    const QFileInfo info(modelPath);
+
+    Entry entry;
+    entry.fileSize = info.size();
+    entry.lastModified = info.lastModified().toMSecsSinceEpoch();
+    entry.verified = true;
+
+    if (ObjLoader::canLoad(modelPath)) {
+        MeshData mesh;
+        if (ObjLoader::load(modelPath, mesh)) {
+            entry.bounds = ModelBounds::fromPositions(mesh.positions);
+        }
+    }
+
+    qDebug() << "Computed bounds for" << modelPath << ":" << (entry.bounds.valid ? "size" : "unsupported format")
+             << entry.bounds.size();
+    return entry;
+}
+
+const ModelBounds &ModelBoundsIndex::bounds(const QString &modelPath)
+{
+    static const ModelBounds invalid;
+    if (modelPath.isEmpty()) {
+        return invalid;
+    }
+
+    const QString key = keyFor(modelPath);
+    auto it = m_entries.find(key);
+    if (it != m_entries.end() && it->verified) {
+        ++m_hits;
+        return it->bounds;
+    }
+
+    // Intrare citita de pe disc sau dinaintea unei rescanari: o verificam o singura data
+    if (it != m_entries.end()) {
+        const QFileInfo info(modelPath);
+        if (info.size() == it->fileSize && info.lastModified().toMSecsSinceEpoch() == it->lastModified) {
+            it->verified = true;
+            ++m_hits;
+            return it->bounds;
+        }
+    }
+
+    ++m_misses;
+    it = m_entries.insert(key, computeEntry(modelPath));
+    scheduleSave();
+    return it->bounds;
+}
+
+const ModelBounds &ModelBoundsIndex::refresh(const QString &modelPath)
+{
+    auto it = m_entries.insert(keyFor(modelPath), computeEntry(modelPath));
+    scheduleSave();
+    return it->bounds;
+}
+
+const ModelBounds &ModelBoundsIndex::store(const QString &modelPath, const ModelBounds &bounds)
+{
+    const QFileInfo info(modelPath);
+
+    Entry entry;
+    entry.bounds = bounds;
+    entry.fileSize = info.size();
+    entry.lastModified = info.lastModified().toMSecsSinceEpoch();
+    entry.verified = true;
+
+    auto it = m_entries.insert(keyFor(modelPath), entry);
+    scheduleSave();
+    return it->bounds;
+}
+
+void ModelBoundsIndex::onCatalogChanged()
+{
+    for (Entry &entry : m_entries) {
+        entry.verified = false;
+    }
+}
+
+void ModelBoundsIndex::scheduleSave()
+{
+    m_dirty = true;
+    m_saveTimer->start();
+}
+
+void ModelBoundsIndex::load()
+{
+    QFile file(m_indexPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("version").toInt() != INDEX_VERSION) {
+        qDebug() << "Ignoring model bounds index with unknown version:" << m_indexPath;
+        return;
+    }
+
+    const QJsonObject models = root.value("models").toObject();
+    for (auto it = models.constBegin(); it != models.constEnd(); ++it) {
+        const QJsonObject model = it.value().toObject();
+
+        Entry entry;
+        entry.fileSize = qint64(model.value("fileSize").toDouble());
+        entry.lastModified = qint64(model.value("lastModified").toDouble());
+        entry.verified = false;
+
+        ModelBounds &bounds = entry.bounds;
+        bounds.valid = model.value("valid").toBool();
+        if (bounds.valid) {
+            bounds.minimum = vectorFromJson(model.value("min"));
+            bounds.maximum = vectorFromJson(model.value("max"));
+            bounds.sphereCenter = vectorFromJson(model.value("sphereCenter"));
+            bounds.sphereRadius = float(model.value("sphereRadius").toDouble());
+            bounds.orientedCenter = vectorFromJson(model.value("obbCenter"));
+            bounds.orientedHalfExtents = vectorFromJson(model.value("obbHalfExtents"));
+            const QJsonArray rotation = model.value("obbRotation").toArray();
+            bounds.orientedRotation = QQuaternion(rotation.at(0).toDouble(), rotation.at(1).toDouble(),
+                                                  rotation.at(2).toDouble(), rotation.at(3).toDouble());
+        }
+        m_entries.insert(it.key(), entry);
+    }
+
+    qDebug() << "Model bounds index loaded" << m_entries.size() << "entries from" << m_indexPath;
+}
+
+void ModelBoundsIndex::save()
+{
+    m_saveTimer->stop();
+    if (!m_dirty) {
+        return;
+    }
+
+    QJsonObject models;
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        const ModelBounds &bounds = it->bounds;
+
+        QJsonObject model;
+        model["fileSize"] = double(it->fileSize);
+        model["lastModified"] = double(it->lastModified);
+        model["valid"] = bounds.valid;
+        if (bounds.valid) {
+            model["min"] = toJson(bounds.minimum);
+            model["max"] = toJson(bounds.maximum);
+            model["sphereCenter"] = toJson(bounds.sphereCenter);
+            model["sphereRadius"] = bounds.sphereRadius;
+            model["obbCenter"] = toJson(bounds.orientedCenter);
+            model["obbHalfExtents"] = toJson(bounds.orientedHalfExtents);
+            const QQuaternion &r = bounds.orientedRotation;
+            model["obbRotation"] = QJsonArray{ r.scalar(), r.x(), r.y(), r.z() };
+        }
+        models[it.key()] = model;
+    }
+
+    QJsonObject root;
+    root["version"] = INDEX_VERSION;
+    root["models"] = models;
+
+    QSaveFile file(m_indexPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Could not write model bounds index:" << m_indexPath;
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (file.commit()) {
+        m_dirty = false;
+    }
+}
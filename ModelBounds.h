@@ -0,0 +1,86 @@
+#ifndef MODELBOUNDS_H
+#define MODELBOUNDS_H
+
+#include <QObject>
+#include <QHash>
+#include <QQuaternion>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+#include <QVector3D>
+
+// Volume de incadrare ale unui model, in unitatile fisierului (inainte de scala transformarii).
+// Originea modelului nu este neaparat in centru, deci minimum/maximum nu sunt simetrice.
+struct ModelBounds {
+    QVector3D minimum;
+    QVector3D maximum;
+    QVector3D sphereCenter;
+    float sphereRadius = 0.0f;
+    // Cutie orientata dupa axele principale ale varfurilor (PCA)
+    QVector3D orientedCenter;
+    QVector3D orientedHalfExtents;
+    QQuaternion orientedRotation;
+    bool valid = false;
+
+    QVector3D size() const { return maximum - minimum; }
+    QVector3D center() const { return (minimum + maximum) * 0.5f; }
+
+    static ModelBounds fromPositions(const QVector<QVector3D> &positions);
+};
+
+// Index persistent al volumelor de incadrare pentru modelele din Models/primitives.
+// Varfurile unui model sunt citite o singura data (la import sau la prima cerere), iar
+// rezultatul este scris in Models/model_bounds.json impreuna cu dimensiunea si mtime-ul
+// fisierului. La pornire intrarile din index sunt refolosite daca fisierul nu s-a schimbat;
+// dupa prima verificare, o cerere este doar o cautare in hash.
+// Varfurile pot fi citite doar pentru formatele pe care le intelege ObjLoader; pentru
+// celelalte intrarea ramane invalida si apelantul foloseste dimensiunile aproximative.
+class ModelBoundsIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    static ModelBoundsIndex *instance();
+
+    const ModelBounds &bounds(const QString &modelPath);
+    // Recalculeaza volumele (ex. dupa ce fisierul a fost suprascris la import)
+    const ModelBounds &refresh(const QString &modelPath);
+    // Volume deja calculate in afara thread-ului GUI (ex. de AssetImporter)
+    const ModelBounds &store(const QString &modelPath, const ModelBounds &bounds);
+
+    void save();
+
+    QString indexPath() const { return m_indexPath; }
+    int entryCount() const { return m_entries.size(); }
+    quint64 hits() const { return m_hits; }
+    quint64 misses() const { return m_misses; }
+
+private slots:
+    void onCatalogChanged();
+
+private:
+    explicit ModelBoundsIndex(QObject *parent = nullptr);
+
+    struct Entry {
+        ModelBounds bounds;
+        qint64 fileSize;
+        qint64 lastModified; // ms since epoch
+        bool verified;       // comparat cu fisierul de pe disc in sesiunea curenta
+    };
+
+    void load();
+    QString keyFor(const QString &modelPath) const;
+    Entry computeEntry(const QString &modelPath) const;
+    void scheduleSave();
+
+    QString m_indexPath;
+    QString m_primitivesPath;
+    QHash<QString, Entry> m_entries;
+    QTimer *m_saveTimer;
+    bool m_dirty;
+
+    quint64 m_hits;
+    quint64 m_misses;
+};
+
+#endif // MODELBOUNDS_H
@@ -0,0 +1,183 @@
+#include "ModelCatalog.h"
+#include "ModelLod.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QDebug>
+
+namespace {
+// Fisierele din subdirectoare au prioritate mai mica decat cele din radacina
+constexpr int SUBDIR_PRIORITY_OFFSET = 100;
+constexpr int RESCAN_DELAY_MS = 250;
+}
+
+ModelCatalog *ModelCatalog::instance()
+{
+    static ModelCatalog *catalog = new ModelCatalog(QCoreApplication::instance());
+    return catalog;
+}
+
+const QStringList &ModelCatalog::supportedExtensions()
+{
+    // Support for multiple formats in priority order
+    static const QStringList extensions = {"fbx", "obj", "gltf", "glb", "3ds", "dae", "ply", "stl"};
+    return extensions;
+}
+
+ModelCatalog::ModelCatalog(QObject *parent)
+    : QObject(parent), m_hits(0), m_misses(0)
+{
+    m_basePath = QCoreApplication::applicationDirPath() + "/../../../Models/primitives/";
+
+    m_watcher = new QFileSystemWatcher(this);
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &ModelCatalog::onDirectoryChanged);
+
+    // Un import masiv genereaza multe notificari; le grupam intr-o singura rescanare
+    m_rescanTimer = new QTimer(this);
+    m_rescanTimer->setSingleShot(true);
+    m_rescanTimer->setInterval(RESCAN_DELAY_MS);
+    connect(m_rescanTimer, &QTimer::timeout, this, &ModelCatalog::rescan);
+
+    rescan();
+}
+
+int ModelCatalog::extensionPriority(const QString &suffix) const
+{
+    return supportedExtensions().indexOf(suffix.toLower());
+}
+
+void ModelCatalog::rescan()
+{
+    m_rescanTimer->stop();
+
+    m_files.clear();
+    m_subdirModels.clear();
+    m_partialMatches.clear();
+
+    QDir primitivesDir(m_basePath);
+    if (primitivesDir.exists()) {
+        indexDirectory(m_basePath, false);
+
+        const QStringList subdirs = primitivesDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+        for (const QString &subdir : subdirs) {
+            indexDirectory(m_basePath + subdir + "/", true);
+        }
+    }
+
+    updateWatchedPaths();
+
+    qDebug() << "Model catalog indexed" << m_files.size() << "models and"
+             << m_subdirModels.size() << "model directories from" << m_basePath;
+
+    emit catalogChanged();
+}
+
+void ModelCatalog::indexDirectory(const QString &dirPath, bool isSubdir)
+{
+    QDir dir(dirPath);
+    const QString subdirKey = dir.dirName().toLower();
+    const QStringList fileNames = dir.entryList(QDir::Files);
+
+    for (const QString &fileName : fileNames) {
+        QFileInfo fileInfo(fileName);
+        int priority = extensionPriority(fileInfo.suffix());
+        // Nivelurile de detaliu generate nu sunt tipuri de obiecte separate
+        if (priority < 0 || ModelLod::isLodFile(fileName)) {
+            continue;
+        }
+
+        const QString key = fileInfo.completeBaseName().toLower();
+        const QString path = dirPath + fileName;
+
+        if (isSubdir) {
+            // Modele complexe: Models/primitives/<nume>/<nume>.<ext>
+            if (key == subdirKey) {
+                auto it = m_subdirModels.find(subdirKey);
+                if (it == m_subdirModels.end() || priority < it->priority) {
+                    m_subdirModels.insert(subdirKey, Entry{path, priority});
+                }
+            }
+
+            // Un fisier dintr-un subdirector se potriveste doar daca numele subdirectorului il contine
+            if (!subdirKey.contains(key)) {
+                continue;
+            }
+            priority += SUBDIR_PRIORITY_OFFSET;
+        }
+
+        auto it = m_files.find(key);
+        if (it == m_files.end() || priority < it->priority) {
+            m_files.insert(key, Entry{path, priority});
+        }
+    }
+}
+
+void ModelCatalog::updateWatchedPaths()
+{
+    QStringList watched = m_watcher->directories();
+    if (!watched.isEmpty()) {
+        m_watcher->removePaths(watched);
+    }
+
+    QDir primitivesDir(m_basePath);
+    if (!primitivesDir.exists()) {
+        return;
+    }
+
+    QStringList paths;
+    paths << primitivesDir.absolutePath();
+    const QStringList subdirs = primitivesDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString &subdir : subdirs) {
+        paths << primitivesDir.absoluteFilePath(subdir);
+    }
+    m_watcher->addPaths(paths);
+}
+
+void ModelCatalog::onDirectoryChanged(const QString &path)
+{
+    Q_UNUSED(path);
+    m_rescanTimer->start();
+}
+
+QString ModelCatalog::modelPath(const QString &objectType)
+{
+    const QString key = objectType.toLower();
+    if (key.isEmpty()) {
+        ++m_misses;
+        return QString();
+    }
+
+    auto fileIt = m_files.constFind(key);
+    if (fileIt != m_files.constEnd()) {
+        ++m_hits;
+        return fileIt->path;
+    }
+
+    auto subdirIt = m_subdirModels.constFind(key);
+    if (subdirIt != m_subdirModels.constEnd()) {
+        ++m_hits;
+        return subdirIt->path;
+    }
+
+    // Potrivire partiala pe numele subdirectorului; rezultatul (inclusiv lipsa lui) e memorat
+    auto partialIt = m_partialMatches.constFind(key);
+    if (partialIt == m_partialMatches.constEnd()) {
+        QString found;
+        int bestPriority = -1;
+        for (auto it = m_subdirModels.constBegin(); it != m_subdirModels.constEnd(); ++it) {
+            if (it.key().contains(key) && (bestPriority < 0 || it->priority < bestPriority)) {
+                found = it->path;
+                bestPriority = it->priority;
+            }
+        }
+        partialIt = m_partialMatches.insert(key, found);
+    }
+
+    if (partialIt->isEmpty()) {
+        ++m_misses;
+        return QString();
+    }
+
+    ++m_hits;
+    return *partialIt;
+}
@@ -0,0 +1,69 @@
+#ifndef MODELCATALOG_H
+#define MODELCATALOG_H
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QFileSystemWatcher>
+#include <QTimer>
+
+// Index in memorie pentru Models/primitives.
+// Directorul este scanat o singura data, iar fiecare fisier de model este indexat
+// dupa numele de baza (lowercase), respectand ordinea de prioritate a extensiilor.
+// Indexul se reconstruieste automat prin QFileSystemWatcher cand continutul se schimba.
+class ModelCatalog : public QObject
+{
+    Q_OBJECT
+
+public:
+    static ModelCatalog *instance();
+
+    // Returneaza calea catre model sau un string gol daca tipul nu exista
+    QString modelPath(const QString &objectType);
+
+    // Reconstruieste indexul imediat (ex. dupa un import)
+    void rescan();
+
+    QString primitivesPath() const { return m_basePath; }
+    int modelCount() const { return m_files.size(); }
+    quint64 hits() const { return m_hits; }
+    quint64 misses() const { return m_misses; }
+
+    static const QStringList &supportedExtensions();
+
+signals:
+    void catalogChanged();
+
+private slots:
+    void onDirectoryChanged(const QString &path);
+
+private:
+    explicit ModelCatalog(QObject *parent = nullptr);
+
+    void indexDirectory(const QString &dirPath, bool isSubdir);
+    void updateWatchedPaths();
+    int extensionPriority(const QString &suffix) const;
+
+    QString m_basePath;
+
+    struct Entry {
+        QString path;
+        int priority;
+    };
+
+    // nume de baza (lowercase) -> cel mai prioritar fisier
+    QHash<QString, Entry> m_files;
+    // nume subdirector (lowercase) -> fisierul numit ca subdirectorul
+    QHash<QString, Entry> m_subdirModels;
+    // lookup-uri deja rezolvate prin potrivire partiala pe numele subdirectorului
+    QHash<QString, QString> m_partialMatches;
+
+    QFileSystemWatcher *m_watcher;
+    QTimer *m_rescanTimer;
+
+    quint64 m_hits;
+    quint64 m_misses;
+};
+
+#endif // MODELCATALOG_H
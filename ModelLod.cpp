@@ -0,0 +1,235 @@
+#include "ModelLod.h"
+#include "MeshCooker.h"
+#include "MeshData.h"
+#include "MeshSimplifier.h"
+#include "ModelCatalog.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMetaObject>
+#include <QRegularExpression>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QThreadPool>
+
+#if defined(Q_OS_WIN)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace {
+
+constexpr int MANIFEST_VERSION = 1;
+// Fractiunea de triunghiuri pastrata de fiecare nivel (dupa nivelul 0)
+const double LEVEL_RATIOS[ModelLod::MAX_LEVELS - 1] = { 0.5, 0.25, 0.1 };
+// Sub atatea triunghiuri un nivel nu mai merita generat
+constexpr int MIN_TRIANGLES = 64;
+// Un nivel trebuie sa aiba cel mult atat din triunghiurile nivelului anterior
+constexpr double MIN_REDUCTION = 0.8;
+
+QString lodDirectoryOf(const QString &modelPath)
+{
+    return QFileInfo(modelPath).path() + "/.lod/";
+}
+
+void generateAll(const QStringList &modelPaths, ModelCatalog *catalog)
+{
+    int generated = 0;
+    for (const QString &modelPath : modelPaths) {
+        if (ModelLod::generate(modelPath)) {
+            ++generated;
+        }
+    }
+    if (generated > 0) {
+        // Scenele deschise afla de nivelurile noi prin catalogChanged
+        QMetaObject::invokeMethod(catalog, [catalog]() { catalog->rescan(); }, Qt::QueuedConnection);
+    }
+}
+
+} // namespace
+
+QString ModelLod::levelPath(const QString &modelPath, int level)
+{
+    if (level <= 0) {
+        return modelPath;
+    }
+    return lodDirectoryOf(modelPath) + QFileInfo(modelPath).fileName() + QString(".lod%1.obj").arg(level);
+}
+
+QString ModelLod::manifestPath(const QString &modelPath)
+{
+    return lodDirectoryOf(modelPath) + QFileInfo(modelPath).fileName() + ".lod.json";
+}
+
+void ModelLod::makeLodDirectory(const QString &modelPath)
+{
+    const QString dirPath = lodDirectoryOf(modelPath);
+    if (QFileInfo::exists(dirPath)) {
+        return;
+    }
+    QDir().mkpath(dirPath);
+#if defined(Q_OS_WIN)
+    // Pe Windows punctul din nume nu ascunde directorul
+    const QString nativePath = QDir::toNativeSeparators(dirPath);
+    ::SetFileAttributesW(reinterpret_cast<LPCWSTR>(nativePath.utf16()), FILE_ATTRIBUTE_HIDDEN);
+#endif
+}
+
+bool ModelLod::isLodFile(const QString &fileName)
+{
+    static const QRegularExpression pattern("\\.lod(\\d+\\.obj|\\.json)$",
+                                            QRegularExpression::CaseInsensitiveOption);
+    return pattern.match(fileName).hasMatch();
+}
+
+bool ModelLod::canGenerate(const QString &modelPath)
+{
+    return ObjLoader::canLoad(modelPath) && !isLodFile(modelPath);
+}
+
+ModelLod::Info ModelLod::info(const QString &modelPath)
+{
+    Info result;
+
+    QFile file(manifestPath(modelPath));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return result;
+    }
+    const QJsonObject manifest = QJsonDocument::fromJson(file.readAll()).object();
+
+    const QFileInfo source(modelPath);
+    if (manifest.value("version").toInt() != MANIFEST_VERSION
+        || manifest.value("sourceSize").toInteger() != source.size()
+        || manifest.value("sourceModified").toInteger() != source.lastModified().toMSecsSinceEpoch()) {
+        return result;
+    }
+
+    const QJsonArray triangles = manifest.value("triangles").toArray();
+    for (int level = 0; level < triangles.size() && level < MAX_LEVELS; ++level) {
+        if (level > 0 && !QFileInfo::exists(levelPath(modelPath, level))) {
+            break;
+        }
+        result.triangles.append(triangles[level].toInt());
+    }
+    return result;
+}
+
+bool ModelLod::generate(const QString &modelPath)
+{
+    if (!canGenerate(modelPath)) {
+        return false;
+    }
+
+    MeshData source;
+    if (!ObjLoader::load(modelPath, source)) {
+        return false;
+    }
+    return generate(modelPath, source);
+}
+
+bool ModelLod::generate(const QString &modelPath, const MeshData &source)
+{
+    if (!canGenerate(modelPath) || source.isEmpty()) {
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Nivelurile vechi sunt sterse inainte, ca un model devenit mai simplu sa nu pastreze
+    // niveluri care nu mai corespund
+    removeLods(modelPath);
+    makeLodDirectory(modelPath);
+
+    QJsonArray triangles;
+    triangles.append(source.triangleCount());
+    int previous = source.triangleCount();
+    for (int level = 1; level < MAX_LEVELS; ++level) {
+        const int target = int(source.triangleCount() * LEVEL_RATIOS[level - 1]);
+        if (target < MIN_TRIANGLES) {
+            break;
+        }
+
+        const MeshSimplifier::Result result = MeshSimplifier::simplify(source, target);
+        if (result.mesh.triangleCount() > previous * MIN_REDUCTION
+            || !ObjWriter::save(levelPath(modelPath, level), result.mesh)) {
+            break;
+        }
+        // Nivelul are deja varfurile in memorie, deci este gatit pe loc
+        MeshCooker::cook(levelPath(modelPath, level), result.mesh);
+        triangles.append(result.mesh.triangleCount());
+        previous = result.mesh.triangleCount();
+    }
+
+    // Manifestul este scris chiar si fara niveluri, ca modelul sa nu ramana in asteptare
+    const QFileInfo info(modelPath);
+    QJsonObject manifest;
+    manifest["version"] = MANIFEST_VERSION;
+    manifest["sourceSize"] = info.size();
+    manifest["sourceModified"] = info.lastModified().toMSecsSinceEpoch();
+    manifest["triangles"] = triangles;
+
+    QSaveFile file(manifestPath(modelPath));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(QJsonDocument(manifest).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        return false;
+    }
+
+    qDebug() << "Generated" << triangles.size() - 1 << "LOD levels for" << modelPath << "triangles"
+             << triangles.toVariantList() << "in" << timer.elapsed() << "ms";
+    return true;
+}
+
+void ModelLod::removeLods(const QString &modelPath)
+{
+    for (int level = 1; level < MAX_LEVELS; ++level) {
+        QFile::remove(levelPath(modelPath, level));
+        MeshCooker::remove(levelPath(modelPath, level));
+    }
+    QFile::remove(manifestPath(modelPath));
+}
+
+QStringList ModelLod::pendingModels(const QString &dirPath)
+{
+    QStringList pending;
+    QDirIterator iterator(dirPath, QStringList() << "*.obj", QDir::Files, QDirIterator::Subdirectories);
+    while (iterator.hasNext()) {
+        const QString modelPath = iterator.next();
+        if (canGenerate(modelPath) && !info(modelPath).isValid()) {
+            pending.append(modelPath);
+        }
+    }
+    return pending;
+}
+
+void ModelLod::generateLibrary(const QString &dirPath)
+{
+    // Si cautarea modelelor (citirea manifestelor) ruleaza in fundal
+    ModelCatalog *catalog = ModelCatalog::instance();
+    queue()->start(QRunnable::create([dirPath, catalog]() {
+        generateAll(pendingModels(dirPath), catalog);
+    }));
+}
+
+QThreadPool *ModelLod::queue()
+{
+    static QThreadPool *pool = []() {
+        QThreadPool *threadPool = new QThreadPool(QCoreApplication::instance());
+        threadPool->setMaxThreadCount(1);
+        return threadPool;
+    }();
+    return pool;
+}
@@ -0,0 +1,71 @@
+#ifndef MODELLOD_H
+#define MODELLOD_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class QThreadPool;
+struct MeshData;
+
+// Triunghiurile obiectelor vizibile la ultima selectie a nivelurilor de detaliu
+struct LodStats {
+    qint64 fullDetailTriangles = 0; // daca toate ar fi desenate cu modelul original
+    qint64 drawnTriangles = 0;      // cu nivelurile alese
+    int objectsPerLevel[4] = { 0, 0, 0, 0 };
+    int objectsWithoutLod = 0;      // modele fara niveluri (alt format decat OBJ sau inca negenerate)
+};
+
+// Niveluri de detaliu pentru modelele din Models/primitives.
+// La import (AssetImporter) si la pornire, pentru modelele care nu le au inca, fiecare model
+// OBJ este simplificat cu MeshSimplifier in pana la trei versiuni, scrise intr-un director
+// ascuns langa original, ca arborele de modele sa nu le arate:
+//   <nume>.obj                nivelul 0 (originalul)
+//   .lod/<nume>.obj.lod1.obj  ~50% din triunghiuri
+//   .lod/<nume>.obj.lod2.obj  ~25%
+//   .lod/<nume>.obj.lod3.obj  ~10%
+// .lod/<nume>.obj.lod.json retine dimensiunea si mtime-ul sursei si numarul de triunghiuri al
+// fiecarui nivel; nivelurile sunt folosite doar cat timp acestea corespund originalului.
+// Numele complet (cu extensia) face ca un chair.fbx sa nu atinga fisierele lui chair.obj.
+class ModelLod
+{
+public:
+    static constexpr int MAX_LEVELS = 4; // inclusiv originalul
+
+    struct Info {
+        QVector<int> triangles; // indexat dupa nivel; gol daca modelul nu are niveluri valide
+
+        bool isValid() const { return !triangles.isEmpty(); }
+        int levelCount() const { return triangles.size(); }
+    };
+
+    // Nivelul 0 este chiar modelPath
+    static QString levelPath(const QString &modelPath, int level);
+    static QString manifestPath(const QString &modelPath);
+    // Creeaza directorul .lod/ al modelului (ascuns si pe Windows)
+    static void makeLodDirectory(const QString &modelPath);
+    // Fisierele generate (nivelurile si manifestul), ignorate de ModelCatalog
+    static bool isLodFile(const QString &fileName);
+    static bool canGenerate(const QString &modelPath);
+
+    // Citeste manifestul; Info invalid daca lipseste sau sursa s-a schimbat
+    static Info info(const QString &modelPath);
+    // Simplifica modelul si scrie nivelurile si manifestul (blocant)
+    static bool generate(const QString &modelPath);
+    // Acelasi lucru pentru un model deja citit (ex. de AssetImporter la validare)
+    static bool generate(const QString &modelPath, const MeshData &source);
+    static void removeLods(const QString &modelPath);
+
+    // Modelele dintr-un director (si subdirectoarele lui) fara niveluri valide
+    static QStringList pendingModels(const QString &dirPath);
+    // Genereaza in fundal nivelurile lipsa; catalogul este reindexat la final
+    static void generateLibrary(const QString &dirPath);
+
+    // Coada (un singur thread, in ordinea sosirii) pe care sunt scrise si sterse toate fisierele
+    // derivate din modele: niveluri de detaliu, manifeste si blob-uri gatite (MeshCooker).
+    // generateLibrary, MeshCooker::cookLibrary si AssetImporter nu pot astfel sterge sau
+    // suprascrie fisierele scrise de un alt job.
+    static QThreadPool *queue();
+};
+
+#endif // MODELLOD_H
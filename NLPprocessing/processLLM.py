@@ -2,6 +2,7 @@ import json
 from openai import OpenAI  # New import style
 from typing import Dict, List, Optional, Any
 from flask import Flask, request, jsonify
+from werkzeug.serving import WSGIRequestHandler
 from dataclasses import dataclass
 import logging
 from datetime import datetime
@@ -239,12 +240,17 @@ Extract ONLY what is explicitly mentioned. Do NOT add extra objects."""
             # Parse and validate response
             scene_data = self.parse_and_validate_response(api_result["response"])
 
-            # Save scene data to temp/scene_output.json
+            # Copy in temp/scene_output.json for inspection and batch rendering; the app no longer reads it
             self.save_scene_to_file(scene_data)
 
-            # Return only success status
+            # The client loads the scene straight from the response
             result = {
-                "success": True
+                "success": True,
+                "scene": {
+                    "objects": scene_data["objects"],
+                    "relations": scene_data["relations"],
+                    "animation_couples": scene_data.get("animation_couples", [])
+                }
             }
 
             logger.info(f"Scene processed: {len(scene_data['objects'])} objects, "
@@ -327,6 +333,9 @@ def process_scene_endpoint():
         # Process scene
         result = processor.process_scene(text, language)
 
+        if data.get("request_id"):
+            result["request_id"] = data["request_id"]
+
         if result["success"]:
             logger.info("200 - Success")
             return jsonify(result), 200
@@ -426,4 +435,6 @@ if __name__ == "__main__":
     print(f"Model: {processor.default_model}")
     print("="*50)
 
-    app.run(host="0.0.0.0", port=5000, debug=False)
\ No newline at end of file
+    # HTTP/1.1 keeps the client's connection open between requests
+    WSGIRequestHandler.protocol_version = "HTTP/1.1"
+    app.run(host="0.0.0.0", port=5000, debug=False, threaded=True)
\ No newline at end of file
@@ -0,0 +1,40 @@
+# Local stand-in for processLLM.py: answers POST /process with a canned scene, no OpenAI key needed.
+# Useful for exercising the app's NLP client (keep-alive, timeouts, cancellation, latency histogram).
+#   python stub_server.py [scene.json] [--delay SECONDS] [--port PORT]
+import argparse
+import json
+import os
+import time
+from flask import Flask, request, jsonify
+from werkzeug.serving import WSGIRequestHandler
+
+parser = argparse.ArgumentParser(description="Stub NLP server")
+parser.add_argument("scene", nargs="?",
+                    default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "temp", "scene_output.json"),
+                    help="scene JSON returned for every request")
+parser.add_argument("--delay", type=float, default=0.0, help="seconds to wait before answering")
+parser.add_argument("--port", type=int, default=5000)
+args = parser.parse_args()
+
+with open(args.scene, encoding="utf-8") as f:
+    scene = json.load(f)
+
+app = Flask(__name__)
+requests_served = 0
+
+@app.route('/process', methods=['POST'])
+def process():
+    global requests_served
+    data = request.get_json(force=True, silent=True) or {}
+    if not data.get("text", "").strip():
+        return jsonify({"error": "No text provided"}), 400
+
+    time.sleep(args.delay)
+    requests_served += 1
+    print(f"request {data.get('request_id')} ({requests_served} served), "
+          f"connection from port {request.environ.get('REMOTE_PORT')}")
+    return jsonify({"success": True, "scene": scene, "request_id": data.get("request_id")})
+
+if __name__ == "__main__":
+    WSGIRequestHandler.protocol_version = "HTTP/1.1"
+    app.run(host="127.0.0.1", port=args.port, threaded=True)
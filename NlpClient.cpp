@@ -0,0 +1,208 @@
+#include "NlpClient.h"
+#include <QJsonDocument>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QDebug>
+
+namespace {
+
+constexpr int DEFAULT_TIMEOUT_MS = 120000; // generarea cu LLM poate dura zeci de secunde
+const char REQUEST_ID_PROPERTY[] = "nlpRequestId";
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram()
+    : m_buckets(BUCKET_COUNT + 1, 0), m_count(0), m_total(0), m_minimum(0), m_maximum(0)
+{
+}
+
+qint64 LatencyHistogram::bucketUpperBound(int bucket)
+{
+    return qint64(1) << bucket;
+}
+
+void LatencyHistogram::record(qint64 milliseconds)
+{
+    int bucket = 0;
+    while (bucket < BUCKET_COUNT && milliseconds > bucketUpperBound(bucket)) {
+        ++bucket;
+    }
+    ++m_buckets[bucket];
+
+    m_minimum = m_count == 0 ? milliseconds : qMin(m_minimum, milliseconds);
+    m_maximum = qMax(m_maximum, milliseconds);
+    m_total += milliseconds;
+    ++m_count;
+}
+
+void LatencyHistogram::clear()
+{
+    m_buckets.fill(0);
+    m_count = 0;
+    m_total = 0;
+    m_minimum = 0;
+    m_maximum = 0;
+}
+
+qint64 LatencyHistogram::percentile(double fraction) const
+{
+    if (m_count == 0) {
+        return 0;
+    }
+
+    const int rank = qMax(1, int(fraction * m_count + 0.999999));
+    int seen = 0;
+    for (int bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+        seen += m_buckets[bucket];
+        if (seen >= rank) {
+            return qMin(bucketUpperBound(bucket), m_maximum);
+        }
+    }
+    return m_maximum; // galeata de depasire
+}
+
+QString LatencyHistogram::summary() const
+{
+    return QString("%1 requests, mean %2 ms, p50 <= %3 ms, p95 <= %4 ms, max %5 ms")
+        .arg(m_count)
+        .arg(qRound64(mean()))
+        .arg(percentile(0.5))
+        .arg(percentile(0.95))
+        .arg(m_maximum);
+}
+
+NlpClient::NlpClient(const QUrl &serverUrl, QObject *parent)
+    : QObject(parent), m_serverUrl(serverUrl), m_timeoutMs(DEFAULT_TIMEOUT_MS), m_nextRequestId(1)
+{
+    m_network = new QNetworkAccessManager(this);
+    warmUpConnection();
+}
+
+NlpClient::~NlpClient()
+{
+    // Destinatarii semnalelor pot fi deja distrusi (ex. fereastra parinte)
+    blockSignals(true);
+    cancelAll();
+}
+
+void NlpClient::setServerUrl(const QUrl &serverUrl)
+{
+    if (serverUrl == m_serverUrl) {
+        return;
+    }
+    m_serverUrl = serverUrl;
+    warmUpConnection();
+}
+
+void NlpClient::warmUpConnection()
+{
+    // Prima cerere nu mai plateste deschiderea conexiunii
+    if (m_serverUrl.scheme() == "https") {
+        m_network->connectToHostEncrypted(m_serverUrl.host(), quint16(m_serverUrl.port(443)));
+    } else {
+        m_network->connectToHost(m_serverUrl.host(), quint16(m_serverUrl.port(80)));
+    }
+}
+
+quint64 NlpClient::generateScene(const QString &text, const QString &language)
+{
+    const quint64 requestId = m_nextRequestId++;
+
+    QNetworkRequest request(m_serverUrl);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    request.setRawHeader("Connection", "keep-alive");
+    request.setRawHeader("X-Request-Id", QByteArray::number(requestId));
+    request.setTransferTimeout(m_timeoutMs);
+
+    QJsonObject json;
+    json["text"] = text;
+    json["lang"] = language;
+    json["request_id"] = QString::number(requestId);
+
+    PendingRequest pending;
+    pending.reply = m_network->post(request, QJsonDocument(json).toJson(QJsonDocument::Compact));
+    pending.reply->setProperty(REQUEST_ID_PROPERTY, requestId);
+    pending.timer.start();
+    pending.cancelled = false;
+    connect(pending.reply, &QNetworkReply::finished, this, &NlpClient::onReplyFinished);
+
+    m_pending.insert(requestId, pending);
+    qDebug() << "NLP request" << requestId << "sent to" << m_serverUrl.toString();
+    return requestId;
+}
+
+void NlpClient::cancel(quint64 requestId)
+{
+    auto it = m_pending.find(requestId);
+    if (it == m_pending.end()) {
+        return;
+    }
+    it->cancelled = true;
+    it->reply->abort(); // emite finished(), tratat in onReplyFinished
+}
+
+void NlpClient::cancelAll()
+{
+    const QList<quint64> requestIds = m_pending.keys();
+    for (quint64 requestId : requestIds) {
+        cancel(requestId);
+    }
+}
+
+void NlpClient::onReplyFinished()
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    if (!reply) {
+        return;
+    }
+    reply->deleteLater();
+
+    const quint64 requestId = reply->property(REQUEST_ID_PROPERTY).toULongLong();
+    auto it = m_pending.find(requestId);
+    if (it == m_pending.end()) {
+        return;
+    }
+    const PendingRequest pending = *it;
+    m_pending.erase(it);
+
+    const qint64 elapsedMs = pending.timer.elapsed();
+
+    if (pending.cancelled) {
+        qDebug() << "NLP request" << requestId << "cancelled after" << elapsedMs << "ms";
+        emit requestCancelled(requestId);
+        return;
+    }
+
+    // Fara cancel(), OperationCanceledError inseamna ca a expirat transferTimeout
+    if (reply->error() == QNetworkReply::OperationCanceledError || reply->error() == QNetworkReply::TimeoutError) {
+        emit requestFailed(requestId, tr("The NLP server did not answer within %1 s.").arg(m_timeoutMs / 1000));
+        return;
+    }
+
+    const QByteArray body = reply->readAll();
+    QJsonParseError parseError;
+    const QJsonObject response = QJsonDocument::fromJson(body, &parseError).object();
+
+    if (reply->error() != QNetworkReply::NoError) {
+        const QString serverError = response.value("error").toString();
+        emit requestFailed(requestId, serverError.isEmpty() ? reply->errorString() : serverError);
+        return;
+    }
+
+    if (parseError.error != QJsonParseError::NoError) {
+        emit requestFailed(requestId, tr("Invalid JSON from the NLP server: %1").arg(parseError.errorString()));
+        return;
+    }
+
+    // Serverul trimite scena in campul "scene"; un raspuns care este direct scena e acceptat si el
+    const QJsonObject scene = response.contains("scene") ? response.value("scene").toObject() : response;
+    if (!scene.contains("objects")) {
+        emit requestFailed(requestId, tr("The NLP server response does not contain a scene."));
+        return;
+    }
+
+    m_latency.record(elapsedMs);
+    qDebug() << "NLP request" << requestId << "finished in" << elapsedMs << "ms -" << m_latency.summary();
+    emit sceneReady(requestId, scene, elapsedMs);
+}
@@ -0,0 +1,99 @@
+#ifndef NLPCLIENT_H
+#define NLPCLIENT_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+#include <QUrl>
+#include <QVector>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+
+// Histograma latentelor cu BUCKET_COUNT galeti exponentiali: [0, 1] ms, (1, 2] ms, (2, 4] ms, ...
+// (2^16 ms, 2^17 ms] (~65 s, ~131 s, peste timeout-ul implicit de 120 s), apoi o galeata "peste".
+// Percentilele sunt aproximate prin limita superioara a galetii in care cad.
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+    void record(qint64 milliseconds);
+    void clear();
+
+    int count() const { return m_count; }
+    qint64 minimum() const { return m_count > 0 ? m_minimum : 0; }
+    qint64 maximum() const { return m_maximum; }
+    double mean() const { return m_count > 0 ? double(m_total) / m_count : 0.0; }
+    qint64 percentile(double fraction) const;
+
+    // ex. "12 requests, mean 840 ms, p50 <= 1024 ms, p95 <= 2048 ms, max 1730 ms"
+    QString summary() const;
+
+    static constexpr int BUCKET_COUNT = 18;
+    static qint64 bucketUpperBound(int bucket);
+
+private:
+    QVector<int> m_buckets;
+    int m_count;
+    qint64 m_total;
+    qint64 m_minimum;
+    qint64 m_maximum;
+};
+
+// Client asincron pentru serverul NLP (POST /process). Un singur QNetworkAccessManager traieste
+// cat aplicatia, deci conexiunea HTTP/1.1 este refolosita intre cereri (keep-alive) si deschisa
+// dinainte cu connectToHost. Fiecare cerere primeste un id; rezultatul vine prin semnale, cu
+// scena parsata in memorie. Cererile pot fi anulate si expira dupa timeout().
+class NlpClient : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit NlpClient(const QUrl &serverUrl, QObject *parent = nullptr);
+    ~NlpClient() override;
+
+    void setServerUrl(const QUrl &serverUrl);
+    QUrl serverUrl() const { return m_serverUrl; }
+    void setTimeout(int milliseconds) { m_timeoutMs = milliseconds; }
+    int timeout() const { return m_timeoutMs; }
+
+    // Intoarce id-ul cererii, folosit in semnale si la cancel()
+    quint64 generateScene(const QString &text, const QString &language);
+    void cancel(quint64 requestId);
+    void cancelAll();
+    int pendingCount() const { return m_pending.size(); }
+
+    // Latentele cererilor reusite de generare
+    const LatencyHistogram &latency() const { return m_latency; }
+
+    static QUrl defaultServerUrl() { return QUrl("http://127.0.0.1:5000/process"); }
+
+signals:
+    void sceneReady(quint64 requestId, const QJsonObject &scene, qint64 elapsedMs);
+    void requestFailed(quint64 requestId, const QString &error);
+    void requestCancelled(quint64 requestId);
+
+private slots:
+    void onReplyFinished();
+
+private:
+    struct PendingRequest {
+        QNetworkReply *reply;
+        QElapsedTimer timer;
+        bool cancelled;
+    };
+
+    void warmUpConnection();
+
+    QNetworkAccessManager *m_network;
+    QUrl m_serverUrl;
+    int m_timeoutMs;
+    quint64 m_nextRequestId;
+    QHash<quint64, PendingRequest> m_pending;
+    LatencyHistogram m_latency;
+};
+
+#endif // NLPCLIENT_H
@@ -0,0 +1,135 @@
+#include "OffscreenRenderer.h"
+#include <QEventLoop>
+#include <QOffscreenSurface>
+#include <QScopedPointer>
+#include <QSurfaceFormat>
+#include <QTimer>
+#include <Qt3DLogic/QLogicAspect>
+#include <Qt3DRender/QCameraSelector>
+#include <Qt3DRender/QFilterKey>
+#include <Qt3DRender/QRenderAspect>
+#include <Qt3DRender/QRenderSettings>
+#include <Qt3DRender/QRenderSurfaceSelector>
+#include <Qt3DRender/QRenderTarget>
+#include <Qt3DRender/QRenderTargetOutput>
+#include <Qt3DRender/QRenderTargetSelector>
+#include <Qt3DRender/QTechniqueFilter>
+#include <Qt3DRender/QTexture>
+#include <Qt3DRender/QViewport>
+#include <QDebug>
+
+namespace {
+
+Qt3DRender::QRenderTargetOutput *createOutput(Qt3DRender::QRenderTargetOutput::AttachmentPoint attachment,
+                                              Qt3DRender::QAbstractTexture::TextureFormat format,
+                                              const QSize &size, Qt3DCore::QNode *parent)
+{
+    Qt3DRender::QTexture2D *texture = new Qt3DRender::QTexture2D(parent);
+    texture->setSize(size.width(), size.height());
+    texture->setFormat(format);
+    texture->setGenerateMipMaps(false);
+    texture->setMinificationFilter(Qt3DRender::QAbstractTexture::Linear);
+    texture->setMagnificationFilter(Qt3DRender::QAbstractTexture::Linear);
+
+    Qt3DRender::QRenderTargetOutput *output = new Qt3DRender::QRenderTargetOutput(parent);
+    output->setAttachmentPoint(attachment);
+    output->setTexture(texture);
+    return output;
+}
+
+} // namespace
+
+OffscreenRenderer::OffscreenRenderer(const QSize &size, QObject *parent)
+    : QObject(parent), m_size(size)
+{
+    m_surface = new QOffscreenSurface();
+    m_surface->setFormat(QSurfaceFormat::defaultFormat());
+    m_surface->create();
+
+    // Aceleasi aspecte ca Qt3DWindow, fara input (nu exista fereastra care sa primeasca evenimente)
+    m_aspectEngine = new Qt3DCore::QAspectEngine();
+    m_aspectEngine->registerAspect(new Qt3DRender::QRenderAspect());
+    m_aspectEngine->registerAspect(new Qt3DLogic::QLogicAspect());
+
+    m_root = new Qt3DCore::QEntity();
+
+    m_camera = new Qt3DRender::QCamera(m_root);
+    m_camera->lens()->setPerspectiveProjection(45.0f, float(size.width()) / float(size.height()), 0.1f, 1000.0f);
+
+    // Frame graph: suprafata offscreen -> textura -> viewport -> clear -> camera -> captura
+    Qt3DRender::QRenderSurfaceSelector *surfaceSelector = new Qt3DRender::QRenderSurfaceSelector();
+    surfaceSelector->setSurface(m_surface);
+    surfaceSelector->setExternalRenderTargetSize(size);
+
+    Qt3DRender::QRenderTarget *renderTarget = new Qt3DRender::QRenderTarget(surfaceSelector);
+    renderTarget->addOutput(createOutput(Qt3DRender::QRenderTargetOutput::Color0,
+                                         Qt3DRender::QAbstractTexture::RGBA8_UNorm, size, renderTarget));
+    renderTarget->addOutput(createOutput(Qt3DRender::QRenderTargetOutput::Depth,
+                                         Qt3DRender::QAbstractTexture::D24, size, renderTarget));
+
+    Qt3DRender::QRenderTargetSelector *targetSelector = new Qt3DRender::QRenderTargetSelector(surfaceSelector);
+    targetSelector->setTarget(renderTarget);
+
+    Qt3DRender::QViewport *viewport = new Qt3DRender::QViewport(targetSelector);
+    viewport->setNormalizedRect(QRectF(0.0, 0.0, 1.0, 1.0));
+
+    m_clearBuffers = new Qt3DRender::QClearBuffers(viewport);
+    m_clearBuffers->setBuffers(Qt3DRender::QClearBuffers::ColorDepthBuffer);
+
+    Qt3DRender::QCameraSelector *cameraSelector = new Qt3DRender::QCameraSelector(m_clearBuffers);
+    cameraSelector->setCamera(m_camera);
+
+    // Materialele din Qt3DExtras au tehnici marcate renderingStyle=forward (ca in QForwardRenderer)
+    Qt3DRender::QTechniqueFilter *techniqueFilter = new Qt3DRender::QTechniqueFilter(cameraSelector);
+    Qt3DRender::QFilterKey *forwardKey = new Qt3DRender::QFilterKey(techniqueFilter);
+    forwardKey->setName(QStringLiteral("renderingStyle"));
+    forwardKey->setValue(QStringLiteral("forward"));
+    techniqueFilter->addMatch(forwardKey);
+
+    m_renderCapture = new Qt3DRender::QRenderCapture(techniqueFilter);
+
+    Qt3DRender::QRenderSettings *renderSettings = new Qt3DRender::QRenderSettings(m_root);
+    renderSettings->setActiveFrameGraph(surfaceSelector);
+    m_root->addComponent(renderSettings);
+
+    m_aspectEngine->setRootEntity(Qt3DCore::QEntityPtr(m_root));
+}
+
+OffscreenRenderer::~OffscreenRenderer()
+{
+    // Radacina este detinuta de QEntityPtr-ul din aspect engine
+    m_aspectEngine->setRootEntity(Qt3DCore::QEntityPtr());
+    delete m_aspectEngine;
+    delete m_surface;
+}
+
+void OffscreenRenderer::setRootEntity(Qt3DCore::QEntity *root)
+{
+    root->setParent(m_root);
+}
+
+void OffscreenRenderer::setClearColor(const QColor &color)
+{
+    m_clearBuffers->setClearColor(color);
+}
+
+QImage OffscreenRenderer::capture(int timeoutMs)
+{
+    QScopedPointer<Qt3DRender::QRenderCaptureReply> reply(m_renderCapture->requestCapture());
+
+    if (!reply->isComplete()) {
+        QEventLoop loop;
+        QTimer timeout;
+        timeout.setSingleShot(true);
+        connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+        connect(reply.data(), &Qt3DRender::QRenderCaptureReply::completed, &loop, &QEventLoop::quit);
+        timeout.start(timeoutMs);
+        loop.exec();
+    }
+
+    if (!reply->isComplete()) {
+        qDebug() << "Offscreen capture timed out after" << timeoutMs << "ms";
+        return QImage();
+    }
+    return reply->image();
+}
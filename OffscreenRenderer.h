@@ -0,0 +1,47 @@
+#ifndef OFFSCREENRENDERER_H
+#define OFFSCREENRENDERER_H
+
+#include <QColor>
+#include <QImage>
+#include <QObject>
+#include <QSize>
+
+#include <Qt3DCore/QAspectEngine>
+#include <Qt3DCore/QEntity>
+#include <Qt3DRender/QCamera>
+#include <Qt3DRender/QClearBuffers>
+#include <Qt3DRender/QRenderCapture>
+
+class QOffscreenSurface;
+
+// Inlocuitor pentru Qt3DWindow cand nu exista fereastra (ex. randare in lot pe un server).
+// Scena este desenata intr-o textura prin QOffscreenSurface, iar QRenderCapture citeste
+// imaginea inapoi. Merge si pe masini fara GPU (Mesa llvmpipe) cu QT_QPA_PLATFORM=offscreen.
+class OffscreenRenderer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit OffscreenRenderer(const QSize &size, QObject *parent = nullptr);
+    ~OffscreenRenderer() override;
+
+    // Scena devine copil al radacinii interne, ca in Qt3DWindow::setRootEntity
+    void setRootEntity(Qt3DCore::QEntity *root);
+    Qt3DRender::QCamera *camera() const { return m_camera; }
+    void setClearColor(const QColor &color);
+    QSize size() const { return m_size; }
+
+    // Urmatorul cadru randat, sau o imagine nula daca nu vine in timeoutMs
+    QImage capture(int timeoutMs);
+
+private:
+    QSize m_size;
+    QOffscreenSurface *m_surface;
+    Qt3DCore::QAspectEngine *m_aspectEngine;
+    Qt3DCore::QEntity *m_root;
+    Qt3DRender::QCamera *m_camera;
+    Qt3DRender::QClearBuffers *m_clearBuffers;
+    Qt3DRender::QRenderCapture *m_renderCapture;
+};
+
+#endif // OFFSCREENRENDERER_H
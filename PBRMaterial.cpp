@@ -1,67 +1,126 @@
 #include "PBRMaterial.h"
+#include "TextureBaker.h"
+#include "TextureLoader.h"
 #include <QCoreApplication>
 #include <QFileInfo>
 #include <QDebug>
 #include <QImage>
 #include <QUrl>
 #include <QDir>
-#include <QStandardPaths>
+#include <QDateTime>
+#include <QHash>
+#include <Qt3DRender/QFilterKey>
+
+const char *const TEXTURE_SUFFIXES[] = { "_diff", "_nor_gl", "_roughness", "_metallic" };
 
 QString findExistingTextureFile(const QString &basePath)
 {
     static QStringList extensions = { ".png", ".jpg", ".jpeg", ".exr" };
 
+    // Continutul directorului de texturi este listat o singura data si reimprospatat
+    // doar cand directorul se modifica, in loc de un QFileInfo::exists pe fiecare extensie
+    struct DirectoryIndex {
+        QDateTime lastModified;
+        QHash<QString, QString> files; // nume lowercase -> nume real
+    };
+    static QHash<QString, DirectoryIndex> indexes;
+
+    QFileInfo baseInfo(basePath);
+    const QString dirPath = baseInfo.absolutePath();
+    const QDateTime lastModified = QFileInfo(dirPath).lastModified();
+
+    DirectoryIndex &index = indexes[dirPath];
+    if (!index.lastModified.isValid() || index.lastModified != lastModified) {
+        index.lastModified = lastModified;
+        index.files.clear();
+        const QStringList fileNames = QDir(dirPath).entryList(QDir::Files);
+        for (const QString &fileName : fileNames) {
+            index.files.insert(fileName.toLower(), fileName);
+        }
+    }
+
     for (const QString &ext : extensions) {
-        QString candidate = basePath + ext;
-        if (QFileInfo::exists(candidate))
-            return candidate;
+        auto it = index.files.constFind((baseInfo.fileName() + ext).toLower());
+        if (it != index.files.constEnd())
+            return dirPath + "/" + it.value();
     }
     return QString(); // nimic gasit
 }
 
-PBRMaterial::PBRMaterial(Qt3DCore::QNode *parent, const QString &baseName, const QColor &albedoColor)
-    : Qt3DRender::QMaterial(parent)
+PBRMaterial::PBRMaterial(Qt3DCore::QNode *parent, const QString &baseName, const QColor &albedoColor,
+                         Qt3DRender::QEffect *sharedEffect, const QSharedPointer<QAtomicInt> &cancelToken)
+    : Qt3DRender::QMaterial(parent), m_cancelToken(cancelToken)
 {
     qDebug() << "Creating FIXED PBR Material for:" << baseName << "albedo:" << albedoColor.name();
 
-    auto *effect = new Qt3DRender::QEffect(this);
+    setEffect(sharedEffect ? sharedEffect : createEffect(this));
+
+    setupTextures(baseName, albedoColor);
+
+    qDebug() << "FIXED PBR Material created successfully";
+}
+
+Qt3DRender::QEffect *PBRMaterial::createEffect(Qt3DCore::QNode *parent)
+{
+    // Sursele shaderelor sunt citite de pe disc o singura data pentru tot procesul
+    static const QString shaderBase = QCoreApplication::applicationDirPath() + "/../../../";
+    static const QByteArray vertexCode =
+        Qt3DRender::QShaderProgram::loadSource(QUrl::fromLocalFile(shaderBase + "pbr.vert"));
+    static const QByteArray fragmentCode =
+        Qt3DRender::QShaderProgram::loadSource(QUrl::fromLocalFile(shaderBase + "pbr.frag"));
+
+    auto *effect = new Qt3DRender::QEffect(parent);
     auto *technique = new Qt3DRender::QTechnique(effect);
     technique->graphicsApiFilter()->setApi(Qt3DRender::QGraphicsApiFilter::OpenGL);
     technique->graphicsApiFilter()->setMajorVersion(3);
     technique->graphicsApiFilter()->setMinorVersion(3);
     technique->graphicsApiFilter()->setProfile(Qt3DRender::QGraphicsApiFilter::CoreProfile);
 
+    // QForwardRenderer selecteaza doar tehnicile marcate cu renderingStyle=forward
+    auto *filterKey = new Qt3DRender::QFilterKey(technique);
+    filterKey->setName(QStringLiteral("renderingStyle"));
+    filterKey->setValue(QStringLiteral("forward"));
+    technique->addFilterKey(filterKey);
+
     auto *renderPass = new Qt3DRender::QRenderPass(technique);
     auto *shader = new Qt3DRender::QShaderProgram(renderPass);
-    QString shaderBase = QCoreApplication::applicationDirPath() + "/../../../";
 
     qDebug() << "Loading shaders from:" << shaderBase;
-    shader->setVertexShaderCode(Qt3DRender::QShaderProgram::loadSource(QUrl::fromLocalFile(shaderBase + "pbr.vert")));
-    shader->setFragmentShaderCode(Qt3DRender::QShaderProgram::loadSource(QUrl::fromLocalFile(shaderBase + "pbr.frag")));
+    shader->setVertexShaderCode(vertexCode);
+    shader->setFragmentShaderCode(fragmentCode);
 
     renderPass->setShaderProgram(shader);
 
     technique->addRenderPass(renderPass);
     effect->addTechnique(technique);
-    setEffect(effect);
-
-    setupTextures(baseName, albedoColor);
 
-    // Simplified lighting (match your shader)
-    addParameter(new Qt3DRender::QParameter(QStringLiteral("lightPositions[0]"), QVector3D(0.0f, 10.0f, 10.0f)));
-    addParameter(new Qt3DRender::QParameter(QStringLiteral("lightColors[0]"), QVector3D(1.0f, 1.0f, 1.0f)));
-    addParameter(new Qt3DRender::QParameter(QStringLiteral("lightIntensity"), 100.0f));
-    addParameter(new Qt3DRender::QParameter(QStringLiteral("camPos"), QVector3D(0.0f, 15.0f, 30.0f)));
+    // Simplified lighting (match your shader) - comun tuturor materialelor care partajeaza efectul
+    effect->addParameter(new Qt3DRender::QParameter(QStringLiteral("lightPositions[0]"), QVector3D(0.0f, 10.0f, 10.0f)));
+    effect->addParameter(new Qt3DRender::QParameter(QStringLiteral("lightColors[0]"), QVector3D(1.0f, 1.0f, 1.0f)));
+    effect->addParameter(new Qt3DRender::QParameter(QStringLiteral("lightIntensity"), 100.0f));
+    effect->addParameter(new Qt3DRender::QParameter(QStringLiteral("camPos"), QVector3D(0.0f, 15.0f, 30.0f)));
 
-    qDebug() << "FIXED PBR Material created successfully";
+    return effect;
 }
 
 PBRMaterial::~PBRMaterial() = default;
 
+bool PBRMaterial::hasTextures(const QString &baseName)
+{
+    if (baseName.isEmpty()) {
+        return false;
+    }
+    for (const char *suffix : TEXTURE_SUFFIXES) {
+        if (!findExistingTextureFile(TextureBaker::texturesPath() + baseName + suffix).isEmpty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void PBRMaterial::setupTextures(const QString &baseName, const QColor &albedoColor)
 {
-    QString path = QCoreApplication::applicationDirPath() + "/../../../Models/Textures/";
-    QString base = path + baseName;
+    QString base = TextureBaker::texturesPath() + baseName;
 
     struct Tex { QString suffix, uniform; };
     QVector<Tex> texList = {
@@ -77,7 +136,7 @@ void PBRMaterial::setupTextures(const QString &baseName, const QColor &albedoCol
 
         SimpleTexture2D *texture = nullptr;
 
-        if (QFileInfo::exists(full)) {
+        if (!full.isEmpty()) {
             qDebug() << "Loading real texture:" << full;
             texture = loadOrPlaceholder(full, tex.uniform, albedoColor);
             loaded++;
@@ -103,97 +162,45 @@ void PBRMaterial::setupTextures(const QString &baseName, const QColor &albedoCol
 
 SimpleTexture2D* PBRMaterial::loadOrPlaceholder(const QString &filePath, const QString &uniformName, const QColor &albedoColor)
 {
-    auto *tex = new SimpleTexture2D(this);
-    Qt3DRender::QTextureImage *img = new Qt3DRender::QTextureImage(tex);
-
-    if (QFileInfo::exists(filePath)) {
-        qDebug() << "Loading texture file:" << filePath;
-        img->setSource(QUrl::fromLocalFile(filePath));
-        tex->addTextureImage(img);
-        return tex;
-    } else {
-        qDebug() << "Texture file not found:" << filePath;
-        delete tex;
-        return createDefaultTexture(uniformName, albedoColor);
-    }
+    // Obiectul se randeaza imediat cu placeholder-ul; imaginea reala este decodata
+    // pe un thread din TextureLoader si inlocuieste placeholder-ul cand e gata
+    auto *tex = new StreamedTexture2D(placeholderColor(uniformName, albedoColor), this);
+    qDebug() << "Queueing texture file:" << filePath;
+    TextureLoader::instance()->load(filePath, tex, m_cancelToken);
+    return tex;
 }
 
 SimpleTexture2D* PBRMaterial::createSolidColorTexture(const QColor &color)
 {
-    auto *tex = new SimpleTexture2D(this);
-
-    // Create a simple 1x1 color texture in memory (no file save)
-    QImage image(1, 1, QImage::Format_RGBA8888);
-    image.fill(color);
-
-    // Create a temporary file in system temp directory
-    QString tempDir = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
-    QDir().mkpath(tempDir);
-    QString tempFile = tempDir + QString("/pbr_color_%1_%2_%3.png")
-                                    .arg(color.red())
-                                    .arg(color.green())
-                                    .arg(color.blue());
-
-    if (image.save(tempFile)) {
-        Qt3DRender::QTextureImage *img = new Qt3DRender::QTextureImage(tex);
-        img->setSource(QUrl::fromLocalFile(tempFile));
-        tex->addTextureImage(img);
-        qDebug() << "Created color texture:" << tempFile;
-        return tex;
-    } else {
-        qDebug() << "Failed to save color texture";
-        delete tex;
-        return nullptr;
-    }
+    // Textura 4x4 creata direct in memorie, fara fisiere temporare
+    return new StreamedTexture2D(color, this);
 }
 
 SimpleTexture2D* PBRMaterial::createDefaultTexture(const QString &type, const QColor &albedoColor)
 {
-    auto *tex = new SimpleTexture2D(this);
+    return new StreamedTexture2D(placeholderColor(type, albedoColor), this);
+}
 
+QColor PBRMaterial::placeholderColor(const QString &type, const QColor &albedoColor)
+{
     // Create appropriate default based on texture type
-    QImage image(4, 4, QImage::Format_RGBA8888);
-
     if (type == "albedoMap") {
         // Use albedo color
-        image.fill(albedoColor);
-        qDebug() << "Creating albedo placeholder with color:" << albedoColor.name();
+        return albedoColor;
     }
     else if (type == "normalMap") {
         // Flat normal: RGB(128, 128, 255) = normal pointing up
-        image.fill(QColor(128, 128, 255, 255));
-        qDebug() << "Creating normal placeholder (flat)";
+        return QColor(128, 128, 255, 255);
     }
     else if (type == "roughnessMap") {
         // Medium roughness: RGB(128, 128, 128) = 0.5 roughness
-        image.fill(QColor(128, 128, 128, 255));
-        qDebug() << "Creating roughness placeholder (0.5)";
+        return QColor(128, 128, 128, 255);
     }
     else if (type == "metallicMap") {
         // Non-metallic: RGB(0, 0, 0) = 0.0 metallic
-        image.fill(QColor(0, 0, 0, 255));
-        qDebug() << "Creating metallic placeholder (0.0)";
+        return QColor(0, 0, 0, 255);
     }
-    else {
-        // Default: white
-        image.fill(QColor(255, 255, 255, 255));
-        qDebug() << "Creating default white placeholder";
-    }
-
-    // Save to temp directory
-    QString tempDir = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
-    QDir().mkpath(tempDir);
-    QString tempFile = tempDir + QString("/pbr_%1_default.png").arg(type);
 
-    if (image.save(tempFile)) {
-        Qt3DRender::QTextureImage *img = new Qt3DRender::QTextureImage(tex);
-        img->setSource(QUrl::fromLocalFile(tempFile));
-    tex->addTextureImage(img);
-        qDebug() << "Created default texture:" << tempFile;
-    return tex;
-    } else {
-        qDebug() << "Failed to save default texture for:" << type;
-        delete tex;
-        return nullptr;
-    }
+    // Default: white
+    return QColor(255, 255, 255, 255);
 }
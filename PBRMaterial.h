@@ -11,7 +11,9 @@
 #include <Qt3DRender/QRenderPass>
 #include <Qt3DRender/QShaderProgram>
 #include <Qt3DRender/QGraphicsApiFilter>
+#include <QAtomicInt>
 #include <QColor>
+#include <QSharedPointer>
 #include <QString>
 #include <Qt3DRender/QTextureWrapMode>
 #include <QVector3D>
@@ -34,16 +36,28 @@ class PBRMaterial : public Qt3DRender::QMaterial {
     Q_OBJECT
 
 public:
+    // Daca sharedEffect este dat, materialul il foloseste in loc sa-si compileze propriul efect.
+    // Texturile se decodeaza in fundal; cancelToken permite abandonarea lor (vezi TextureLoader).
     explicit PBRMaterial(Qt3DCore::QNode *parent = nullptr,
                          const QString &baseName = QString(),
-                         const QColor &albedoColor = QColor(128, 128, 128));
+                         const QColor &albedoColor = QColor(128, 128, 128),
+                         Qt3DRender::QEffect *sharedEffect = nullptr,
+                         const QSharedPointer<QAtomicInt> &cancelToken = QSharedPointer<QAtomicInt>());
     ~PBRMaterial();
 
+    // Efectul PBR (tehnica, render pass, shadere); sursele shaderelor sunt citite o singura data
+    static Qt3DRender::QEffect *createEffect(Qt3DCore::QNode *parent);
+    // baseName are cel putin una dintre hartile citite de setupTextures in Models/Textures
+    static bool hasTextures(const QString &baseName);
+
 private:
     void setupTextures(const QString &baseName, const QColor &albedoColor);
     SimpleTexture2D* loadOrPlaceholder(const QString &fullPath, const QString &uniformName, const QColor &albedoColor);
     SimpleTexture2D* createSolidColorTexture(const QColor &color);
     SimpleTexture2D* createDefaultTexture(const QString &type, const QColor &albedoColor);
+    static QColor placeholderColor(const QString &type, const QColor &albedoColor);
+
+    QSharedPointer<QAtomicInt> m_cancelToken;
 };
 
 #endif // PBRMATERIAL_H
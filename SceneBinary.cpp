@@ -0,0 +1,455 @@
+#include "SceneBinary.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QVector>
+#include <cstring>
+
+static_assert(sizeof(SceneBinary::Header) == 64, "Header layout");
+static_assert(sizeof(SceneBinary::StringEntry) == 8, "StringEntry layout");
+static_assert(sizeof(SceneBinary::ObjectRecord) == 24, "ObjectRecord layout");
+static_assert(sizeof(SceneBinary::RelationRecord) == 12, "RelationRecord layout");
+static_assert(sizeof(SceneBinary::CoupleRecord) == 16, "CoupleRecord layout");
+
+namespace {
+
+const QStringList SCHEMA_KEYS = { "objects", "relations", "animation_couples" };
+
+// Tabela de siruri deduplicate, construita la scriere
+class StringTable
+{
+public:
+    quint32 intern(const QString &value)
+    {
+        const QByteArray utf8 = value.toUtf8();
+        auto it = m_indices.constFind(utf8);
+        if (it != m_indices.constEnd()) {
+            return it.value();
+        }
+
+        SceneBinary::StringEntry entry;
+        entry.offset = quint32(m_data.size());
+        entry.length = quint32(utf8.size());
+        m_entries.append(entry);
+        m_data.append(utf8);
+
+        const quint32 index = quint32(m_entries.size() - 1);
+        m_indices.insert(utf8, index);
+        return index;
+    }
+
+    quint32 internValue(const QJsonValue &value)
+    {
+        return value.isString() ? intern(value.toString()) : SceneBinary::NO_STRING;
+    }
+
+    const QVector<SceneBinary::StringEntry> &entries() const { return m_entries; }
+    const QByteArray &data() const { return m_data; }
+
+private:
+    QHash<QByteArray, quint32> m_indices;
+    QVector<SceneBinary::StringEntry> m_entries;
+    QByteArray m_data;
+};
+
+template <typename T>
+quint32 appendRecords(QByteArray &out, const QVector<T> &records)
+{
+    while (out.size() % 4 != 0) {
+        out.append('\0');
+    }
+    const quint32 offset = quint32(out.size());
+    out.append(reinterpret_cast<const char *>(records.constData()), records.size() * int(sizeof(T)));
+    return offset;
+}
+
+} // namespace
+
+bool SceneBinary::isSceneBinary(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QByteArray magic = file.read(sizeof(MAGIC));
+    return magic.size() == int(sizeof(MAGIC)) && std::memcmp(magic.constData(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+QByteArray SceneBinary::fromJson(const QJsonObject &scene)
+{
+    StringTable strings;
+
+    QVector<ObjectRecord> objects;
+    QVector<quint32_le> animationRefs;
+    const QJsonArray objectsArray = scene.value("objects").toArray();
+    objects.reserve(objectsArray.size());
+    for (const QJsonValue &value : objectsArray) {
+        const QJsonObject obj = value.toObject();
+        const QJsonObject attributes = obj.value("attributes").toObject();
+
+        ObjectRecord record;
+        record.id = strings.internValue(obj.value("id"));
+        record.type = strings.internValue(obj.value("object"));
+        record.color = strings.internValue(attributes.value("color"));
+        record.size = strings.internValue(attributes.value("size"));
+        record.firstAnimation = NO_STRING;
+        record.animationCount = 0;
+
+        const QJsonValue animations = attributes.value("animations");
+        if (animations.isArray()) {
+            record.firstAnimation = quint32(animationRefs.size());
+            const QJsonArray animationsArray = animations.toArray();
+            for (const QJsonValue &animation : animationsArray) {
+                animationRefs.append(strings.intern(animation.toString()));
+            }
+            record.animationCount = quint32(animationsArray.size());
+        }
+        objects.append(record);
+    }
+
+    QVector<RelationRecord> relations;
+    const QJsonArray relationsArray = scene.value("relations").toArray();
+    relations.reserve(relationsArray.size());
+    for (const QJsonValue &value : relationsArray) {
+        const QJsonObject relationObj = value.toObject();
+        RelationRecord record;
+        record.object1 = strings.internValue(relationObj.value("object_1"));
+        record.relation = strings.internValue(relationObj.value("relation"));
+        record.object2 = strings.internValue(relationObj.value("object_2"));
+        relations.append(record);
+    }
+
+    QVector<CoupleRecord> couples;
+    const QJsonArray couplesArray = scene.value("animation_couples").toArray();
+    couples.reserve(couplesArray.size());
+    for (const QJsonValue &value : couplesArray) {
+        const QJsonObject couple = value.toObject();
+        CoupleRecord record;
+        record.primaryObject = strings.internValue(couple.value("primary_object"));
+        record.referenceObject = strings.internValue(couple.value("reference_object"));
+        record.animationType = strings.internValue(couple.value("animation_type"));
+        record.description = strings.internValue(couple.value("description"));
+        couples.append(record);
+    }
+
+    QJsonObject extras = scene;
+    for (const QString &key : SCHEMA_KEYS) {
+        extras.remove(key);
+    }
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.extras = extras.isEmpty()
+        ? NO_STRING
+        : strings.intern(QString::fromUtf8(QJsonDocument(extras).toJson(QJsonDocument::Compact)));
+
+    QByteArray out(sizeof(Header), '\0');
+    header.stringCount = quint32(strings.entries().size());
+    header.stringTableOffset = appendRecords(out, strings.entries());
+    header.objectCount = quint32(objects.size());
+    header.objectsOffset = appendRecords(out, objects);
+    header.animationRefCount = quint32(animationRefs.size());
+    header.animationRefsOffset = appendRecords(out, animationRefs);
+    header.relationCount = quint32(relations.size());
+    header.relationsOffset = appendRecords(out, relations);
+    header.coupleCount = quint32(couples.size());
+    header.couplesOffset = appendRecords(out, couples);
+    header.stringDataOffset = quint32(out.size());
+    header.stringDataSize = quint32(strings.data().size());
+    out.append(strings.data());
+
+    std::memcpy(out.data(), &header, sizeof(header));
+    return out;
+}
+
+bool SceneBinary::writeFile(const QJsonObject &scene, const QString &filePath, QString *errorString)
+{
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        if (errorString) {
+            *errorString = file.errorString();
+        }
+        return false;
+    }
+
+    file.write(fromJson(scene));
+    if (!file.commit()) {
+        if (errorString) {
+            *errorString = file.errorString();
+        }
+        return false;
+    }
+    return true;
+}
+
+SceneBinaryReader::SceneBinaryReader()
+    : m_data(nullptr), m_size(0)
+{
+}
+
+SceneBinaryReader::~SceneBinaryReader()
+{
+    if (m_data) {
+        m_file.unmap(const_cast<uchar *>(m_data));
+    }
+}
+
+bool SceneBinaryReader::fail(const QString &error)
+{
+    m_error = error;
+    if (m_data) {
+        m_file.unmap(const_cast<uchar *>(m_data));
+        m_data = nullptr;
+    }
+    m_size = 0;
+    return false;
+}
+
+bool SceneBinaryReader::open(const QString &filePath)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return fail(m_file.errorString());
+    }
+
+    m_size = m_file.size();
+    if (m_size < qint64(sizeof(SceneBinary::Header))) {
+        return fail("File is too small to be a binary scene");
+    }
+
+    m_data = m_file.map(0, m_size);
+    if (!m_data) {
+        return fail("Could not map file: " + m_file.errorString());
+    }
+
+    const SceneBinary::Header &h = header();
+    if (std::memcmp(h.magic, SceneBinary::MAGIC, sizeof(SceneBinary::MAGIC)) != 0) {
+        return fail("Not a binary scene file");
+    }
+    if (h.version != SceneBinary::VERSION) {
+        return fail(QString("Unsupported binary scene version %1").arg(quint32(h.version)));
+    }
+
+    // Toate sectiunile trebuie sa fie in interiorul fisierului inainte de a le citi direct
+    auto sectionFits = [this](quint32 offset, quint32 count, size_t recordSize) {
+        return offset % 4 == 0 && quint64(offset) + quint64(count) * recordSize <= quint64(m_size);
+    };
+    if (!sectionFits(h.stringTableOffset, h.stringCount, sizeof(SceneBinary::StringEntry))
+        || !sectionFits(h.objectsOffset, h.objectCount, sizeof(SceneBinary::ObjectRecord))
+        || !sectionFits(h.animationRefsOffset, h.animationRefCount, sizeof(quint32_le))
+        || !sectionFits(h.relationsOffset, h.relationCount, sizeof(SceneBinary::RelationRecord))
+        || !sectionFits(h.couplesOffset, h.coupleCount, sizeof(SceneBinary::CoupleRecord))
+        || quint64(h.stringDataOffset) + h.stringDataSize > quint64(m_size)) {
+        return fail("Corrupt binary scene: section out of bounds");
+    }
+
+    const SceneBinary::StringEntry *entries = records<SceneBinary::StringEntry>(h.stringTableOffset);
+    for (quint32 i = 0; i < h.stringCount; ++i) {
+        if (quint64(entries[i].offset) + entries[i].length > h.stringDataSize) {
+            return fail("Corrupt binary scene: string out of bounds");
+        }
+    }
+
+    const SceneBinary::ObjectRecord *objects = records<SceneBinary::ObjectRecord>(h.objectsOffset);
+    for (quint32 i = 0; i < h.objectCount; ++i) {
+        if (objects[i].firstAnimation != SceneBinary::NO_STRING
+            && quint64(objects[i].firstAnimation) + objects[i].animationCount > h.animationRefCount) {
+            return fail("Corrupt binary scene: animation list out of bounds");
+        }
+    }
+
+    qDebug() << "Mapped binary scene" << filePath << "(" << h.objectCount << "objects," << h.stringCount
+             << "strings ) in" << timer.elapsed() << "ms";
+    return true;
+}
+
+const SceneBinary::Header &SceneBinaryReader::header() const
+{
+    return *reinterpret_cast<const SceneBinary::Header *>(m_data);
+}
+
+const SceneBinary::ObjectRecord &SceneBinaryReader::object(int index) const
+{
+    return records<SceneBinary::ObjectRecord>(header().objectsOffset)[index];
+}
+
+const SceneBinary::RelationRecord &SceneBinaryReader::relation(int index) const
+{
+    return records<SceneBinary::RelationRecord>(header().relationsOffset)[index];
+}
+
+const SceneBinary::CoupleRecord &SceneBinaryReader::couple(int index) const
+{
+    return records<SceneBinary::CoupleRecord>(header().couplesOffset)[index];
+}
+
+QUtf8StringView SceneBinaryReader::animation(const SceneBinary::ObjectRecord &object, int index) const
+{
+    const quint32_le *refs = records<quint32_le>(header().animationRefsOffset);
+    return string(refs[object.firstAnimation + quint32(index)]);
+}
+
+QUtf8StringView SceneBinaryReader::string(quint32 index) const
+{
+    const SceneBinary::Header &h = header();
+    if (index >= h.stringCount) {
+        return QUtf8StringView();
+    }
+    const SceneBinary::StringEntry &entry = records<SceneBinary::StringEntry>(h.stringTableOffset)[index];
+    return QUtf8StringView(reinterpret_cast<const char *>(m_data + h.stringDataOffset + entry.offset),
+                           qsizetype(entry.length));
+}
+
+QJsonObject SceneBinaryReader::toJson() const
+{
+    if (!m_data) {
+        return QJsonObject();
+    }
+
+    const SceneBinary::Header &h = header();
+    QJsonObject scene;
+    if (h.extras != SceneBinary::NO_STRING) {
+        const QUtf8StringView extras = string(h.extras);
+        scene = QJsonDocument::fromJson(QByteArray::fromRawData(extras.data(), extras.size())).object();
+    }
+
+    // Sirurile sunt convertite o singura data, indiferent de cate ori sunt referite
+    QVector<QString> converted(int(h.stringCount));
+    for (quint32 i = 0; i < h.stringCount; ++i) {
+        const QUtf8StringView view = string(i);
+        converted[int(i)] = QString::fromUtf8(view.data(), view.size());
+    }
+    auto value = [&converted](quint32 index) -> QJsonValue {
+        return index < quint32(converted.size()) ? QJsonValue(converted[int(index)]) : QJsonValue();
+    };
+
+    QJsonArray objects;
+    for (int i = 0; i < objectCount(); ++i) {
+        const SceneBinary::ObjectRecord &record = object(i);
+
+        QJsonObject attributes;
+        attributes["color"] = value(record.color);
+        attributes["size"] = value(record.size);
+        if (record.firstAnimation == SceneBinary::NO_STRING) {
+            attributes["animations"] = QJsonValue();
+        } else {
+            const quint32_le *refs = records<quint32_le>(h.animationRefsOffset) + quint32(record.firstAnimation);
+            QJsonArray animations;
+            for (quint32 a = 0; a < record.animationCount; ++a) {
+                animations.append(value(refs[a]));
+            }
+            attributes["animations"] = animations;
+        }
+
+        QJsonObject obj;
+        obj["id"] = value(record.id);
+        obj["object"] = value(record.type);
+        obj["attributes"] = attributes;
+        objects.append(obj);
+    }
+
+    QJsonArray relations;
+    for (int i = 0; i < relationCount(); ++i) {
+        const SceneBinary::RelationRecord &record = relation(i);
+        QJsonObject relationObj;
+        relationObj["object_1"] = value(record.object1);
+        relationObj["relation"] = value(record.relation);
+        relationObj["object_2"] = value(record.object2);
+        relations.append(relationObj);
+    }
+
+    QJsonArray couples;
+    for (int i = 0; i < coupleCount(); ++i) {
+        const SceneBinary::CoupleRecord &record = couple(i);
+        QJsonObject coupleObj;
+        coupleObj["primary_object"] = value(record.primaryObject);
+        coupleObj["reference_object"] = value(record.referenceObject);
+        coupleObj["animation_type"] = value(record.animationType);
+        coupleObj["description"] = value(record.description);
+        couples.append(coupleObj);
+    }
+
+    scene["objects"] = objects;
+    scene["relations"] = relations;
+    scene["animation_couples"] = couples;
+    return scene;
+}
+
+void SceneBinaryReader::toDescription(SceneDescription &scene) const
+{
+    scene.clear();
+    if (!m_data) {
+        return;
+    }
+
+    const SceneBinary::Header &h = header();
+    if (h.extras != SceneBinary::NO_STRING) {
+        const QUtf8StringView extras = string(h.extras);
+        const QJsonObject extrasObject =
+            QJsonDocument::fromJson(QByteArray::fromRawData(extras.data(), extras.size())).object();
+        for (auto it = extrasObject.constBegin(); it != extrasObject.constEnd(); ++it) {
+            if (it.value().isString()) {
+                scene.metadata.insert(it.key(), it.value().toString());
+            }
+        }
+    }
+
+    // Tabela de siruri este deja deduplicata, deci indexul joaca rolul internarii
+    QVector<QString> converted(int(h.stringCount));
+    for (quint32 i = 0; i < h.stringCount; ++i) {
+        const QUtf8StringView view = string(i);
+        converted[int(i)] = QString::fromUtf8(view.data(), view.size());
+    }
+    auto value = [&converted](quint32 index) {
+        return index < quint32(converted.size()) ? converted[int(index)] : QString();
+    };
+
+    scene.objects.reserve(objectCount());
+    const quint32_le *refs = records<quint32_le>(h.animationRefsOffset);
+    for (int i = 0; i < objectCount(); ++i) {
+        const SceneBinary::ObjectRecord &record = object(i);
+
+        SceneObjectDescription obj;
+        obj.id = value(record.id);
+        obj.type = value(record.type);
+        obj.color = value(record.color);
+        obj.hasColor = record.color != SceneBinary::NO_STRING;
+        obj.size = value(record.size);
+        if (record.firstAnimation != SceneBinary::NO_STRING) {
+            obj.animations.reserve(int(record.animationCount));
+            for (quint32 a = 0; a < record.animationCount; ++a) {
+                obj.animations.append(value(refs[record.firstAnimation + a]));
+            }
+        }
+        scene.objects.append(obj);
+    }
+
+    scene.relations.reserve(relationCount());
+    for (int i = 0; i < relationCount(); ++i) {
+        const SceneBinary::RelationRecord &record = relation(i);
+        SceneRelationDescription relationDesc;
+        relationDesc.object1 = value(record.object1);
+        relationDesc.relation = value(record.relation);
+        relationDesc.object2 = value(record.object2);
+        scene.relations.append(relationDesc);
+    }
+
+    scene.animationCouples.reserve(coupleCount());
+    for (int i = 0; i < coupleCount(); ++i) {
+        const SceneBinary::CoupleRecord &record = couple(i);
+        AnimationCoupleDescription coupleDesc;
+        coupleDesc.primaryObject = value(record.primaryObject);
+        coupleDesc.referenceObject = value(record.referenceObject);
+        coupleDesc.animationType = value(record.animationType);
+        coupleDesc.description = value(record.description);
+        scene.animationCouples.append(coupleDesc);
+    }
+}
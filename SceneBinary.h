@@ -0,0 +1,118 @@
+#ifndef SCENEBINARY_H
+#define SCENEBINARY_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QJsonObject>
+#include <QString>
+#include <QUtf8StringView>
+#include <QtEndian>
+
+#include "SceneDescription.h"
+
+// Format binar pentru scene (.scnb), echivalent cu schema JSON:
+//   antet | tabela de siruri | obiecte | referinte de animatii | relatii | cupluri de animatie | date siruri
+// Toate sirurile sunt deduplicate in tabela si referite prin index. Inregistrarile au
+// dimensiune fixa si sunt citite direct din fisierul mapat in memorie (QFile::map),
+// fara copii: sirurile sunt expuse ca QUtf8StringView in zona mapata.
+namespace SceneBinary {
+
+constexpr char MAGIC[4] = { 'S', 'C', 'N', 'B' };
+constexpr quint32 VERSION = 1;
+constexpr quint32 NO_STRING = 0xFFFFFFFFu;
+
+struct Header {
+    char magic[4];
+    quint32_le version;
+    quint32_le stringCount;
+    quint32_le stringTableOffset;
+    quint32_le stringDataOffset;
+    quint32_le stringDataSize;
+    quint32_le objectCount;
+    quint32_le objectsOffset;
+    quint32_le animationRefCount;
+    quint32_le animationRefsOffset;
+    quint32_le relationCount;
+    quint32_le relationsOffset;
+    quint32_le coupleCount;
+    quint32_le couplesOffset;
+    // Campurile de nivel superior din afara schemei (user_input, saved_timestamp, ...)
+    // pastrate ca JSON compact, ca sa nu se piarda la conversie
+    quint32_le extras;
+    quint32_le reserved;
+};
+
+struct StringEntry {
+    quint32_le offset; // relativ la stringDataOffset
+    quint32_le length; // octeti UTF-8
+};
+
+struct ObjectRecord {
+    quint32_le id;
+    quint32_le type;
+    quint32_le color;
+    quint32_le size;
+    quint32_le firstAnimation; // NO_STRING cand "animations" lipseste sau este null
+    quint32_le animationCount;
+};
+
+struct RelationRecord {
+    quint32_le object1;
+    quint32_le relation;
+    quint32_le object2;
+};
+
+struct CoupleRecord {
+    quint32_le primaryObject;
+    quint32_le referenceObject;
+    quint32_le animationType;
+    quint32_le description;
+};
+
+bool isSceneBinary(const QString &filePath);
+
+// Conversii intre schema JSON existenta si formatul binar
+QByteArray fromJson(const QJsonObject &scene);
+bool writeFile(const QJsonObject &scene, const QString &filePath, QString *errorString = nullptr);
+
+} // namespace SceneBinary
+
+// Cititor pentru fisierele .scnb; fisierul ramane mapat cat timp cititorul exista
+class SceneBinaryReader
+{
+public:
+    SceneBinaryReader();
+    ~SceneBinaryReader();
+
+    bool open(const QString &filePath);
+    QString errorString() const { return m_error; }
+
+    int objectCount() const { return int(header().objectCount); }
+    int relationCount() const { return int(header().relationCount); }
+    int coupleCount() const { return int(header().coupleCount); }
+
+    const SceneBinary::ObjectRecord &object(int index) const;
+    const SceneBinary::RelationRecord &relation(int index) const;
+    const SceneBinary::CoupleRecord &couple(int index) const;
+    QUtf8StringView animation(const SceneBinary::ObjectRecord &object, int index) const;
+
+    // Sirul cu indexul dat, direct din zona mapata; gol pentru NO_STRING
+    QUtf8StringView string(quint32 index) const;
+
+    QJsonObject toJson() const;
+    // Descrierea scenei direct din inregistrari; fiecare sir din tabela este convertit o singura data
+    void toDescription(SceneDescription &scene) const;
+
+private:
+    const SceneBinary::Header &header() const;
+    template <typename T>
+    const T *records(quint32 offset) const { return reinterpret_cast<const T *>(m_data + offset); }
+    bool fail(const QString &error);
+
+    QFile m_file;
+    const uchar *m_data;
+    qint64 m_size;
+    QString m_error;
+};
+
+#endif // SCENEBINARY_H
@@ -0,0 +1,97 @@
+#include "SceneDescription.h"
+#include <QJsonArray>
+#include <QJsonValue>
+
+void SceneDescription::clear()
+{
+    objects.clear();
+    relations.clear();
+    animationCouples.clear();
+    metadata.clear();
+}
+
+QString StringInterner::intern(const QString &value)
+{
+    auto it = m_pool.constFind(value);
+    if (it != m_pool.constEnd()) {
+        return *it;
+    }
+    m_pool.insert(value);
+    return value;
+}
+
+bool SceneDescription::fromJson(const QJsonObject &jsonObject, SceneDescription &scene, QString *errorString)
+{
+    auto fail = [errorString](const QString &error) {
+        if (errorString) {
+            *errorString = error;
+        }
+        return false;
+    };
+
+    // Verifica structura obligatorie
+    if (!jsonObject.value("objects").isArray()) {
+        return fail("Missing or invalid 'objects' array");
+    }
+    if (!jsonObject.value("relations").isArray()) {
+        return fail("Missing or invalid 'relations' array");
+    }
+
+    scene.clear();
+    StringInterner strings;
+
+    const QJsonArray objects = jsonObject.value("objects").toArray();
+    scene.objects.reserve(objects.size());
+    for (const QJsonValue &value : objects) {
+        const QJsonObject obj = value.toObject();
+        if (!obj.value("object").isString() || !obj.value("id").isString()) {
+            return fail("Object missing required fields (object, id)");
+        }
+
+        const QJsonObject attributes = obj.value("attributes").toObject();
+
+        SceneObjectDescription object;
+        object.id = obj.value("id").toString();
+        object.type = strings.intern(obj.value("object").toString());
+        object.hasColor = attributes.value("color").isString();
+        object.color = strings.intern(attributes.value("color").toString());
+        object.size = strings.intern(attributes.value("size").toString());
+
+        // "animations" poate fi null
+        const QJsonArray animations = attributes.value("animations").toArray();
+        for (const QJsonValue &animation : animations) {
+            object.animations.append(strings.intern(animation.toString()));
+        }
+        scene.objects.append(object);
+    }
+
+    const QJsonArray relations = jsonObject.value("relations").toArray();
+    scene.relations.reserve(relations.size());
+    for (const QJsonValue &value : relations) {
+        const QJsonObject relationObj = value.toObject();
+        SceneRelationDescription relation;
+        relation.object1 = relationObj.value("object_1").toString();
+        relation.relation = strings.intern(relationObj.value("relation").toString());
+        relation.object2 = relationObj.value("object_2").toString();
+        scene.relations.append(relation);
+    }
+
+    const QJsonArray couples = jsonObject.value("animation_couples").toArray();
+    scene.animationCouples.reserve(couples.size());
+    for (const QJsonValue &value : couples) {
+        const QJsonObject coupleObj = value.toObject();
+        AnimationCoupleDescription couple;
+        couple.primaryObject = coupleObj.value("primary_object").toString();
+        couple.referenceObject = coupleObj.value("reference_object").toString();
+        couple.animationType = strings.intern(coupleObj.value("animation_type").toString());
+        couple.description = coupleObj.value("description").toString();
+        scene.animationCouples.append(couple);
+    }
+
+    for (auto it = jsonObject.constBegin(); it != jsonObject.constEnd(); ++it) {
+        if (it.value().isString()) {
+            scene.metadata.insert(it.key(), it.value().toString());
+        }
+    }
+    return true;
+}
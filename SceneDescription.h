@@ -0,0 +1,61 @@
+#ifndef SCENEDESCRIPTION_H
+#define SCENEDESCRIPTION_H
+
+#include <QHash>
+#include <QJsonObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// Descrierea unei scene, asa cum vine din JSON sau din formatul binar, in structuri plate.
+// Tipul, culoarea, dimensiunea, relatiile si numele animatiilor sunt internate: valorile
+// egale impart acelasi QString, deci o scena cu mii de obiecte "cube"/"red" nu duplica sirurile.
+struct SceneObjectDescription {
+    QString id;
+    QString type;
+    QString color;
+    QString size;
+    QStringList animations;
+    bool hasColor = false; // "color" lipseste sau nu este sir -> culoarea implicita
+};
+
+struct SceneRelationDescription {
+    QString object1;
+    QString relation;
+    QString object2;
+};
+
+struct AnimationCoupleDescription {
+    QString primaryObject;
+    QString referenceObject;
+    QString animationType;
+    QString description;
+};
+
+struct SceneDescription {
+    QVector<SceneObjectDescription> objects;
+    QVector<SceneRelationDescription> relations;
+    QVector<AnimationCoupleDescription> animationCouples;
+    // Campurile sir de nivel superior din afara schemei (user_input, saved_timestamp, ...)
+    QHash<QString, QString> metadata;
+
+    bool isEmpty() const { return objects.isEmpty(); }
+    void clear();
+
+    // Conversie dintr-un QJsonObject deja parsat, cu aceleasi reguli de schema ca parserul
+    static bool fromJson(const QJsonObject &jsonObject, SceneDescription &scene, QString *errorString = nullptr);
+};
+
+// Pool de siruri pentru internare
+class StringInterner
+{
+public:
+    QString intern(const QString &value);
+    void clear() { m_pool.clear(); }
+
+private:
+    QSet<QString> m_pool;
+};
+
+#endif // SCENEDESCRIPTION_H
@@ -0,0 +1,561 @@
+#include "SceneJsonParser.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+
+namespace {
+
+void appendUtf8(QByteArray &out, uint codePoint)
+{
+    if (codePoint < 0x80) {
+        out.append(char(codePoint));
+    } else if (codePoint < 0x800) {
+        out.append(char(0xC0 | (codePoint >> 6)));
+        out.append(char(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        out.append(char(0xE0 | (codePoint >> 12)));
+        out.append(char(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.append(char(0x80 | (codePoint & 0x3F)));
+    } else {
+        out.append(char(0xF0 | (codePoint >> 18)));
+        out.append(char(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.append(char(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.append(char(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+int hexValue(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+} // namespace
+
+SceneJsonParser::SceneJsonParser()
+    : m_device(nullptr), m_pos(0), m_bytesParsed(0), m_elapsedNs(0), m_line(1), m_column(1)
+{
+}
+
+bool SceneJsonParser::parseFile(const QString &filePath, SceneDescription &scene)
+{
+    QFile file(filePath);
+    if (!file.exists()) {
+        m_error = "JSON file not found: " + filePath;
+        return false;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        m_error = "Could not open JSON file: " + filePath;
+        return false;
+    }
+    return parse(&file, scene);
+}
+
+bool SceneJsonParser::parse(QIODevice *device, SceneDescription &scene)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    m_device = device;
+    m_buffer.clear();
+    m_pos = 0;
+    m_bytesParsed = 0;
+    m_line = 1;
+    m_column = 1;
+    m_error.clear();
+    m_strings.clear();
+    scene.clear();
+
+    const bool ok = parseRoot(scene);
+
+    m_elapsedNs = timer.nsecsElapsed();
+    m_device = nullptr;
+    m_strings.clear();
+
+    if (ok) {
+        qDebug() << "Parsed scene:" << scene.objects.size() << "objects," << scene.relations.size() << "relations,"
+                 << m_bytesParsed << "bytes in" << m_elapsedNs / 1000 << "us (" << throughputMBps() << "MB/s )";
+    } else {
+        scene.clear();
+    }
+    return ok;
+}
+
+double SceneJsonParser::throughputMBps() const
+{
+    if (m_elapsedNs <= 0) {
+        return 0.0;
+    }
+    return (double(m_bytesParsed) / (1024.0 * 1024.0)) / (double(m_elapsedNs) / 1e9);
+}
+
+bool SceneJsonParser::fail(const QString &error)
+{
+    if (m_error.isEmpty()) {
+        m_error = QString("%1 at line %2, column %3").arg(error).arg(m_line).arg(m_column);
+    }
+    return false;
+}
+
+bool SceneJsonParser::fill()
+{
+    m_buffer.resize(CHUNK_SIZE);
+    const qint64 count = m_device->read(m_buffer.data(), CHUNK_SIZE);
+    m_buffer.resize(int(qMax<qint64>(0, count)));
+    m_pos = 0;
+    if (count > 0) {
+        m_bytesParsed += count;
+    }
+    return count > 0;
+}
+
+bool SceneJsonParser::atEnd()
+{
+    return m_pos >= m_buffer.size() && !fill();
+}
+
+char SceneJsonParser::peek()
+{
+    return atEnd() ? '\0' : m_buffer.at(m_pos);
+}
+
+char SceneJsonParser::get()
+{
+    if (atEnd()) {
+        return '\0';
+    }
+    const char c = m_buffer.at(m_pos++);
+    if (c == '\n') {
+        ++m_line;
+        m_column = 1;
+    } else {
+        ++m_column;
+    }
+    return c;
+}
+
+void SceneJsonParser::skipWhitespace()
+{
+    while (!atEnd()) {
+        const char c = m_buffer.at(m_pos);
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+            return;
+        }
+        get();
+    }
+}
+
+bool SceneJsonParser::expect(char c)
+{
+    skipWhitespace();
+    if (peek() != c) {
+        return fail(QString("Expected '%1'").arg(c));
+    }
+    get();
+    return true;
+}
+
+bool SceneJsonParser::readString(QString &value)
+{
+    skipWhitespace();
+    if (peek() != '"') {
+        return fail("Expected string");
+    }
+    get();
+
+    m_token.clear();
+    while (true) {
+        // Copiem dintr-o data secventele fara escape-uri din bufferul curent
+        const int start = m_pos;
+        while (m_pos < m_buffer.size()) {
+            const char c = m_buffer.at(m_pos);
+            if (c == '"' || c == '\\' || uchar(c) < 0x20) {
+                break;
+            }
+            ++m_pos;
+        }
+        m_token.append(m_buffer.constData() + start, m_pos - start);
+        m_column += m_pos - start;
+
+        if (atEnd()) {
+            return fail("Unterminated string");
+        }
+
+        // Sirul continua in bucata urmatoare a fisierului
+        const char next = m_buffer.at(m_pos);
+        if (next != '"' && next != '\\' && uchar(next) >= 0x20) {
+            continue;
+        }
+
+        const char c = get();
+        if (c == '"') {
+            break;
+        }
+        if (c != '\\') {
+            return fail("Control character in string");
+        }
+
+        const char escape = get();
+        switch (escape) {
+        case '"': m_token.append('"'); break;
+        case '\\': m_token.append('\\'); break;
+        case '/': m_token.append('/'); break;
+        case 'b': m_token.append('\b'); break;
+        case 'f': m_token.append('\f'); break;
+        case 'n': m_token.append('\n'); break;
+        case 'r': m_token.append('\r'); break;
+        case 't': m_token.append('\t'); break;
+        case 'u': {
+            auto readHex4 = [this](uint &unit) {
+                unit = 0;
+                for (int i = 0; i < 4; ++i) {
+                    const int digit = hexValue(get());
+                    if (digit < 0) {
+                        return false;
+                    }
+                    unit = (unit << 4) | uint(digit);
+                }
+                return true;
+            };
+
+            uint codePoint;
+            if (!readHex4(codePoint)) {
+                return fail("Invalid \\u escape");
+            }
+            if (codePoint >= 0xD800 && codePoint < 0xDC00) {
+                uint low;
+                if (get() != '\\' || get() != 'u' || !readHex4(low) || low < 0xDC00 || low > 0xDFFF) {
+                    return fail("Invalid surrogate pair");
+                }
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+            }
+            appendUtf8(m_token, codePoint);
+            break;
+        }
+        default:
+            return fail("Invalid escape sequence");
+        }
+    }
+
+    value = QString::fromUtf8(m_token);
+    return true;
+}
+
+bool SceneJsonParser::readStringOrNull(QString &value, bool &isString)
+{
+    skipWhitespace();
+    isString = peek() == '"';
+    if (isString) {
+        return readString(value);
+    }
+    // Valorile de alt tip sunt tratate ca lipsa, ca in QJsonValue::toString()
+    value.clear();
+    return skipValue();
+}
+
+bool SceneJsonParser::skipLiteral()
+{
+    skipWhitespace();
+    int length = 0;
+    while (!atEnd()) {
+        const char c = m_buffer.at(m_pos);
+        const bool literalChar = (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')
+                                 || c == '-' || c == '+' || c == '.' || c == 'E';
+        if (!literalChar) {
+            break;
+        }
+        get();
+        ++length;
+    }
+    return length > 0 || fail("Unexpected character");
+}
+
+bool SceneJsonParser::skipValue()
+{
+    skipWhitespace();
+    const char first = peek();
+    if (first == '"') {
+        QString ignored;
+        return readString(ignored);
+    }
+    if (first != '{' && first != '[') {
+        return skipLiteral();
+    }
+
+    // Valorile compuse necunoscute sunt sarite fara recursie
+    QByteArray stack;
+    do {
+        skipWhitespace();
+        const char c = peek();
+        if (c == '"') {
+            QString ignored;
+            if (!readString(ignored)) {
+                return false;
+            }
+        } else if (c == '{' || c == '[') {
+            stack.append(c == '{' ? '}' : ']');
+            get();
+        } else if (c == '}' || c == ']') {
+            if (stack.isEmpty() || stack.back() != c) {
+                return fail("Mismatched bracket");
+            }
+            stack.chop(1);
+            get();
+        } else if (c == ',' || c == ':') {
+            get();
+        } else if (!skipLiteral()) {
+            return false;
+        }
+    } while (!stack.isEmpty());
+    return true;
+}
+
+template <typename Callback>
+bool SceneJsonParser::parseObjectMembers(Callback onMember)
+{
+    if (!expect('{')) {
+        return false;
+    }
+    skipWhitespace();
+    if (peek() == '}') {
+        get();
+        return true;
+    }
+
+    while (true) {
+        QString ignored;
+        skipWhitespace();
+        if (peek() != '"') {
+            return fail("Expected property name");
+        }
+        if (!readString(ignored)) {
+            return false;
+        }
+        const QByteArray key = m_token;
+        if (!expect(':') || !onMember(key)) {
+            return false;
+        }
+
+        skipWhitespace();
+        const char c = get();
+        if (c == '}') {
+            return true;
+        }
+        if (c != ',') {
+            return fail("Expected ',' or '}'");
+        }
+    }
+}
+
+template <typename Callback>
+bool SceneJsonParser::parseArrayElements(Callback onElement)
+{
+    if (!expect('[')) {
+        return false;
+    }
+    skipWhitespace();
+    if (peek() == ']') {
+        get();
+        return true;
+    }
+
+    while (true) {
+        if (!onElement()) {
+            return false;
+        }
+
+        skipWhitespace();
+        const char c = get();
+        if (c == ']') {
+            return true;
+        }
+        if (c != ',') {
+            return fail("Expected ',' or ']'");
+        }
+    }
+}
+
+bool SceneJsonParser::parseRoot(SceneDescription &scene)
+{
+    bool hasObjects = false;
+    bool hasRelations = false;
+
+    const bool ok = parseObjectMembers([&](const QByteArray &key) {
+        skipWhitespace();
+        if (key == "objects") {
+            if (peek() != '[') {
+                return fail("Missing or invalid 'objects' array");
+            }
+            hasObjects = true;
+            return parseArrayElements([&]() { return parseSceneObject(scene); });
+        }
+        if (key == "relations") {
+            if (peek() != '[') {
+                return fail("Missing or invalid 'relations' array");
+            }
+            hasRelations = true;
+            return parseArrayElements([&]() { return parseRelation(scene); });
+        }
+        if (key == "animation_couples") {
+            if (peek() != '[') {
+                return skipValue();
+            }
+            return parseArrayElements([&]() { return parseCouple(scene); });
+        }
+
+        QString value;
+        bool isString;
+        if (!readStringOrNull(value, isString)) {
+            return false;
+        }
+        if (isString) {
+            scene.metadata.insert(QString::fromUtf8(key), value);
+        }
+        return true;
+    });
+    if (!ok) {
+        return false;
+    }
+
+    skipWhitespace();
+    if (!atEnd()) {
+        return fail("Unexpected data after scene object");
+    }
+    if (!hasObjects) {
+        return fail("Missing or invalid 'objects' array");
+    }
+    if (!hasRelations) {
+        return fail("Missing or invalid 'relations' array");
+    }
+    return true;
+}
+
+bool SceneJsonParser::parseSceneObject(SceneDescription &scene)
+{
+    SceneObjectDescription object;
+    bool hasId = false;
+    bool hasType = false;
+
+    const bool ok = parseObjectMembers([&](const QByteArray &key) {
+        if (key == "id") {
+            return readStringOrNull(object.id, hasId);
+        }
+        if (key == "object") {
+            if (!readStringOrNull(object.type, hasType)) {
+                return false;
+            }
+            object.type = m_strings.intern(object.type);
+            return true;
+        }
+        if (key == "attributes") {
+            skipWhitespace();
+            return peek() == '{' ? parseAttributes(object) : skipValue();
+        }
+        return skipValue();
+    });
+    if (!ok) {
+        return false;
+    }
+    if (!hasId || !hasType) {
+        return fail("Object missing required fields (object, id)");
+    }
+
+    scene.objects.append(object);
+    return true;
+}
+
+bool SceneJsonParser::parseAttributes(SceneObjectDescription &object)
+{
+    return parseObjectMembers([&](const QByteArray &key) {
+        bool isString;
+        if (key == "color") {
+            if (!readStringOrNull(object.color, object.hasColor)) {
+                return false;
+            }
+            object.color = m_strings.intern(object.color);
+            return true;
+        }
+        if (key == "size") {
+            if (!readStringOrNull(object.size, isString)) {
+                return false;
+            }
+            object.size = m_strings.intern(object.size);
+            return true;
+        }
+        if (key == "animations") {
+            skipWhitespace();
+            if (peek() == 'n') {
+                return skipLiteral(); // "animations": null
+            }
+            if (peek() != '[') {
+                return fail("'animations' must be an array or null");
+            }
+            return parseArrayElements([&]() {
+                QString animation;
+                if (!readStringOrNull(animation, isString)) {
+                    return false;
+                }
+                object.animations.append(m_strings.intern(animation));
+                return true;
+            });
+        }
+        return skipValue();
+    });
+}
+
+bool SceneJsonParser::parseRelation(SceneDescription &scene)
+{
+    SceneRelationDescription relation;
+    const bool ok = parseObjectMembers([&](const QByteArray &key) {
+        bool isString;
+        if (key == "object_1") {
+            return readStringOrNull(relation.object1, isString);
+        }
+        if (key == "object_2") {
+            return readStringOrNull(relation.object2, isString);
+        }
+        if (key == "relation") {
+            if (!readStringOrNull(relation.relation, isString)) {
+                return false;
+            }
+            relation.relation = m_strings.intern(relation.relation);
+            return true;
+        }
+        return skipValue();
+    });
+    if (ok) {
+        scene.relations.append(relation);
+    }
+    return ok;
+}
+
+bool SceneJsonParser::parseCouple(SceneDescription &scene)
+{
+    AnimationCoupleDescription couple;
+    const bool ok = parseObjectMembers([&](const QByteArray &key) {
+        bool isString;
+        if (key == "primary_object") {
+            return readStringOrNull(couple.primaryObject, isString);
+        }
+        if (key == "reference_object") {
+            return readStringOrNull(couple.referenceObject, isString);
+        }
+        if (key == "animation_type") {
+            if (!readStringOrNull(couple.animationType, isString)) {
+                return false;
+            }
+            couple.animationType = m_strings.intern(couple.animationType);
+            return true;
+        }
+        if (key == "description") {
+            return readStringOrNull(couple.description, isString);
+        }
+        return skipValue();
+    });
+    if (ok) {
+        scene.animationCouples.append(couple);
+    }
+    return ok;
+}
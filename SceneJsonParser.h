@@ -0,0 +1,71 @@
+#ifndef SCENEJSONPARSER_H
+#define SCENEJSONPARSER_H
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QString>
+
+#include "SceneDescription.h"
+
+// Parser JSON incremental pentru fisierele de scena.
+// Citeste fisierul in bucati de dimensiune fixa si valideaza schema in timp ce construieste
+// SceneDescription, intr-o singura trecere si fara a materializa un QJsonDocument.
+// Memoria folosita este bufferul de citire plus descrierea rezultata.
+class SceneJsonParser
+{
+public:
+    SceneJsonParser();
+
+    bool parseFile(const QString &filePath, SceneDescription &scene);
+    bool parse(QIODevice *device, SceneDescription &scene);
+
+    QString errorString() const { return m_error; }
+
+    // Statistici pentru ultimul fisier parsat
+    qint64 bytesParsed() const { return m_bytesParsed; }
+    qint64 elapsedNs() const { return m_elapsedNs; }
+    double throughputMBps() const;
+
+private:
+    static constexpr int CHUNK_SIZE = 64 * 1024;
+
+    // Lexer
+    bool fill();
+    bool atEnd();
+    char peek();
+    char get();
+    void skipWhitespace();
+    bool expect(char c);
+    bool readString(QString &value);
+    bool readStringOrNull(QString &value, bool &isString);
+    bool skipValue();
+    bool skipLiteral();
+
+    // Iterare peste membrii unui obiect / elementele unui array; callback-ul consuma valoarea
+    template <typename Callback>
+    bool parseObjectMembers(Callback onMember);
+    template <typename Callback>
+    bool parseArrayElements(Callback onElement);
+
+    // Schema
+    bool parseRoot(SceneDescription &scene);
+    bool parseSceneObject(SceneDescription &scene);
+    bool parseAttributes(SceneObjectDescription &object);
+    bool parseRelation(SceneDescription &scene);
+    bool parseCouple(SceneDescription &scene);
+
+    bool fail(const QString &error);
+
+    QIODevice *m_device;
+    QByteArray m_buffer;
+    int m_pos;
+    qint64 m_bytesParsed;
+    qint64 m_elapsedNs;
+    int m_line;
+    int m_column;
+    QByteArray m_token;
+    QString m_error;
+    StringInterner m_strings;
+};
+
+#endif // SCENEJSONPARSER_H
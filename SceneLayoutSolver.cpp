@@ -0,0 +1,305 @@
+#include "SceneLayoutSolver.h"
+#include <QElapsedTimer>
+#include <QtMath>
+
+namespace {
+
+// Cat din corectie preia subiectul; restul il preia referinta
+const float SUBJECT_WEIGHT = 0.75f;
+
+// Cat lipseste ca value sa ajunga in [low, high] (cu semn), 0 daca e deja in interval
+float outside(float value, float low, float high)
+{
+    if (value < low) {
+        return low - value;
+    }
+    if (value > high) {
+        return high - value;
+    }
+    return 0.0f;
+}
+
+float footprintRadius(const QVector3D &half)
+{
+    return qMax(half.x(), half.z());
+}
+
+} // namespace
+
+SceneLayoutSolver::SceneLayoutSolver(float floorLevel, float gap, float spacing)
+    : m_grid(spacing)
+    , m_floorLevel(floorLevel)
+    , m_gap(gap)
+    , m_spacing(spacing)
+{
+}
+
+SceneLayoutSolver::Relation SceneLayoutSolver::parseRelation(const QString &relation)
+{
+    // LLM-ul scrie relatiile cu '_' (left_of, next_to, in_front_of)
+    const QString r = QString(relation).replace('_', ' ').simplified().toLower();
+    if (r == "left" || r == "left of" || r == "to the left of") return Relation::Left;
+    if (r == "right" || r == "right of" || r == "to the right of") return Relation::Right;
+    if (r == "behind") return Relation::Behind;
+    if (r == "front" || r == "in front" || r == "in front of") return Relation::Front;
+    if (r == "above" || r == "on top of" || r == "on top" || r == "on") return Relation::Above;
+    if (r == "below" || r == "under" || r == "beneath") return Relation::Below;
+    if (r == "near" || r == "next to" || r == "beside") return Relation::Near;
+    if (r == "inside" || r == "in") return Relation::Inside;
+    if (r == "between") return Relation::Between;
+    return Relation::Unknown;
+}
+
+quint64 SceneLayoutSolver::pairKey(int a, int b)
+{
+    return (quint64(qMin(a, b)) << 32) | quint32(qMax(a, b));
+}
+
+float SceneLayoutSolver::shareOf(const Item &item, const Item &other, float share)
+{
+    // Partea din corectie preluata de item cand other poate fi sau nu mutat
+    if (item.pinned) {
+        return 0.0f;
+    }
+    return other.pinned ? 1.0f : share;
+}
+
+void SceneLayoutSolver::addObject(const QString &id, const QVector3D &size, const QVector3D &initialPosition,
+                                  bool pinned)
+{
+    Item item;
+    item.id = id;
+    item.position = initialPosition;
+    item.half = size * 0.5f;
+    item.verticalFree = false;
+    item.pinned = pinned;
+
+    m_indices.insert(id, m_items.size());
+    m_items.append(item);
+}
+
+bool SceneLayoutSolver::addRelation(const QString &subjectId, const QString &relation, const QString &referenceId)
+{
+    const int subject = m_indices.value(subjectId, -1);
+    const int reference = m_indices.value(referenceId, -1);
+    const Relation parsed = parseRelation(relation);
+    if (subject < 0 || reference < 0 || subject == reference || parsed == Relation::Unknown) {
+        return false;
+    }
+
+    if (parsed == Relation::Above || parsed == Relation::Inside) {
+        m_items[subject].verticalFree = true;
+        m_stackedPairs.insert(pairKey(subject, reference));
+    } else if (parsed == Relation::Below) {
+        m_items[reference].verticalFree = true;
+        m_stackedPairs.insert(pairKey(subject, reference));
+    } else if (parsed == Relation::Between) {
+        // A doua referinta completeaza constrangerea deja adaugata pentru subiect
+        const int existing = m_betweenConstraints.value(subject, -1);
+        if (existing >= 0 && m_constraints[existing].reference != reference) {
+            m_constraints[existing].secondReference = reference;
+            m_betweenConstraints.remove(subject);
+            return true;
+        }
+        m_betweenConstraints.insert(subject, m_constraints.size());
+    }
+
+    m_constraints.append({ subject, reference, parsed, -1 });
+    return true;
+}
+
+float SceneLayoutSolver::projectConstraint(const Constraint &constraint, bool apply)
+{
+    Item &s = m_items[constraint.subject];
+    Item &r = m_items[constraint.reference];
+    QVector3D correction; // deplasarea dorita pentru subiect
+
+    const QVector3D delta = s.position - r.position;
+    const QVector3D touching = s.half + r.half;
+
+    switch (constraint.relation) {
+    case Relation::Left:
+    case Relation::Right: {
+        // Pe X: alaturi, la o distanta intre gap si spacing; pe Z: aliniate
+        const float sign = constraint.relation == Relation::Left ? -1.0f : 1.0f;
+        const float nearest = touching.x() + m_gap;
+        const float along = outside(sign * delta.x(), nearest, nearest + m_spacing);
+        const float across = qMax(s.half.z(), r.half.z());
+        correction = QVector3D(sign * along, 0.0f, outside(delta.z(), -across, across));
+        break;
+    }
+    case Relation::Behind:
+    case Relation::Front: {
+        const float sign = constraint.relation == Relation::Behind ? -1.0f : 1.0f;
+        const float nearest = touching.z() + m_gap;
+        const float along = outside(sign * delta.z(), nearest, nearest + m_spacing);
+        const float across = qMax(s.half.x(), r.half.x());
+        correction = QVector3D(outside(delta.x(), -across, across), 0.0f, sign * along);
+        break;
+    }
+    case Relation::Above:
+    case Relation::Below: {
+        // Obiectul de sus sta pe cel de jos, cu proiectia in interiorul celui mai lat
+        const float sign = constraint.relation == Relation::Above ? 1.0f : -1.0f;
+        const float spanX = qAbs(r.half.x() - s.half.x());
+        const float spanZ = qAbs(r.half.z() - s.half.z());
+        correction = QVector3D(outside(delta.x(), -spanX, spanX),
+                               sign * touching.y() - delta.y(),
+                               outside(delta.z(), -spanZ, spanZ));
+        break;
+    }
+    case Relation::Inside: {
+        // Obiectul interior sta pe baza celui exterior, cu proiectia in interiorul lui
+        const float spanX = qMax(0.0f, r.half.x() - s.half.x());
+        const float spanZ = qMax(0.0f, r.half.z() - s.half.z());
+        correction = QVector3D(outside(delta.x(), -spanX, spanX),
+                               s.half.y() - r.half.y() - delta.y(),
+                               outside(delta.z(), -spanZ, spanZ));
+        break;
+    }
+    case Relation::Between:
+        if (constraint.secondReference >= 0) {
+            // Pe orizontala, la mijlocul celor doua referinte
+            const Item &second = m_items[constraint.secondReference];
+            const QVector3D middle = (r.position + second.position) * 0.5f;
+            correction = QVector3D(middle.x() - s.position.x(), 0.0f, middle.z() - s.position.z());
+            break;
+        }
+        Q_FALLTHROUGH(); // o singura referinta: langa ea
+    case Relation::Near: {
+        const QVector3D flat(delta.x(), 0.0f, delta.z());
+        const float distance = flat.length();
+        const float nearest = footprintRadius(s.half) + footprintRadius(r.half) + m_gap;
+        const float change = outside(distance, nearest, nearest + m_spacing);
+        const QVector3D direction = distance > 1e-4f ? flat / distance : QVector3D(1.0f, 0.0f, 0.0f);
+        correction = direction * change;
+        break;
+    }
+    case Relation::Unknown:
+        break;
+    }
+
+    const float violation = correction.length();
+    if (!apply || violation == 0.0f) {
+        return violation;
+    }
+
+    // Pe verticala se misca doar obiectul sustinut; pe orizontala corectia se imparte
+    const QVector3D horizontal(correction.x(), 0.0f, correction.z());
+    if (constraint.relation == Relation::Between && constraint.secondReference >= 0) {
+        // Referintele raman pe loc: mijlocul lor se muta doar prin celelalte constrangeri
+        s.position += horizontal * (s.pinned ? 0.0f : 1.0f);
+        return violation;
+    }
+    s.position += horizontal * shareOf(s, r, SUBJECT_WEIGHT);
+    r.position -= horizontal * shareOf(r, s, 1.0f - SUBJECT_WEIGHT);
+    if (constraint.relation == Relation::Above || constraint.relation == Relation::Inside) {
+        s.position.setY(s.position.y() + correction.y() * shareOf(s, r, 1.0f));
+    } else if (constraint.relation == Relation::Below) {
+        r.position.setY(r.position.y() - correction.y() * shareOf(r, s, 1.0f));
+    }
+    return violation;
+}
+
+float SceneLayoutSolver::resolveOverlaps(bool apply, int &overlaps)
+{
+    const QVector3D margin(m_gap * 0.5f, m_gap * 0.5f, m_gap * 0.5f);
+
+    m_grid.clear();
+    for (int i = 0; i < m_items.size(); ++i) {
+        const Item &item = m_items[i];
+        m_grid.insert(i, item.position - item.half - margin, item.position + item.half + margin);
+    }
+    m_grid.collectPairs(m_pairs);
+
+    float worst = 0.0f;
+    overlaps = 0;
+    for (const QPair<int, int> &pair : std::as_const(m_pairs)) {
+        if (m_stackedPairs.contains(pairKey(pair.first, pair.second))) {
+            continue;
+        }
+
+        Item &a = m_items[pair.first];
+        Item &b = m_items[pair.second];
+        const QVector3D delta = b.position - a.position;
+        const QVector3D reach = a.half + b.half + margin * 2.0f;
+
+        const float penetrationX = reach.x() - qAbs(delta.x());
+        const float penetrationY = reach.y() - qAbs(delta.y());
+        const float penetrationZ = reach.z() - qAbs(delta.z());
+        if (penetrationX <= 0.0f || penetrationY <= 0.0f || penetrationZ <= 0.0f) {
+            continue;
+        }
+
+        // Despartire pe axa orizontala cu cea mai mica patrundere
+        ++overlaps;
+        const float penetration = qMin(penetrationX, penetrationZ);
+        worst = qMax(worst, penetration);
+        if (!apply) {
+            continue;
+        }
+
+        QVector3D push;
+        if (penetrationX <= penetrationZ) {
+            push.setX(delta.x() >= 0.0f ? penetrationX : -penetrationX);
+        } else {
+            push.setZ(delta.z() >= 0.0f ? penetrationZ : -penetrationZ);
+        }
+        a.position -= push * shareOf(a, b, 0.5f);
+        b.position += push * shareOf(b, a, 0.5f);
+    }
+    return worst;
+}
+
+void SceneLayoutSolver::applyFloor()
+{
+    for (Item &item : m_items) {
+        if (item.pinned) {
+            continue;
+        }
+        const float restingY = m_floorLevel + item.half.y();
+        if (!item.verticalFree || item.position.y() < restingY) {
+            item.position.setY(restingY);
+        }
+    }
+}
+
+SceneLayoutSolver::Result SceneLayoutSolver::solve(int maxIterations, float tolerance)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    Result result;
+    applyFloor();
+
+    int overlaps = 0;
+    for (int iteration = 0; iteration < maxIterations; ++iteration) {
+        float worst = 0.0f;
+        for (const Constraint &constraint : std::as_const(m_constraints)) {
+            worst = qMax(worst, projectConstraint(constraint, true));
+        }
+        worst = qMax(worst, resolveOverlaps(true, overlaps));
+        applyFloor();
+
+        result.iterations = iteration + 1;
+        if (worst < tolerance) {
+            break;
+        }
+    }
+
+    // Incalcarea ramasa dupa ultima iteratie
+    float residual = 0.0f;
+    for (const Constraint &constraint : std::as_const(m_constraints)) {
+        residual = qMax(residual, projectConstraint(constraint, false));
+    }
+    residual = qMax(residual, resolveOverlaps(false, overlaps));
+
+    result.residual = residual;
+    result.overlaps = overlaps;
+    result.converged = residual < tolerance;
+    for (const Item &item : std::as_const(m_items)) {
+        result.positions.insert(item.id, item.position);
+    }
+    result.elapsedMicroseconds = timer.nsecsElapsed() / 1000;
+    return result;
+}
@@ -0,0 +1,99 @@
+#ifndef SCENELAYOUTSOLVER_H
+#define SCENELAYOUTSOLVER_H
+
+#include <QHash>
+#include <QMap>
+#include <QPair>
+#include <QSet>
+#include <QString>
+#include <QVector>
+#include <QVector3D>
+
+#include "SpatialHash.h"
+
+// Asezarea obiectelor din scena pe baza relatiilor ("left", "on top of", "near", "under", ...).
+// Relatiile se scriu ca in promptul LLM (left_of, next_to, in_front_of) sau cu spatii.
+// "between" are nevoie de doua referinte, date ca doua relatii cu acelasi subiect; cu o singura
+// referinta este tratata ca "near".
+// Toate relatiile sunt constrangeri rezolvate impreuna, iterativ (proiectii Gauss-Seidel):
+// fiecare iteratie corecteaza pe rand constrangerile incalcate, desparte obiectele care se
+// suprapun (perechile candidate vin din SpatialHash) si aplica podeaua. Se opreste cand cea
+// mai mare incalcare scade sub toleranta sau dupa numarul maxim de iteratii.
+class SceneLayoutSolver
+{
+public:
+    enum class Relation {
+        Left,
+        Right,
+        Behind,
+        Front,
+        Above,
+        Below,
+        Near,
+        Inside,
+        Between,
+        Unknown
+    };
+
+    struct Result {
+        QMap<QString, QVector3D> positions; // centrele obiectelor
+        int iterations = 0;
+        float residual = 0.0f;  // cea mai mare incalcare ramasa, in unitati de scena
+        int overlaps = 0;       // perechi care inca se suprapun
+        bool converged = false;
+        qint64 elapsedMicroseconds = 0;
+    };
+
+    // gap: distanta minima dintre obiecte; spacing: cat de departe poate fi un obiect de
+    // referinta lui intr-o relatie directionala (left/right/behind/front/near)
+    SceneLayoutSolver(float floorLevel, float gap, float spacing);
+
+    // size: dimensiunile reale ale obiectului; initialPosition: punctul de pornire (ex. grila).
+    // Un obiect fixat (pinned) ramane unde este; corectiile sunt preluate de celalalt obiect.
+    void addObject(const QString &id, const QVector3D &size, const QVector3D &initialPosition,
+                   bool pinned = false);
+    // false pentru relatii necunoscute sau obiecte lipsa
+    bool addRelation(const QString &subjectId, const QString &relation, const QString &referenceId);
+
+    Result solve(int maxIterations = 100, float tolerance = 0.01f);
+
+    int objectCount() const { return m_items.size(); }
+    int constraintCount() const { return m_constraints.size(); }
+
+    static Relation parseRelation(const QString &relation);
+
+private:
+    struct Item {
+        QString id;
+        QVector3D position;
+        QVector3D half;
+        bool verticalFree; // sustinut de alt obiect in loc de podea
+        bool pinned;
+    };
+
+    struct Constraint {
+        int subject;
+        int reference;
+        Relation relation;
+        int secondReference; // doar pentru Between
+    };
+
+    float projectConstraint(const Constraint &constraint, bool apply);
+    float resolveOverlaps(bool apply, int &overlaps);
+    void applyFloor();
+    static quint64 pairKey(int a, int b);
+    static float shareOf(const Item &item, const Item &other, float share);
+
+    QVector<Item> m_items;
+    QHash<QString, int> m_indices;
+    QVector<Constraint> m_constraints;
+    QSet<quint64> m_stackedPairs; // perechi care se ating intentionat (above/below/inside)
+    QHash<int, int> m_betweenConstraints; // subiect -> constrangerea "between" cu o singura referinta
+    SpatialHash m_grid;
+    QVector<QPair<int, int>> m_pairs;
+    float m_floorLevel;
+    float m_gap;
+    float m_spacing;
+};
+
+#endif // SCENELAYOUTSOLVER_H
@@ -0,0 +1,214 @@
+#include "SceneResultCache.h"
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QDebug>
+
+namespace {
+
+constexpr qint64 DEFAULT_MEMORY_LIMIT = 8 * 1024 * 1024;
+constexpr qint64 DEFAULT_DISK_LIMIT = 64 * 1024 * 1024;
+constexpr int CACHE_VERSION = 1;
+
+} // namespace
+
+SceneResultCache::SceneResultCache()
+    : m_diskBytes(0), m_diskLimit(DEFAULT_DISK_LIMIT),
+      m_memoryHits(0), m_diskHits(0), m_misses(0), m_savedMs(0)
+{
+    m_memory.setMaxCost(DEFAULT_MEMORY_LIMIT);
+    m_directory = QCoreApplication::applicationDirPath() + "/../../../temp/scene_cache/";
+    QDir().mkpath(m_directory);
+    scanDirectory();
+}
+
+QString SceneResultCache::normalize(const QString &text)
+{
+    static const QRegularExpression trailingPunctuation("[\\s.!?;,]+$");
+
+    QString normalized = text.normalized(QString::NormalizationForm_C).toLower().simplified();
+    normalized.remove(trailingPunctuation);
+    return normalized;
+}
+
+QString SceneResultCache::keyFor(const QString &text, const QString &language)
+{
+    const QByteArray source = (language.trimmed().toLower() + '\n' + normalize(text)).toUtf8();
+    return QString::fromLatin1(QCryptographicHash::hash(source, QCryptographicHash::Sha1).toHex());
+}
+
+QString SceneResultCache::pathFor(const QString &key) const
+{
+    return m_directory + key + ".json";
+}
+
+float SceneResultCache::hitRate() const
+{
+    const quint64 total = hits() + m_misses;
+    return total > 0 ? float(hits()) / float(total) : 0.0f;
+}
+
+void SceneResultCache::setMemoryLimit(qint64 bytes)
+{
+    m_memory.setMaxCost(bytes);
+}
+
+void SceneResultCache::setDiskLimit(qint64 bytes)
+{
+    m_diskLimit = bytes;
+    enforceDiskLimit();
+}
+
+void SceneResultCache::scanDirectory()
+{
+    m_disk.clear();
+    m_diskBytes = 0;
+
+    const QFileInfoList files = QDir(m_directory).entryInfoList({ "*.json" }, QDir::Files);
+    for (const QFileInfo &file : files) {
+        m_disk.insert(file.completeBaseName(), DiskEntry{ file.size(), file.lastModified() });
+        m_diskBytes += file.size();
+    }
+    enforceDiskLimit();
+}
+
+void SceneResultCache::insertInMemory(const QString &key, const QJsonObject &scene, qint64 generationMs, qint64 bytes)
+{
+    // QCache preia pointerul si elimina intrarile folosite cel mai demult peste maxCost
+    m_memory.insert(key, new MemoryEntry{ scene, generationMs }, qMax<qint64>(bytes, 1));
+}
+
+bool SceneResultCache::lookup(const QString &text, const QString &language, QJsonObject &scene)
+{
+    const QString key = keyFor(text, language);
+
+    if (const MemoryEntry *entry = m_memory.object(key)) {
+        scene = entry->scene;
+        ++m_memoryHits;
+        m_savedMs += entry->generationMs;
+
+        // Altfel o scena folosita des doar din memorie ar fi prima eliminata de pe disc
+        QFile file(pathFor(key));
+        if (m_disk.contains(key) && file.open(QIODevice::ReadWrite | QIODevice::ExistingOnly)) {
+            touchOnDisk(key, file);
+        }
+        return true;
+    }
+
+    auto diskIt = m_disk.find(key);
+    if (diskIt != m_disk.end()) {
+        QFile file(pathFor(key));
+        if (file.open(QIODevice::ReadWrite)) {
+            const QByteArray data = file.readAll();
+            const QJsonObject root = QJsonDocument::fromJson(data).object();
+            if (root.value("version").toInt() == CACHE_VERSION && root.value("scene").isObject()) {
+                scene = root.value("scene").toObject();
+                const qint64 generationMs = qint64(root.value("generationMs").toDouble());
+
+                touchOnDisk(key, file);
+                insertInMemory(key, scene, generationMs, data.size());
+                ++m_diskHits;
+                m_savedMs += generationMs;
+                return true;
+            }
+        }
+
+        // Fisier corupt sau dintr-o versiune veche
+        file.close();
+        removeFromDisk(key);
+    }
+
+    ++m_misses;
+    return false;
+}
+
+void SceneResultCache::store(const QString &text, const QString &language, const QJsonObject &scene, qint64 generationMs)
+{
+    const QString key = keyFor(text, language);
+
+    QJsonObject root;
+    root["version"] = CACHE_VERSION;
+    root["text"] = normalize(text);
+    root["lang"] = language;
+    root["generationMs"] = double(generationMs);
+    root["created"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    root["scene"] = scene;
+    const QByteArray data = QJsonDocument(root).toJson(QJsonDocument::Compact);
+
+    insertInMemory(key, scene, generationMs, data.size());
+
+    QSaveFile file(pathFor(key));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Scene cache: cannot write" << pathFor(key);
+        return;
+    }
+    file.write(data);
+    if (!file.commit()) {
+        return;
+    }
+
+    auto it = m_disk.find(key);
+    if (it != m_disk.end()) {
+        m_diskBytes -= it->bytes;
+    }
+    m_disk.insert(key, DiskEntry{ data.size(), QDateTime::currentDateTime() });
+    m_diskBytes += data.size();
+    enforceDiskLimit();
+}
+
+void SceneResultCache::touchOnDisk(const QString &key, QFile &file)
+{
+    // mtime-ul marcheaza ultima folosire, pentru evictia de pe disc (si dupa repornire)
+    DiskEntry &entry = m_disk[key];
+    entry.lastUsed = QDateTime::currentDateTime();
+    file.setFileTime(entry.lastUsed, QFileDevice::FileModificationTime);
+}
+
+void SceneResultCache::removeFromDisk(const QString &key)
+{
+    auto it = m_disk.find(key);
+    if (it == m_disk.end()) {
+        return;
+    }
+    m_diskBytes -= it->bytes;
+    m_disk.erase(it);
+    QFile::remove(pathFor(key));
+}
+
+void SceneResultCache::enforceDiskLimit()
+{
+    while (m_diskBytes > m_diskLimit && !m_disk.isEmpty()) {
+        auto oldest = m_disk.begin();
+        for (auto it = m_disk.begin(); it != m_disk.end(); ++it) {
+            if (it->lastUsed < oldest->lastUsed) {
+                oldest = it;
+            }
+        }
+        removeFromDisk(oldest.key());
+    }
+}
+
+void SceneResultCache::invalidate(const QString &text, const QString &language)
+{
+    const QString key = keyFor(text, language);
+    m_memory.remove(key);
+    removeFromDisk(key);
+}
+
+void SceneResultCache::clear()
+{
+    m_memory.clear();
+    const QStringList keys = m_disk.keys();
+    for (const QString &key : keys) {
+        removeFromDisk(key);
+    }
+    m_memoryHits = 0;
+    m_diskHits = 0;
+    m_misses = 0;
+    m_savedMs = 0;
+}
@@ -0,0 +1,79 @@
+#ifndef SCENERESULTCACHE_H
+#define SCENERESULTCACHE_H
+
+#include <QCache>
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+
+// Cache pentru scenele generate de serverul NLP, cheia fiind textul normalizat + limba.
+// Doua niveluri: LRU in memorie (QCache, cost = dimensiunea JSON-ului) si fisiere pe disc in
+// temp/scene_cache, fiecare cu limita proprie de octeti. Pe disc sunt eliminate intai intrarile
+// folosite cel mai demult. Fiecare intrare retine cat a durat generarea, deci un hit stie cat
+// timp a economisit.
+class SceneResultCache
+{
+public:
+    SceneResultCache();
+
+    // Scena pentru text/limba, cautata intai in memorie, apoi pe disc
+    bool lookup(const QString &text, const QString &language, QJsonObject &scene);
+    void store(const QString &text, const QString &language, const QJsonObject &scene, qint64 generationMs);
+
+    void invalidate(const QString &text, const QString &language);
+    void clear();
+
+    void setMemoryLimit(qint64 bytes);
+    void setDiskLimit(qint64 bytes);
+
+    quint64 hits() const { return m_memoryHits + m_diskHits; }
+    quint64 memoryHits() const { return m_memoryHits; }
+    quint64 diskHits() const { return m_diskHits; }
+    quint64 misses() const { return m_misses; }
+    float hitRate() const;
+    qint64 savedMilliseconds() const { return m_savedMs; }
+
+    int memoryEntryCount() const { return m_memory.count(); }
+    qint64 memoryBytes() const { return m_memory.totalCost(); }
+    int diskEntryCount() const { return m_disk.size(); }
+    qint64 diskBytes() const { return m_diskBytes; }
+    QString directory() const { return m_directory; }
+
+    // Spatii comprimate, litere mici, fara punctuatie la final: "A red  cube." == "a red cube"
+    static QString normalize(const QString &text);
+    static QString keyFor(const QString &text, const QString &language);
+
+private:
+    struct MemoryEntry {
+        QJsonObject scene;
+        qint64 generationMs;
+    };
+
+    struct DiskEntry {
+        qint64 bytes;
+        QDateTime lastUsed;
+    };
+
+    QString pathFor(const QString &key) const;
+    void insertInMemory(const QString &key, const QJsonObject &scene, qint64 generationMs, qint64 bytes);
+    void scanDirectory();
+    // Marcheaza intrarea de pe disc ca folosita acum (mtime-ul fisierului si indexul din memorie)
+    void touchOnDisk(const QString &key, QFile &file);
+    void removeFromDisk(const QString &key);
+    void enforceDiskLimit();
+
+    QCache<QString, MemoryEntry> m_memory;
+    QHash<QString, DiskEntry> m_disk;
+    QString m_directory;
+    qint64 m_diskBytes;
+    qint64 m_diskLimit;
+
+    quint64 m_memoryHits;
+    quint64 m_diskHits;
+    quint64 m_misses;
+    qint64 m_savedMs;
+};
+
+#endif // SCENERESULTCACHE_H
@@ -0,0 +1,213 @@
+#include "SceneStore.h"
+
+namespace {
+
+template <typename T>
+void swapRemove(QVector<T> &values, int index)
+{
+    if (index != values.size() - 1) {
+        values[index] = std::move(values.last());
+    }
+    values.removeLast();
+}
+
+} // namespace
+
+SceneStore::Handle SceneStore::add(const SceneObject &object)
+{
+    // Un id existent este inlocuit, ca la QMap::operator[]
+    const Handle existing = handleOf(object.id);
+    if (existing != INVALID_HANDLE) {
+        remove(existing);
+    }
+
+    const Handle handle = ids.size();
+    m_handles.insert(object.id, handle);
+
+    ids.append(object.id);
+    types.append(object.type);
+    colors.append(object.color);
+    sizes.append(object.size);
+    modelPaths.append(object.modelPath);
+    lodLevels.append(0);
+    animations.append(object.animations);
+    entities.append(object.entity);
+    transforms.append(object.transform);
+    materials.append(object.material);
+
+    positions.append(object.position);
+    originalPositions.append(object.originalPosition);
+    velocities.append(object.velocity);
+    boundsMin.append(object.boundingBoxMin);
+    boundsMax.append(object.boundingBoxMax);
+    radii.append(object.boundingSphereRadius);
+    flags.append(object.isDynamic ? Dynamic : 0);
+    sleepTimers.append(0.0f);
+
+    animationFlags.append(0);
+    baseScales.append(1.0f);
+    localBoundsMin.append(object.boundingBoxMin - object.position);
+    localBoundsMax.append(object.boundingBoxMax - object.position);
+    rotations.append(QQuaternion());
+    scales.append(1.0f);
+
+    bouncePhases.append(object.animationState.bouncePhase);
+    floatPhases.append(object.animationState.floatPhase);
+    pulsePhases.append(object.animationState.pulsePhase);
+    swingPhases.append(object.animationState.swingPhase);
+    rotationAngles.append(object.animationState.rotationAngle);
+
+    return handle;
+}
+
+SceneStore::Handle SceneStore::remove(Handle handle)
+{
+    if (handle < 0 || handle >= size()) {
+        return INVALID_HANDLE;
+    }
+
+    const Handle last = size() - 1;
+    m_handles.remove(ids[handle]);
+    if (handle != last) {
+        m_handles[ids[last]] = handle;
+    }
+
+    swapRemove(ids, handle);
+    swapRemove(types, handle);
+    swapRemove(colors, handle);
+    swapRemove(sizes, handle);
+    swapRemove(modelPaths, handle);
+    swapRemove(lodLevels, handle);
+    swapRemove(animations, handle);
+    swapRemove(entities, handle);
+    swapRemove(transforms, handle);
+    swapRemove(materials, handle);
+
+    swapRemove(positions, handle);
+    swapRemove(originalPositions, handle);
+    swapRemove(velocities, handle);
+    swapRemove(boundsMin, handle);
+    swapRemove(boundsMax, handle);
+    swapRemove(radii, handle);
+    swapRemove(flags, handle);
+    swapRemove(sleepTimers, handle);
+
+    swapRemove(animationFlags, handle);
+    swapRemove(baseScales, handle);
+    swapRemove(localBoundsMin, handle);
+    swapRemove(localBoundsMax, handle);
+    swapRemove(rotations, handle);
+    swapRemove(scales, handle);
+
+    swapRemove(bouncePhases, handle);
+    swapRemove(floatPhases, handle);
+    swapRemove(pulsePhases, handle);
+    swapRemove(swingPhases, handle);
+    swapRemove(rotationAngles, handle);
+
+    return handle != last ? last : INVALID_HANDLE;
+}
+
+void SceneStore::clear()
+{
+    m_handles.clear();
+
+    ids.clear();
+    types.clear();
+    colors.clear();
+    sizes.clear();
+    modelPaths.clear();
+    lodLevels.clear();
+    animations.clear();
+    entities.clear();
+    transforms.clear();
+    materials.clear();
+
+    positions.clear();
+    originalPositions.clear();
+    velocities.clear();
+    boundsMin.clear();
+    boundsMax.clear();
+    radii.clear();
+    flags.clear();
+    sleepTimers.clear();
+
+    animationFlags.clear();
+    baseScales.clear();
+    localBoundsMin.clear();
+    localBoundsMax.clear();
+    rotations.clear();
+    scales.clear();
+
+    bouncePhases.clear();
+    floatPhases.clear();
+    pulsePhases.clear();
+    swingPhases.clear();
+    rotationAngles.clear();
+}
+
+void SceneStore::setDynamic(Handle handle, bool dynamic)
+{
+    if (dynamic) {
+        flags[handle] |= Dynamic;
+    } else {
+        flags[handle] &= quint8(~Dynamic);
+    }
+}
+
+quint8 SceneStore::animationFlagFor(const QString &animationType)
+{
+    if (animationType == "rotate" || animationType == "rotation" || animationType == "spin") {
+        return AnimateRotate;
+    }
+    if (animationType == "bounce" || animationType == "bouncing" || animationType == "jump") {
+        return AnimateBounce;
+    }
+    if (animationType == "float" || animationType == "floating") {
+        return AnimateFloat;
+    }
+    if (animationType == "pulse" || animationType == "pulsing") {
+        return AnimatePulse;
+    }
+    if (animationType == "swing" || animationType == "swinging" || animationType == "oscillate") {
+        return AnimateSwing;
+    }
+    if (animationType == "glow") {
+        return AnimateGlow;
+    }
+    return 0;
+}
+
+SceneObject SceneStore::object(Handle handle) const
+{
+    SceneObject object;
+    if (handle < 0 || handle >= size()) {
+        return object;
+    }
+
+    object.id = ids[handle];
+    object.type = types[handle];
+    object.color = colors[handle];
+    object.size = sizes[handle];
+    object.modelPath = modelPaths[handle];
+    object.animations = animations[handle];
+    object.entity = entities[handle];
+    object.transform = transforms[handle];
+    object.material = materials[handle];
+
+    object.position = positions[handle];
+    object.originalPosition = originalPositions[handle];
+    object.velocity = velocities[handle];
+    object.boundingBoxMin = boundsMin[handle];
+    object.boundingBoxMax = boundsMax[handle];
+    object.boundingSphereRadius = radii[handle];
+    object.isDynamic = isDynamic(handle);
+
+    object.animationState.bouncePhase = bouncePhases[handle];
+    object.animationState.floatPhase = floatPhases[handle];
+    object.animationState.pulsePhase = pulsePhases[handle];
+    object.animationState.swingPhase = swingPhases[handle];
+    object.animationState.rotationAngle = rotationAngles[handle];
+
+    return object;
+}
@@ -0,0 +1,141 @@
+#ifndef SCENESTORE_H
+#define SCENESTORE_H
+
+#include <QHash>
+#include <QQuaternion>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QVector3D>
+#include <Qt3DCore/QEntity>
+#include <Qt3DCore/QTransform>
+#include <Qt3DRender/QMaterial>
+
+// Animation state structure for individual object animations
+struct AnimationState {
+    float bouncePhase;
+    float floatPhase;
+    float pulsePhase;
+    float swingPhase;
+    float rotationAngle;
+
+    AnimationState() : bouncePhase(0.0f), floatPhase(0.0f), pulsePhase(0.0f),
+                      swingPhase(0.0f), rotationAngle(0.0f) {}
+};
+
+// Object in scene struct (copie completa; in scena datele traiesc in SceneStore)
+struct SceneObject {
+    QString id;
+    QString type;
+    QString color;
+    QString size;
+    QString modelPath; // Cheia in GeometryCache
+    QVector3D position;
+    QVector3D originalPosition; // Store original position for animation calculations
+    QVector3D boundingBoxMin;
+    QVector3D boundingBoxMax;
+    float boundingSphereRadius;
+    Qt3DCore::QEntity* entity;
+    Qt3DCore::QTransform* transform;
+    Qt3DRender::QMaterial* material; // Partajat prin MaterialCache
+    QStringList animations;
+    AnimationState animationState; // Track animation phases
+    bool isDynamic;
+    QVector3D velocity;
+
+    SceneObject() : entity(nullptr), transform(nullptr), material(nullptr), isDynamic(false),
+                   boundingSphereRadius(1.0f), velocity(QVector3D(0,0,0)) {}
+};
+
+// Stocare data-oriented pentru obiectele scenei.
+// Fiecare obiect are un handle intreg dens (0..size()-1), iar fiecare camp este un vector
+// separat (structure of arrays): buclele de animatie, fizica si coliziuni parcurg memorie
+// contigua in loc sa sara prin nodurile unui QMap. Id-urile text sunt folosite doar prin
+// tabela id -> handle.
+//
+// La stergere ultimul obiect este mutat in locul celui sters, deci handle-urile nu sunt
+// stabile peste remove(); remove() intoarce vechiul handle al obiectului mutat.
+class SceneStore
+{
+public:
+    typedef int Handle;
+    static constexpr Handle INVALID_HANDLE = -1;
+
+    enum Flag : quint8 {
+        Dynamic = 0x01,
+        Batched = 0x02 // desenat de InstancedRenderer; entitatea proprie ramane dezactivata
+    };
+
+    // Programul de animatie al unui obiect: tipurile din descrierea scenei sunt compilate o
+    // singura data (setupObjectAnimation) intr-o masca de biti, evaluata in ordinea de mai jos
+    enum AnimationFlag : quint8 {
+        AnimateRotate = 0x01,
+        AnimateBounce = 0x02,
+        AnimateFloat = 0x04,
+        AnimatePulse = 0x08,
+        AnimateSwing = 0x10,
+        AnimateGlow = 0x20
+    };
+
+    // 0 pentru tipurile necunoscute (si pentru cele orbitale, tratate separat)
+    static quint8 animationFlagFor(const QString &animationType);
+
+    Handle add(const SceneObject &object);
+    Handle remove(Handle handle);
+    void clear();
+
+    int size() const { return ids.size(); }
+    bool isEmpty() const { return ids.isEmpty(); }
+    Handle handleOf(const QString &id) const { return m_handles.value(id, INVALID_HANDLE); }
+    bool contains(const QString &id) const { return m_handles.contains(id); }
+
+    bool isDynamic(Handle handle) const { return flags[handle] & Dynamic; }
+    void setDynamic(Handle handle, bool dynamic);
+
+    // Copie completa a obiectului (pentru API-ul public, nu pentru buclele fierbinti)
+    SceneObject object(Handle handle) const;
+
+    // Date reci: identitate, descriere si noduri Qt3D
+    QVector<QString> ids;
+    QVector<QString> types;
+    QVector<QString> colors;
+    QVector<QString> sizes;
+    QVector<QString> modelPaths;
+    QVector<quint8> lodLevels; // nivelul de detaliu desenat (0 = modelPaths, vezi ModelLod)
+    QVector<QStringList> animations;
+    QVector<Qt3DCore::QEntity *> entities;
+    QVector<Qt3DCore::QTransform *> transforms;
+    QVector<Qt3DRender::QMaterial *> materials;
+
+    // Date fierbinti, parcurse la fiecare cadru
+    QVector<QVector3D> positions;
+    QVector<QVector3D> originalPositions;
+    QVector<QVector3D> velocities;
+    QVector<QVector3D> boundsMin;
+    QVector<QVector3D> boundsMax;
+    QVector<float> radii;
+    QVector<quint8> flags;
+    QVector<float> sleepTimers; // cat timp (secunde) a stat obiectul aproape nemiscat
+
+    // Parametri precalculati la incarcare, ca tick-ul sa nu mai compare siruri
+    QVector<quint8> animationFlags;
+    QVector<float> baseScales;       // getSizeMultiplier(size) * MODEL_SCALE
+    QVector<QVector3D> localBoundsMin; // cutia obiectului relativ la pozitie
+    QVector<QVector3D> localBoundsMax;
+
+    // Transformarea curenta calculata de simulare (translatia este in positions)
+    QVector<QQuaternion> rotations;
+    QVector<float> scales;
+
+    // Fazele animatiilor, cate un vector pe faza
+    QVector<float> bouncePhases;
+    QVector<float> floatPhases;
+    QVector<float> pulsePhases;
+    QVector<float> swingPhases;
+    QVector<float> rotationAngles;
+
+private:
+    QHash<QString, Handle> m_handles;
+};
+
+#endif // SCENESTORE_H
@@ -0,0 +1,650 @@
+#include "SimulationWorker.h"
+#include <QElapsedTimer>
+#include <QtMath>
+#include <algorithm>
+
+namespace {
+
+const int SNAPSHOT_FRESH = 0x4;
+const int SNAPSHOT_INDEX = 0x3;
+
+const float DEFAULT_CELL_SIZE = 4.0f;
+
+template <typename T>
+void copyInto(QVector<T> &target, const QVector<T> &source)
+{
+    // Bufferele snapshot-urilor sunt refolosite; fara partajare implicita intre fire
+    target.resize(source.size());
+    std::copy(source.cbegin(), source.cend(), target.begin());
+}
+
+} // namespace
+
+SimulationWorker::SimulationWorker(QObject *parent)
+    : QThread(parent)
+    , m_postedCommands(0)
+    , m_stopRequested(false)
+    , m_appliedCommands(0)
+    , m_animatedObjects(0)
+    , m_settled(true)
+    , m_broadPhase(DEFAULT_CELL_SIZE)
+    , m_staticCellsDirty(true)
+    , m_floorLevel(-2.0f)
+    , m_animationsPaused(false)
+    , m_physicsPaused(false)
+    , m_stepNanoseconds(0)
+    , m_stepCount(0)
+    , m_averageStepTime(0.0f)
+    , m_readySnapshot(0)
+    , m_unseenAll(true)
+    , m_writeSnapshot(1)
+    , m_readSnapshot(2)
+{
+}
+
+SimulationWorker::~SimulationWorker()
+{
+    stop();
+}
+
+void SimulationWorker::post(SimulationCommand command)
+{
+    m_commands.push(std::move(command));
+    ++m_postedCommands;
+    m_wakeup.release();
+}
+
+void SimulationWorker::stop()
+{
+    m_stopRequested.store(true, std::memory_order_release);
+    m_wakeup.release();
+    wait();
+}
+
+const SimulationSnapshot *SimulationWorker::takeSnapshot()
+{
+    if (!(m_readySnapshot.load(std::memory_order_acquire) & SNAPSHOT_FRESH)) {
+        return nullptr;
+    }
+
+    // Bufferul citit anterior devine cel "gata", fara marcajul de nou
+    const int ready = m_readySnapshot.exchange(m_readSnapshot, std::memory_order_acq_rel);
+    m_readSnapshot = ready & SNAPSHOT_INDEX;
+    return &m_snapshots[m_readSnapshot];
+}
+
+void SimulationWorker::collectMoved()
+{
+    // Snapshot-ul anterior a fost preluat: mutarile de dinaintea lui sunt deja in GUI. Daca
+    // GUI-ul il preia chiar acum, lista de mai jos contine doar cateva obiecte in plus.
+    if (!(m_readySnapshot.load(std::memory_order_acquire) & SNAPSHOT_FRESH)) {
+        for (SceneStore::Handle h : std::as_const(m_unseenMoved)) {
+            m_unseenFlags[h] = 0;
+        }
+        m_unseenMoved.resize(0);
+        m_unseenAll = false;
+    }
+
+    const int count = m_store.size();
+    if (m_publishedPositions.size() != count) {
+        copyInto(m_publishedPositions, m_store.positions);
+        copyInto(m_publishedRotations, m_store.rotations);
+        copyInto(m_publishedScales, m_store.scales);
+        m_unseenFlags.fill(0, count);
+        m_unseenMoved.resize(0);
+        m_unseenAll = true;
+        return;
+    }
+
+    for (SceneStore::Handle h = 0; h < count; ++h) {
+        if (m_store.positions[h] == m_publishedPositions[h] && m_store.rotations[h] == m_publishedRotations[h]
+            && m_store.scales[h] == m_publishedScales[h]) {
+            continue;
+        }
+        m_publishedPositions[h] = m_store.positions[h];
+        m_publishedRotations[h] = m_store.rotations[h];
+        m_publishedScales[h] = m_store.scales[h];
+        if (!m_unseenFlags[h]) {
+            m_unseenFlags[h] = 1;
+            m_unseenMoved.append(h);
+        }
+    }
+}
+
+void SimulationWorker::publishSnapshot()
+{
+    collectMoved();
+
+    SimulationSnapshot &snapshot = m_snapshots[m_writeSnapshot];
+    snapshot.commandSequence = m_appliedCommands;
+    copyInto(snapshot.positions, m_store.positions);
+    copyInto(snapshot.rotations, m_store.rotations);
+    copyInto(snapshot.scales, m_store.scales);
+    copyInto(snapshot.moved, m_unseenMoved);
+    snapshot.allMoved = m_unseenAll;
+    snapshot.collisionStats = m_collisionStats;
+    snapshot.averageStepTime = m_averageStepTime;
+
+    const int previous = m_readySnapshot.exchange(m_writeSnapshot | SNAPSHOT_FRESH, std::memory_order_acq_rel);
+    m_writeSnapshot = previous & SNAPSHOT_INDEX;
+}
+
+void SimulationWorker::run()
+{
+    QElapsedTimer clock;
+    clock.start();
+    qint64 previous = clock.nsecsElapsed();
+    double accumulator = 0.0;
+
+    while (!m_stopRequested.load(std::memory_order_acquire)) {
+        m_wakeup.tryAcquire(m_wakeup.available());
+        bool changed = processCommands();
+
+        // Timp real, consumat in pasi fixi; o pauza lunga nu produce o avalansa de pasi
+        const qint64 now = clock.nsecsElapsed();
+        accumulator += qMin(double(now - previous) * 1e-9, MAX_FRAME_TIME);
+        previous = now;
+
+        while (accumulator >= FIXED_STEP) {
+            step(FIXED_STEP);
+            accumulator -= FIXED_STEP;
+            changed = true;
+        }
+
+        if (isIdle()) {
+            // Comenzile noi (obiecte adaugate, podea mutata) sunt asezate printr-un ultim pas
+            if (!m_settled) {
+                step(FIXED_STEP);
+                changed = true;
+            }
+            if (changed) {
+                publishSnapshot();
+            }
+
+            // Nimic treaz si nimic animat: firul doarme pana la urmatorul post()
+            m_wakeup.acquire();
+            previous = clock.nsecsElapsed();
+            accumulator = 0.0;
+            continue;
+        }
+
+        if (changed) {
+            publishSnapshot();
+        }
+
+        const double remaining = FIXED_STEP - accumulator;
+        QThread::usleep(qMax<unsigned long>(1, (unsigned long)(remaining * 1e6)));
+    }
+}
+
+bool SimulationWorker::processCommands()
+{
+    bool applied = false;
+    SimulationCommand command;
+    while (m_commands.pop(command)) {
+        applyCommand(command);
+        ++m_appliedCommands;
+        applied = true;
+    }
+
+    if (applied) {
+        m_settled = false;
+        m_staticCellsDirty = true;
+    }
+    return applied;
+}
+
+void SimulationWorker::applyCommand(SimulationCommand &command)
+{
+    switch (command.type) {
+    case SimulationCommand::AddObject: {
+        const bool replaced = m_store.contains(command.object.id);
+        const SceneStore::Handle handle = m_store.add(command.object);
+        m_store.baseScales[handle] = command.baseScale;
+        m_store.scales[handle] = command.scale;
+        m_store.localBoundsMin[handle] = command.localBoundsMin;
+        m_store.localBoundsMax[handle] = command.localBoundsMax;
+        if (replaced) {
+            resolveOrbitalHandles();
+            rebuildAwakeList();
+        } else if (m_store.isDynamic(handle)) {
+            m_awakeObjects.append(handle);
+        }
+        break;
+    }
+    case SimulationCommand::RemoveObject: {
+        m_store.remove(m_store.handleOf(command.id));
+
+        // Elimina animatiile orbitale asociate
+        for (int i = m_orbitalAnimations.size() - 1; i >= 0; --i) {
+            if (m_orbitalAnimations[i].primaryObjectId == command.id ||
+                m_orbitalAnimations[i].referenceObjectId == command.id) {
+                m_orbitalAnimations.removeAt(i);
+            }
+        }
+
+        // Ultimul obiect a fost mutat in locul celui sters
+        resolveOrbitalHandles();
+        rebuildAwakeList();
+        break;
+    }
+    case SimulationCommand::Clear:
+        m_store.clear();
+        m_orbitalAnimations.clear();
+        rebuildAwakeList();
+        break;
+    case SimulationCommand::SetAnimationFlags: {
+        const SceneStore::Handle handle = m_store.handleOf(command.id);
+        if (handle != SceneStore::INVALID_HANDLE) {
+            m_animatedObjects += (command.animationFlags != 0) - (m_store.animationFlags[handle] != 0);
+            m_store.animationFlags[handle] = command.animationFlags;
+        }
+        break;
+    }
+    case SimulationCommand::AddOrbital:
+        m_orbitalAnimations.append(command.orbital);
+        resolveOrbitalHandles();
+        break;
+    case SimulationCommand::ClearOrbitals:
+        m_orbitalAnimations.clear();
+        break;
+    case SimulationCommand::SetFloorLevel:
+        m_floorLevel = command.value;
+
+        // Repozitionare obiecte daca e nevoie
+        for (SceneStore::Handle h = 0; h < m_store.size(); ++h) {
+            m_store.positions[h] = floorConstrainedPosition(m_store.positions[h], m_store.localBoundsMin[h]);
+        }
+        break;
+    case SimulationCommand::SetCollisionCellSize:
+        m_broadPhase.setCellSize(command.value);
+        break;
+    case SimulationCommand::SetAnimationsPaused:
+        m_animationsPaused = command.enabled;
+        break;
+    case SimulationCommand::SetPhysicsPaused:
+        m_physicsPaused = command.enabled;
+        break;
+    }
+}
+
+bool SimulationWorker::isIdle() const
+{
+    const bool physicsIdle = m_physicsPaused || m_awakeObjects.isEmpty();
+    const bool animationIdle = m_animationsPaused || (m_animatedObjects == 0 && m_orbitalAnimations.isEmpty());
+    return physicsIdle && animationIdle;
+}
+
+void SimulationWorker::wake(SceneStore::Handle handle)
+{
+    m_store.sleepTimers[handle] = 0.0f;
+    if (!m_store.isDynamic(handle)) {
+        m_store.setDynamic(handle, true);
+        m_awakeObjects.append(handle);
+        m_staticCellsDirty = true;
+    }
+}
+
+void SimulationWorker::rebuildAwakeList()
+{
+    // Dupa add/remove handle-urile se pot muta; lista si contoarele se refac din flag-uri
+    m_awakeObjects.resize(0);
+    m_animatedObjects = 0;
+    for (SceneStore::Handle h = 0; h < m_store.size(); ++h) {
+        if (m_store.isDynamic(h)) {
+            m_awakeObjects.append(h);
+        }
+        if (m_store.animationFlags[h]) {
+            ++m_animatedObjects;
+        }
+    }
+}
+
+int SimulationWorker::findIsland(int handle)
+{
+    while (m_islandParent[handle] != handle) {
+        m_islandParent[handle] = m_islandParent[m_islandParent[handle]];
+        handle = m_islandParent[handle];
+    }
+    return handle;
+}
+
+void SimulationWorker::uniteIslands(int a, int b)
+{
+    const int rootA = findIsland(a);
+    const int rootB = findIsland(b);
+    if (rootA != rootB) {
+        m_islandParent[qMax(rootA, rootB)] = qMin(rootA, rootB);
+    }
+}
+
+void SimulationWorker::updateSleeping()
+{
+    // O insula adoarme doar daca toti membrii ei sunt linistiti de suficient timp
+    for (SceneStore::Handle h : std::as_const(m_awakeObjects)) {
+        m_islandQuiet[findIsland(h)] = 1;
+    }
+    for (SceneStore::Handle h : std::as_const(m_awakeObjects)) {
+        if (m_store.sleepTimers[h] < TIME_TO_SLEEP) {
+            m_islandQuiet[findIsland(h)] = 0;
+        }
+    }
+
+    int kept = 0;
+    for (int i = 0; i < m_awakeObjects.size(); ++i) {
+        const SceneStore::Handle h = m_awakeObjects[i];
+        if (m_islandQuiet[findIsland(h)]) {
+            m_store.velocities[h] = QVector3D(0, 0, 0);
+            m_store.setDynamic(h, false);
+            m_staticCellsDirty = true;
+        } else {
+            m_awakeObjects[kept++] = h;
+        }
+    }
+    m_awakeObjects.resize(kept);
+}
+
+void SimulationWorker::resolveOrbitalHandles()
+{
+    for (OrbitalAnimation &orbital : m_orbitalAnimations) {
+        orbital.primaryHandle = m_store.handleOf(orbital.primaryObjectId);
+        orbital.referenceHandle = m_store.handleOf(orbital.referenceObjectId);
+    }
+}
+
+QVector3D SimulationWorker::floorConstrainedPosition(const QVector3D &position, const QVector3D &localBoundsMin) const
+{
+    QVector3D constrainedPos = position;
+    float minY = m_floorLevel - localBoundsMin.y() + 0.2f; // Putin deasupra podelei
+    if (constrainedPos.y() < minY) {
+        constrainedPos.setY(minY);
+    }
+    return constrainedPos;
+}
+
+void SimulationWorker::step(float deltaTime)
+{
+    QElapsedTimer stepTimer;
+    stepTimer.start();
+
+    if (!m_animationsPaused) {
+        updateAnimations(deltaTime);
+    }
+    if (!m_physicsPaused) {
+        updatePhysics(deltaTime);
+    }
+    m_settled = true;
+
+    // Costul mediu al unui pas, actualizat aproximativ o data pe secunda (publicat in snapshot)
+    m_stepNanoseconds += stepTimer.nsecsElapsed();
+    if (++m_stepCount == 60) {
+        m_averageStepTime = float(m_stepNanoseconds) / m_stepCount / 1000.0f;
+        m_stepNanoseconds = 0;
+        m_stepCount = 0;
+    }
+}
+
+void SimulationWorker::updateAnimations(float deltaTime)
+{
+    // Fazele si transformarile individuale sunt calculate pe loturi
+    SceneStore &store = m_store;
+    m_animationKernel.evaluate(store, deltaTime);
+
+    const float *offsetY = m_animationKernel.offsetY();
+    const float *scale = m_animationKernel.scale();
+    const float *rotationW = m_animationKernel.rotationW();
+    const float *rotationX = m_animationKernel.rotationX();
+    const float *rotationY = m_animationKernel.rotationY();
+    const float *rotationZ = m_animationKernel.rotationZ();
+
+    for (SceneStore::Handle h = 0; h < store.size(); ++h) {
+        QVector3D currentPosition = store.originalPositions[h];
+        currentPosition.setY(currentPosition.y() + offsetY[h]);
+
+        // Apply floor constraint to the final position
+        currentPosition = floorConstrainedPosition(currentPosition, store.localBoundsMin[h]);
+
+        store.positions[h] = currentPosition;
+        store.rotations[h] = QQuaternion(rotationW[h], rotationX[h], rotationY[h], rotationZ[h]);
+        store.scales[h] = scale[h];
+
+        store.boundsMin[h] = currentPosition + store.localBoundsMin[h];
+        store.boundsMax[h] = currentPosition + store.localBoundsMax[h];
+    }
+
+    // Update orbital animations (these override position but preserve other animations)
+    for (OrbitalAnimation &orbital : m_orbitalAnimations) {
+        const SceneStore::Handle primary = orbital.primaryHandle;
+        const SceneStore::Handle reference = orbital.referenceHandle;
+        if (primary == SceneStore::INVALID_HANDLE || reference == SceneStore::INVALID_HANDLE)
+            continue;
+
+        orbital.currentAngle += orbital.speed * deltaTime;
+        if (orbital.currentAngle > 2.0f * M_PI) {
+            orbital.currentAngle -= 2.0f * M_PI;
+        }
+
+        const QVector3D &referencePosition = store.positions[reference];
+        float x = referencePosition.x() + qCos(orbital.currentAngle) * orbital.radius;
+        float z = referencePosition.z() + qSin(orbital.currentAngle) * orbital.radius;
+        float y = referencePosition.y(); // Maintain same height as reference
+
+        QVector3D newOrbitalPosition(x, y, z);
+
+        // Apply collision avoidance for orbital objects
+        const float primaryRadius = store.radii[primary];
+        for (SceneStore::Handle other = 0; other < store.size(); ++other) {
+            if (other == primary || other == reference)
+                continue;
+
+            const float distance = newOrbitalPosition.distanceToPoint(store.positions[other]);
+            if (distance < primaryRadius + store.radii[other]) {
+                newOrbitalPosition.setY(newOrbitalPosition.y() + primaryRadius * 2.0f);
+                break;
+            }
+        }
+
+        // Update the original position for orbital objects so other animations work from orbital position
+        store.originalPositions[primary] = newOrbitalPosition;
+        store.positions[primary] = newOrbitalPosition;
+
+        store.boundsMin[primary] = newOrbitalPosition + store.localBoundsMin[primary];
+        store.boundsMax[primary] = newOrbitalPosition + store.localBoundsMax[primary];
+    }
+}
+
+void SimulationWorker::updatePhysics(float deltaTime)
+{
+    const float damping = 0.98f;
+    const float minVelocity = 0.01f;
+
+    // Doar obiectele treze; cele adormite nu costa nimic
+    SceneStore &store = m_store;
+    for (SceneStore::Handle h : std::as_const(m_awakeObjects)) {
+        QVector3D &velocity = store.velocities[h];
+
+        // Aplicare gravitatie
+        velocity.setY(velocity.y() + GRAVITY * deltaTime);
+
+        // Update pozitie
+        QVector3D newPosition = store.positions[h] + velocity * deltaTime;
+
+        // Verificare coliziune cu podea
+        float minY = m_floorLevel - store.localBoundsMin[h].y() + 0.1f;
+        if (newPosition.y() <= minY) {
+            newPosition.setY(minY);
+            velocity.setY(-velocity.y() * 0.6f); // Bounce cu pierdere de energie
+
+            // Oprire daca viteza este prea mica
+            if (qAbs(velocity.y()) < minVelocity) {
+                velocity.setY(0);
+            }
+        }
+
+        // Aplicare damping
+        velocity *= damping;
+
+        // Oprire daca viteza este prea mica
+        if (velocity.length() < minVelocity) {
+            velocity = QVector3D(0, 0, 0);
+        }
+
+        // Obiectul adoarme odata cu insula lui (vezi updateSleeping)
+        if (velocity.length() < SLEEP_VELOCITY) {
+            store.sleepTimers[h] += deltaTime;
+        } else {
+            store.sleepTimers[h] = 0.0f;
+        }
+
+        store.positions[h] = newPosition;
+        store.boundsMin[h] = newPosition + store.localBoundsMin[h];
+        store.boundsMax[h] = newPosition + store.localBoundsMax[h];
+    }
+
+    // Verificare coliziuni intre obiecte, apoi adorm insulele linistite
+    checkObjectCollisions();
+    if (!m_awakeObjects.isEmpty()) {
+        updateSleeping();
+    }
+    m_collisionStats.awakeObjects = m_awakeObjects.size();
+}
+
+void SimulationWorker::checkObjectCollisions()
+{
+    m_collisionStats = CollisionStats();
+
+    // Perechile statice nu produc nimic; fara obiecte dinamice nu avem ce verifica
+    SceneStore &store = m_store;
+    m_collisionStats.objects = store.size();
+    if (m_awakeObjects.isEmpty()) {
+        return;
+    }
+
+    // Fiecare obiect incepe ca propria insula; contactele le unesc
+    m_islandParent.resize(store.size());
+    m_islandQuiet.resize(store.size());
+    for (int h = 0; h < store.size(); ++h) {
+        m_islandParent[h] = h;
+    }
+
+    // Broad-phase: doar obiectele care impart o celula a grilei ajung la testul exact.
+    // Handle-urile sunt dense, deci sunt folosite direct ca indecsi in grila. Obiectele care
+    // stau pe loc raman in stratul static; la fiecare pas sunt inserate doar cele treze si
+    // cele mutate de animatii, care isi cauta vecinii statici in grila pastrata.
+    if (m_staticCellsDirty) {
+        rebuildStaticCells();
+    }
+    m_broadPhase.clear();
+    auto insertMoving = [&store, this](SceneStore::Handle h) {
+        const float radius = store.radii[h];
+        const QVector3D extent(radius, radius, radius);
+        m_broadPhase.insert(h, store.positions[h] - extent, store.positions[h] + extent);
+    };
+    for (SceneStore::Handle h : std::as_const(m_awakeObjects)) {
+        insertMoving(h);
+    }
+    for (SceneStore::Handle h : std::as_const(m_animatedStatic)) {
+        insertMoving(h);
+    }
+    m_broadPhase.collectPairs(m_collisionPairs);
+    m_collisionStats.candidatePairs = m_collisionPairs.size();
+
+    for (const QPair<int, int> &pair : std::as_const(m_collisionPairs)) {
+        const SceneStore::Handle a = pair.first;
+        const SceneStore::Handle b = pair.second;
+        const bool dynamicA = store.isDynamic(a);
+        const bool dynamicB = store.isDynamic(b);
+
+        // Un obiect lovit devine dinamic in timpul buclei, deci verificam la fiecare pereche
+        if (!dynamicA && !dynamicB) {
+            continue;
+        }
+
+        ++m_collisionStats.narrowPhaseTests;
+
+        // Verificare coliziune sphere
+        if (checkSphereCollision(a, b)) {
+            ++m_collisionStats.contacts;
+
+            // Un obiect treaz trezeste unul adormit doar daca inca se misca; altfel
+            // ar ramane sprijinit de el si l-ar trezi la fiecare pas
+            if (dynamicA && !dynamicB) {
+                if (store.sleepTimers[a] == 0.0f) {
+                    applyImpulse(b, a);
+                    uniteIslands(a, b);
+                }
+            }
+            else if (dynamicB && !dynamicA) {
+                if (store.sleepTimers[b] == 0.0f) {
+                    applyImpulse(a, b);
+                    uniteIslands(a, b);
+                }
+            }
+            else {
+                uniteIslands(a, b);
+
+                // Ambele dinamice - schimb de impuls
+                QVector3D direction = store.positions[b] - store.positions[a];
+                direction.normalize();
+
+                QVector3D relativeVelocity = store.velocities[a] - store.velocities[b];
+                float velocityAlongNormal = QVector3D::dotProduct(relativeVelocity, direction);
+
+                if (velocityAlongNormal > 0) continue; // Obiectele se indeparteaza
+
+                float impulse = 2 * velocityAlongNormal / 2; // Masa egala pentru simplitate
+                QVector3D impulseVector = direction * impulse;
+
+                store.velocities[a] -= impulseVector;
+                store.velocities[b] += impulseVector;
+            }
+        }
+    }
+}
+
+void SimulationWorker::rebuildStaticCells()
+{
+    // Obiectele animate (inclusiv cele orbitale) se misca la fiecare pas, deci raman in stratul mobil
+    const SceneStore &store = m_store;
+    QVector<quint8> animated(store.size(), 0);
+    for (SceneStore::Handle h = 0; h < store.size(); ++h) {
+        animated[h] = store.animationFlags[h] != 0;
+    }
+    for (const OrbitalAnimation &orbital : std::as_const(m_orbitalAnimations)) {
+        if (orbital.primaryHandle != SceneStore::INVALID_HANDLE) {
+            animated[orbital.primaryHandle] = 1;
+        }
+    }
+
+    m_animatedStatic.resize(0);
+    m_broadPhase.clearStatic();
+    for (SceneStore::Handle h = 0; h < store.size(); ++h) {
+        if (store.isDynamic(h)) {
+            continue;
+        }
+        if (animated[h]) {
+            m_animatedStatic.append(h);
+            continue;
+        }
+        const float radius = store.radii[h];
+        const QVector3D extent(radius, radius, radius);
+        m_broadPhase.insertStatic(h, store.positions[h] - extent, store.positions[h] + extent);
+    }
+    m_broadPhase.finishStatic();
+    m_staticCellsDirty = false;
+}
+
+bool SimulationWorker::checkSphereCollision(SceneStore::Handle obj1, SceneStore::Handle obj2) const
+{
+    float distance = m_store.positions[obj1].distanceToPoint(m_store.positions[obj2]);
+    return distance < (m_store.radii[obj1] + m_store.radii[obj2]);
+}
+
+void SimulationWorker::applyImpulse(SceneStore::Handle staticObj, SceneStore::Handle dynamicObj)
+{
+    QVector3D direction = m_store.positions[staticObj] - m_store.positions[dynamicObj];
+    direction.normalize();
+
+    wake(staticObj); // Devine dinamic pana adoarme din nou
+    m_store.velocities[staticObj] += direction * IMPULSE_STRENGTH;
+}
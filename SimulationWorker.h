@@ -0,0 +1,184 @@
+#ifndef SIMULATIONWORKER_H
+#define SIMULATIONWORKER_H
+
+#include <QPair>
+#include <QQuaternion>
+#include <QSemaphore>
+#include <QThread>
+#include <QVector>
+#include <atomic>
+
+#include "AnimationKernel.h"
+#include "SceneStore.h"
+#include "SpatialHash.h"
+#include "SpscQueue.h"
+
+// Statistici pentru ultimul pas de coliziuni
+struct CollisionStats {
+    int objects = 0;
+    int candidatePairs = 0;   // perechi raportate de broad-phase
+    int narrowPhaseTests = 0; // perechi cu cel putin un obiect dinamic
+    int contacts = 0;
+    int awakeObjects = 0;     // obiecte dinamice care nu dorm
+};
+
+// Orbiting animation struct
+struct OrbitalAnimation {
+    QString primaryObjectId;
+    QString referenceObjectId;
+    QString animationType;
+    float radius;
+    float speed;
+    float currentAngle;
+    QString description;
+    // Rezolvate din id-uri la adaugare si dupa fiecare stergere din SceneStore
+    SceneStore::Handle primaryHandle;
+    SceneStore::Handle referenceHandle;
+
+    OrbitalAnimation() : radius(3.0f), speed(1.0f), currentAngle(0.0f),
+                         primaryHandle(SceneStore::INVALID_HANDLE), referenceHandle(SceneStore::INVALID_HANDLE) {}
+};
+
+// Editare a scenei trimisa din GUI thread catre firul de simulare
+struct SimulationCommand {
+    enum Type {
+        AddObject,
+        RemoveObject,
+        Clear,
+        SetAnimationFlags,
+        AddOrbital,
+        ClearOrbitals,
+        SetFloorLevel,
+        SetCollisionCellSize,
+        SetAnimationsPaused,
+        SetPhysicsPaused
+    };
+
+    Type type = Clear;
+    QString id;
+    SceneObject object;          // AddObject (entity/transform nu sunt folosite de simulare)
+    float baseScale = 1.0f;      // AddObject
+    float scale = 1.0f;          // AddObject: scala initiala a transformarii
+    QVector3D localBoundsMin;    // AddObject
+    QVector3D localBoundsMax;    // AddObject
+    quint8 animationFlags = 0;   // SetAnimationFlags
+    OrbitalAnimation orbital;    // AddOrbital
+    float value = 0.0f;          // SetFloorLevel, SetCollisionCellSize
+    bool enabled = false;        // SetAnimationsPaused, SetPhysicsPaused
+};
+
+// Rezultatul unui pas de simulare, indexat dupa handle-urile din SceneStore
+struct SimulationSnapshot {
+    quint64 commandSequence = 0; // cate comenzi erau aplicate cand a fost produs
+    QVector<QVector3D> positions;
+    QVector<QQuaternion> rotations;
+    QVector<float> scales;
+    // Obiectele mutate de la ultimul snapshot preluat de GUI; allMoved dupa o schimbare a
+    // numarului de obiecte (handle-urile se pot fi mutat)
+    QVector<SceneStore::Handle> moved;
+    bool allMoved = true;
+    CollisionStats collisionStats;
+    float averageStepTime = 0.0f; // microsecunde
+};
+
+// Fir dedicat pentru animatii si fizica, cu pas fix si timp real masurat.
+// GUI thread-ul nu atinge starea simularii: trimite editari prin post() (coada fara blocari)
+// si preia cel mai recent snapshot cu takeSnapshot(). Snapshot-urile folosesc trei buffere
+// care se rotesc printr-un index atomic, deci nici publicarea, nici citirea nu se blocheaza.
+// Simularea tine propria copie a SceneStore; handle-urile raman aceleasi ca in GUI pentru ca
+// ambele parti aplica aceleasi add/remove in aceeasi ordine.
+//
+// Fizica parcurge doar lista obiectelor treze. Obiectele care se ating formeaza insule care
+// adorm impreuna cand toti membrii au stat linistiti TIME_TO_SLEEP secunde; un obiect treaz
+// care loveste unul adormit il trezeste. Cand nimic nu e treaz si nimic nu e animat, firul
+// asteapta blocat urmatoarea comanda (post() il trezeste), deci scena inactiva nu consuma CPU.
+class SimulationWorker : public QThread
+{
+public:
+    explicit SimulationWorker(QObject *parent = nullptr);
+    ~SimulationWorker() override;
+
+    // Doar din GUI thread
+    void post(SimulationCommand command);
+    quint64 postedCommandCount() const { return m_postedCommands; }
+    // Cel mai recent snapshot nepreluat inca, sau nullptr; ramane valid pana la urmatorul apel
+    const SimulationSnapshot *takeSnapshot();
+    void stop();
+
+    static constexpr float FIXED_STEP = 1.0f / 60.0f;
+
+protected:
+    void run() override;
+
+private:
+    bool processCommands();
+    void applyCommand(SimulationCommand &command);
+    void step(float deltaTime);
+    bool isIdle() const;
+    void wake(SceneStore::Handle handle);
+    void rebuildAwakeList();
+    void updateSleeping();
+    int findIsland(int handle);
+    void uniteIslands(int a, int b);
+    void updateAnimations(float deltaTime);
+    void updatePhysics(float deltaTime);
+    void rebuildStaticCells();
+    void checkObjectCollisions();
+    bool checkSphereCollision(SceneStore::Handle obj1, SceneStore::Handle obj2) const;
+    void applyImpulse(SceneStore::Handle staticObj, SceneStore::Handle dynamicObj);
+    QVector3D floorConstrainedPosition(const QVector3D &position, const QVector3D &localBoundsMin) const;
+    void resolveOrbitalHandles();
+    void collectMoved();
+    void publishSnapshot();
+
+    // Partea GUI
+    SpscQueue<SimulationCommand> m_commands;
+    quint64 m_postedCommands;
+    std::atomic<bool> m_stopRequested;
+    QSemaphore m_wakeup; // eliberat la fiecare post(), asteptat cand simularea e inactiva
+
+    // Starea firului de simulare
+    quint64 m_appliedCommands;
+    SceneStore m_store;
+    QVector<OrbitalAnimation> m_orbitalAnimations;
+    QVector<SceneStore::Handle> m_awakeObjects;
+    QVector<int> m_islandParent;   // union-find peste contactele pasului curent
+    QVector<quint8> m_islandQuiet; // per radacina: toti membrii pot adormi
+    int m_animatedObjects;
+    bool m_settled;                // a rulat un pas dupa ultimele comenzi
+    AnimationKernel m_animationKernel;
+    SpatialHash m_broadPhase;
+    // Stratul static al grilei (obiecte adormite sau statice, neanimate) trebuie refacut:
+    // dupa comenzi, cand un obiect se trezeste sau cand o insula adoarme
+    bool m_staticCellsDirty;
+    QVector<SceneStore::Handle> m_animatedStatic; // animate si nedinamice, mutate de animatii
+    QVector<QPair<int, int>> m_collisionPairs;
+    CollisionStats m_collisionStats;
+    float m_floorLevel;
+    bool m_animationsPaused;
+    bool m_physicsPaused;
+    qint64 m_stepNanoseconds;
+    int m_stepCount;
+    float m_averageStepTime;
+
+    // Trei buffere: unul scris de simulare, unul citit de GUI, unul gata de preluat
+    SimulationSnapshot m_snapshots[3];
+    std::atomic<int> m_readySnapshot; // index | SNAPSHOT_FRESH
+    // Starea trimisa ultima oara si obiectele mutate pe care GUI-ul nu le-a vazut inca
+    QVector<QVector3D> m_publishedPositions;
+    QVector<QQuaternion> m_publishedRotations;
+    QVector<float> m_publishedScales;
+    QVector<SceneStore::Handle> m_unseenMoved;
+    QVector<quint8> m_unseenFlags;
+    bool m_unseenAll;
+    int m_writeSnapshot;
+    int m_readSnapshot;
+
+    static constexpr float GRAVITY = -9.81f;
+    static constexpr float IMPULSE_STRENGTH = 2.0f;
+    static constexpr float SLEEP_VELOCITY = 0.25f;
+    static constexpr float TIME_TO_SLEEP = 0.5f;
+    static constexpr double MAX_FRAME_TIME = 0.25; // secunde recuperate dupa o pauza lunga
+};
+
+#endif // SIMULATIONWORKER_H
@@ -0,0 +1,196 @@
+#include "SpatialHash.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Coordonatele de celula sunt impachetate pe 21 de biti fiecare
+const int CELL_BITS = 21;
+const int CELL_OFFSET = 1 << (CELL_BITS - 1);
+const quint64 CELL_MASK = (quint64(1) << CELL_BITS) - 1;
+
+// Obiectele mai mari de atat nu umplu grila; sunt testate separat cu toate celelalte
+const int MAX_CELLS_PER_AXIS = 16;
+
+struct CellLess {
+    template <typename Entry>
+    bool operator()(const Entry &entry, quint64 cell) const { return entry.cell < cell; }
+    template <typename Entry>
+    bool operator()(quint64 cell, const Entry &entry) const { return cell < entry.cell; }
+};
+
+} // namespace
+
+SpatialHash::SpatialHash(float cellSize)
+    : m_cellSize(1.0f), m_inverseCellSize(1.0f), m_occupiedCells(0)
+{
+    setCellSize(cellSize);
+}
+
+void SpatialHash::setCellSize(float cellSize)
+{
+    m_cellSize = qMax(0.01f, cellSize);
+    m_inverseCellSize = 1.0f / m_cellSize;
+    clear();
+    clearStatic();
+}
+
+void SpatialHash::clearStatic()
+{
+    m_staticEntries.resize(0);
+    m_staticObjects.resize(0);
+    m_staticOversized.resize(0);
+}
+
+void SpatialHash::clear()
+{
+    // Capacitatea vectorilor este pastrata intre cadre
+    m_entries.resize(0);
+    m_movingObjects.resize(0);
+    m_oversized.resize(0);
+    m_occupiedCells = 0;
+}
+
+int SpatialHash::cellCoordinate(float value) const
+{
+    const int cell = int(std::floor(value * m_inverseCellSize));
+    return qBound(-CELL_OFFSET, cell, CELL_OFFSET - 1);
+}
+
+quint64 SpatialHash::packCell(int x, int y, int z)
+{
+    return (quint64(x + CELL_OFFSET) & CELL_MASK) << (2 * CELL_BITS)
+         | (quint64(y + CELL_OFFSET) & CELL_MASK) << CELL_BITS
+         | (quint64(z + CELL_OFFSET) & CELL_MASK);
+}
+
+bool SpatialHash::assignCells(int index, const QVector3D &minBounds, const QVector3D &maxBounds)
+{
+    if (index >= m_objectCells.size()) {
+        m_objectCells.resize(index + 1);
+    }
+
+    CellRange &range = m_objectCells[index];
+    range.minX = cellCoordinate(minBounds.x());
+    range.minY = cellCoordinate(minBounds.y());
+    range.minZ = cellCoordinate(minBounds.z());
+    range.maxX = cellCoordinate(maxBounds.x());
+    range.maxY = cellCoordinate(maxBounds.y());
+    range.maxZ = cellCoordinate(maxBounds.z());
+
+    return range.maxX - range.minX < MAX_CELLS_PER_AXIS
+        && range.maxY - range.minY < MAX_CELLS_PER_AXIS
+        && range.maxZ - range.minZ < MAX_CELLS_PER_AXIS;
+}
+
+void SpatialHash::appendEntries(int index, QVector<Entry> &entries) const
+{
+    const CellRange &range = m_objectCells[index];
+    for (int x = range.minX; x <= range.maxX; ++x) {
+        for (int y = range.minY; y <= range.maxY; ++y) {
+            for (int z = range.minZ; z <= range.maxZ; ++z) {
+                entries.append({ packCell(x, y, z), index });
+            }
+        }
+    }
+}
+
+bool SpatialHash::isFirstCommonCell(int i, int j, quint64 cell) const
+{
+    // Perechea se raporteaza doar in prima celula comuna (coltul minim al intersectiei)
+    const CellRange &rangeI = m_objectCells[i];
+    const CellRange &rangeJ = m_objectCells[j];
+    const int cellX = int((cell >> (2 * CELL_BITS)) & CELL_MASK) - CELL_OFFSET;
+    const int cellY = int((cell >> CELL_BITS) & CELL_MASK) - CELL_OFFSET;
+    const int cellZ = int(cell & CELL_MASK) - CELL_OFFSET;
+    return qMax(rangeI.minX, rangeJ.minX) == cellX
+        && qMax(rangeI.minY, rangeJ.minY) == cellY
+        && qMax(rangeI.minZ, rangeJ.minZ) == cellZ;
+}
+
+void SpatialHash::insertStatic(int index, const QVector3D &minBounds, const QVector3D &maxBounds)
+{
+    m_staticObjects.append(index);
+    if (!assignCells(index, minBounds, maxBounds)) {
+        m_staticOversized.append(index);
+        return;
+    }
+    appendEntries(index, m_staticEntries);
+}
+
+void SpatialHash::finishStatic()
+{
+    std::sort(m_staticEntries.begin(), m_staticEntries.end());
+}
+
+void SpatialHash::insert(int index, const QVector3D &minBounds, const QVector3D &maxBounds)
+{
+    m_movingObjects.append(index);
+    if (!assignCells(index, minBounds, maxBounds)) {
+        m_oversized.append(index);
+        return;
+    }
+    appendEntries(index, m_entries);
+}
+
+void SpatialHash::collectPairs(QVector<QPair<int, int>> &pairs)
+{
+    pairs.resize(0);
+    std::sort(m_entries.begin(), m_entries.end());
+
+    m_occupiedCells = 0;
+    int runStart = 0;
+    while (runStart < m_entries.size()) {
+        const quint64 cell = m_entries[runStart].cell;
+        int runEnd = runStart + 1;
+        while (runEnd < m_entries.size() && m_entries[runEnd].cell == cell) {
+            ++runEnd;
+        }
+        ++m_occupiedCells;
+
+        // Mobil - mobil
+        for (int a = runStart; a < runEnd; ++a) {
+            const int i = m_entries[a].index;
+            for (int b = a + 1; b < runEnd; ++b) {
+                const int j = m_entries[b].index;
+                if (isFirstCommonCell(i, j, cell)) {
+                    pairs.append(qMakePair(i, j)); // i < j, intrarile sunt sortate dupa index
+                }
+            }
+        }
+
+        // Mobil - static: aceeasi celula cautata binar in stratul static
+        const auto statics = std::equal_range(m_staticEntries.cbegin(), m_staticEntries.cend(), cell, CellLess());
+        for (auto s = statics.first; s != statics.second; ++s) {
+            const int j = s->index;
+            for (int a = runStart; a < runEnd; ++a) {
+                const int i = m_entries[a].index;
+                if (isFirstCommonCell(i, j, cell)) {
+                    pairs.append(qMakePair(qMin(i, j), qMax(i, j)));
+                }
+            }
+        }
+        runStart = runEnd;
+    }
+
+    // Obiectele prea mari: un mobil mare cu toate celelalte, un static mare cu mobilele obisnuite
+    for (int o = 0; o < m_oversized.size(); ++o) {
+        const int big = m_oversized[o];
+        for (int other : std::as_const(m_movingObjects)) {
+            if (other == big || (m_oversized.contains(other) && other < big)) {
+                continue;
+            }
+            pairs.append(qMakePair(qMin(big, other), qMax(big, other)));
+        }
+        for (int other : std::as_const(m_staticObjects)) {
+            pairs.append(qMakePair(qMin(big, other), qMax(big, other)));
+        }
+    }
+    for (int big : std::as_const(m_staticOversized)) {
+        for (int other : std::as_const(m_movingObjects)) {
+            if (!m_oversized.contains(other)) {
+                pairs.append(qMakePair(qMin(big, other), qMax(big, other)));
+            }
+        }
+    }
+}
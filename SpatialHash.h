@@ -0,0 +1,78 @@
+#ifndef SPATIALHASH_H
+#define SPATIALHASH_H
+
+#include <QPair>
+#include <QVector>
+#include <QVector3D>
+
+// Broad-phase pentru coliziuni: grila uniforma cu celule de dimensiune configurabila.
+// Fiecare obiect este inregistrat in toate celulele atinse de volumul sau; perechile candidate
+// sunt obiectele care impart cel putin o celula. Celulele sunt chei sortate intr-un vector
+// (fara alocari per celula), iar fiecare pereche este raportata o singura data, in prima
+// celula comuna a celor doua obiecte.
+// Obiectele sunt impartite in doua straturi: cel static (obiecte care stau pe loc: statice sau
+// adormite) este sortat o singura data si pastrat intre pasi, cel mobil este refacut la fiecare
+// pas. Perechile intre doua obiecte statice nu sunt raportate (nu pot produce nimic); un obiect
+// mobil gaseste vecinii statici prin cautare binara in stratul static.
+class SpatialHash
+{
+public:
+    explicit SpatialHash(float cellSize = 4.0f);
+
+    // Goleste ambele straturi (celulele vechi nu mai corespund)
+    void setCellSize(float cellSize);
+    float cellSize() const { return m_cellSize; }
+
+    // Stratul static: clearStatic, insertStatic pentru fiecare obiect, apoi finishStatic
+    void clearStatic();
+    void insertStatic(int index, const QVector3D &minBounds, const QVector3D &maxBounds);
+    void finishStatic();
+
+    // Stratul mobil, refacut la fiecare pas; un index apare intr-un singur strat
+    void clear();
+    void insert(int index, const QVector3D &minBounds, const QVector3D &maxBounds);
+
+    // Perechile (i, j) cu i < j care impart o celula si au cel putin un obiect mobil
+    void collectPairs(QVector<QPair<int, int>> &pairs);
+
+    int objectCount() const { return m_movingObjects.size() + m_staticObjects.size(); }
+    int staticObjectCount() const { return m_staticObjects.size(); }
+    // Celulele ocupate de stratul mobil la ultimul collectPairs
+    int occupiedCellCount() const { return m_occupiedCells; }
+
+private:
+    struct CellRange {
+        int minX, minY, minZ;
+        int maxX, maxY, maxZ;
+    };
+
+    struct Entry {
+        quint64 cell;
+        int index;
+
+        bool operator<(const Entry &other) const
+        {
+            return cell < other.cell || (cell == other.cell && index < other.index);
+        }
+    };
+
+    int cellCoordinate(float value) const;
+    static quint64 packCell(int x, int y, int z);
+    // Intervalul de celule al obiectului; false daca obiectul este prea mare pentru grila
+    bool assignCells(int index, const QVector3D &minBounds, const QVector3D &maxBounds);
+    void appendEntries(int index, QVector<Entry> &entries) const;
+    bool isFirstCommonCell(int i, int j, quint64 cell) const;
+
+    float m_cellSize;
+    float m_inverseCellSize;
+    QVector<CellRange> m_objectCells; // indexat dupa obiect, pentru ambele straturi
+    QVector<Entry> m_entries;
+    QVector<int> m_movingObjects;
+    QVector<int> m_oversized;
+    QVector<Entry> m_staticEntries;
+    QVector<int> m_staticObjects;
+    QVector<int> m_staticOversized;
+    int m_occupiedCells;
+};
+
+#endif // SPATIALHASH_H
@@ -0,0 +1,66 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <utility>
+
+// Coada fara blocari pentru un singur producator si un singur consumator.
+// Lista inlantuita cu nod santinela: producatorul scrie doar coada listei, consumatorul
+// doar capul, iar legatura dintre ele este un pointer atomic publicat cu release/acquire.
+// Nu are capacitate fixa; un nod este alocat la fiecare push, deci este potrivita pentru
+// mesaje rare (editari ale scenei), nu pentru date per cadru.
+template <typename T>
+class SpscQueue
+{
+public:
+    SpscQueue()
+        : m_head(new Node), m_tail(m_head)
+    {
+    }
+
+    ~SpscQueue()
+    {
+        while (m_head) {
+            Node *next = m_head->next.load(std::memory_order_relaxed);
+            delete m_head;
+            m_head = next;
+        }
+    }
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    // Doar din firul producator
+    void push(T value)
+    {
+        Node *node = new Node;
+        node->value = std::move(value);
+        m_tail->next.store(node, std::memory_order_release);
+        m_tail = node;
+    }
+
+    // Doar din firul consumator
+    bool pop(T &value)
+    {
+        Node *next = m_head->next.load(std::memory_order_acquire);
+        if (!next) {
+            return false;
+        }
+
+        value = std::move(next->value);
+        delete m_head;
+        m_head = next; // next devine noua santinela
+        return true;
+    }
+
+private:
+    struct Node {
+        T value;
+        std::atomic<Node *> next{ nullptr };
+    };
+
+    Node *m_head; // consumator
+    Node *m_tail; // producator
+};
+
+#endif // SPSCQUEUE_H
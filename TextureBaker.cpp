@@ -0,0 +1,583 @@
+#include "TextureBaker.h"
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QImageReader>
+#include <QOpenGLTexture>
+#include <QSaveFile>
+#include <QtEndian>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+namespace {
+
+const char KTX_IDENTIFIER[12] = { '\xAB', 'K', 'T', 'X', ' ', '1', '1', '\xBB', '\r', '\n', '\x1A', '\n' };
+const int KTX_HEADER_SIZE = 64;
+const quint32 KTX_ENDIANNESS = 0x04030201;
+
+const quint32 GL_UNSIGNED_BYTE_ = 0x1401;
+const quint32 GL_RED_ = 0x1903;
+const quint32 GL_RGB_ = 0x1907;
+const quint32 GL_RGBA_ = 0x1908;
+const quint32 GL_RGBA8_ = 0x8058;
+const quint32 GL_COMPRESSED_RGB_S3TC_DXT1 = 0x83F0;
+const quint32 GL_COMPRESSED_RED_RGTC1 = 0x8DBB;
+
+// Offset-ul campului bytesOfKeyValueData in antet
+const int KTX_KEY_VALUE_BYTES_OFFSET = 60;
+// Nicio textura a proiectului nu trece de atat; un antet cu dimensiuni mai mari este corupt
+const int MAX_DIMENSION = 16384;
+
+// Se incrementeaza cand se schimba encoder-ul; fisierele vechi sunt recoapte
+const QByteArray BAKER_VERSION = "1";
+
+typedef QHash<QByteArray, QByteArray> KeyValues;
+
+quint32 internalFormatFor(TextureBaker::Encoding encoding)
+{
+    switch (encoding) {
+    case TextureBaker::Encoding::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1;
+    case TextureBaker::Encoding::BC4: return GL_COMPRESSED_RED_RGTC1;
+    case TextureBaker::Encoding::RGBA8: break;
+    }
+    return GL_RGBA8_;
+}
+
+bool isKnownFormat(quint32 internalFormat)
+{
+    return internalFormat == GL_COMPRESSED_RGB_S3TC_DXT1 || internalFormat == GL_COMPRESSED_RED_RGTC1
+           || internalFormat == GL_RGBA8_;
+}
+
+// Dimensiunea exacta a unui nivel: blocuri 4x4 de 8 octeti (BC1, BC4) sau 4 octeti / pixel
+qint64 levelByteCount(quint32 internalFormat, int width, int height)
+{
+    if (internalFormat == GL_RGBA8_) {
+        return qint64(width) * height * 4;
+    }
+    return qint64((width + 3) / 4) * ((height + 3) / 4) * 8;
+}
+
+Qt3DRender::QAbstractTexture::TextureFormat textureFormatFor(quint32 internalFormat)
+{
+    switch (internalFormat) {
+    case GL_COMPRESSED_RGB_S3TC_DXT1: return Qt3DRender::QAbstractTexture::RGB_DXT1;
+    case GL_COMPRESSED_RED_RGTC1: return Qt3DRender::QAbstractTexture::R_ATI1N_UNorm;
+    default: break;
+    }
+    return Qt3DRender::QAbstractTexture::RGBA8_UNorm;
+}
+
+void appendUInt32(QByteArray &out, quint32 value)
+{
+    const quint32 le = qToLittleEndian(value);
+    out.append(reinterpret_cast<const char *>(&le), sizeof(le));
+}
+
+quint32 readUInt32(const char *data)
+{
+    return qFromLittleEndian<quint32>(data);
+}
+
+void appendPadding(QByteArray &out)
+{
+    while (out.size() % 4 != 0) {
+        out.append('\0');
+    }
+}
+
+QByteArray sourceHash(const QString &sourcePath)
+{
+    QFile file(sourcePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(&file);
+    return hash.result().toHex();
+}
+
+// Un nivel de mipmap ca imagine separata; datele compresate sunt urcate pe GPU asa cum sunt
+Qt3DRender::QTextureImageDataPtr makeLevel(int width, int height, quint32 internalFormat, const QByteArray &bytes)
+{
+    auto data = Qt3DRender::QTextureImageDataPtr::create();
+
+    if (internalFormat == GL_RGBA8_) {
+        QImage image(width, height, QImage::Format_RGBA8888);
+        const int rowBytes = width * 4;
+        for (int y = 0; y < height; ++y) {
+            std::memcpy(image.scanLine(y), bytes.constData() + y * rowBytes, rowBytes);
+        }
+        data->setImage(image);
+        return data;
+    }
+
+    data->setTarget(QOpenGLTexture::Target2D);
+    data->setFormat(static_cast<QOpenGLTexture::TextureFormat>(internalFormat));
+    data->setWidth(width);
+    data->setHeight(height);
+    data->setDepth(1);
+    data->setLayers(1);
+    data->setFaces(1);
+    data->setMipLevels(1);
+    data->setData(bytes, 8, true);
+    return data;
+}
+
+// Citeste antetul, perechile cheie/valoare si (optional) nivelurile unui fisier KTX scris de noi
+bool readKtx(const QString &filePath, KeyValues &keyValues, DecodedTexture *texture)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const QByteArray header = file.read(KTX_HEADER_SIZE);
+    if (header.size() != KTX_HEADER_SIZE
+        || std::memcmp(header.constData(), KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER)) != 0
+        || readUInt32(header.constData() + 12) != KTX_ENDIANNESS) {
+        return false;
+    }
+
+    const char *fields = header.constData() + 16;
+    const quint32 internalFormat = readUInt32(fields + 12);
+    const quint32 width = readUInt32(fields + 20);
+    const quint32 height = readUInt32(fields + 24);
+    const quint32 mipLevels = readUInt32(fields + 40);
+    const quint32 keyValueBytes = readUInt32(fields + 44);
+
+    // Campurile antetului sunt verificate inainte de orice alocare pe baza lor
+    quint32 maxLevels = 1;
+    while ((qMax(width, height) >> maxLevels) > 0) {
+        ++maxLevels;
+    }
+    if (!isKnownFormat(internalFormat) || width == 0 || height == 0 || width > quint32(MAX_DIMENSION)
+        || height > quint32(MAX_DIMENSION) || mipLevels == 0 || mipLevels > maxLevels
+        || keyValueBytes > quint64(file.size() - KTX_HEADER_SIZE)) {
+        return false;
+    }
+
+    const QByteArray keyValueData = file.read(keyValueBytes);
+    if (quint32(keyValueData.size()) != keyValueBytes) {
+        return false;
+    }
+    for (int offset = 0; offset + 4 <= keyValueData.size();) {
+        const quint32 pairSize = readUInt32(keyValueData.constData() + offset);
+        if (pairSize > quint32(keyValueData.size() - offset - 4)) {
+            return false;
+        }
+        const QByteArray pair = keyValueData.mid(offset + 4, pairSize);
+        const int separator = pair.indexOf('\0');
+        if (separator > 0) {
+            QByteArray value = pair.mid(separator + 1);
+            if (value.endsWith('\0')) {
+                value.chop(1);
+            }
+            keyValues.insert(pair.left(separator), value);
+        }
+        offset += 4 + ((pairSize + 3) & ~3);
+    }
+
+    if (!texture) {
+        return true;
+    }
+
+    texture->format = textureFormatFor(internalFormat);
+    for (quint32 level = 0; level < mipLevels; ++level) {
+        const QByteArray sizeField = file.read(4);
+        if (sizeField.size() != 4) {
+            return false;
+        }
+        // imageSize trebuie sa fie exact dimensiunea nivelului si sa incapa in restul fisierului,
+        // altfel makeLevel ar citi dincolo de date
+        const int levelWidth = int(qMax<quint32>(1, width >> level));
+        const int levelHeight = int(qMax<quint32>(1, height >> level));
+        const quint32 imageSize = readUInt32(sizeField.constData());
+        if (imageSize != levelByteCount(internalFormat, levelWidth, levelHeight)
+            || imageSize > file.size() - file.pos()) {
+            return false;
+        }
+        const QByteArray bytes = file.read(imageSize);
+        if (quint32(bytes.size()) != imageSize) {
+            return false;
+        }
+        file.read((4 - imageSize % 4) % 4);
+
+        texture->levels.append(makeLevel(levelWidth, levelHeight, internalFormat, bytes));
+        texture->bytes += imageSize;
+    }
+    return texture->isValid();
+}
+
+QByteArray writeKeyValues(const KeyValues &keyValues)
+{
+    QByteArray keyValueData;
+    for (auto it = keyValues.constBegin(); it != keyValues.constEnd(); ++it) {
+        const QByteArray pair = it.key() + '\0' + it.value() + '\0';
+        appendUInt32(keyValueData, quint32(pair.size()));
+        keyValueData.append(pair);
+        appendPadding(keyValueData);
+    }
+    return keyValueData;
+}
+
+// Rescrie doar perechile cheie/valoare ale unui fisier copt; nivelurile raman neatinse
+void rewriteKeyValues(const QString &bakedFilePath, const KeyValues &keyValues)
+{
+    QFile input(bakedFilePath);
+    if (!input.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    const QByteArray header = input.read(KTX_HEADER_SIZE);
+    if (header.size() != KTX_HEADER_SIZE) {
+        return;
+    }
+    const quint32 oldKeyValueBytes = readUInt32(header.constData() + KTX_KEY_VALUE_BYTES_OFFSET);
+    if (!input.seek(KTX_HEADER_SIZE + qint64(oldKeyValueBytes))) {
+        return;
+    }
+    const QByteArray levels = input.readAll();
+    input.close();
+
+    const QByteArray keyValueData = writeKeyValues(keyValues);
+    QByteArray out = header.left(KTX_KEY_VALUE_BYTES_OFFSET);
+    appendUInt32(out, quint32(keyValueData.size()));
+    out.append(keyValueData);
+    out.append(levels);
+
+    QSaveFile file(bakedFilePath);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(out);
+        file.commit();
+    }
+}
+
+bool matchesSource(const QString &sourcePath, const QString &bakedFilePath, const KeyValues &keyValues)
+{
+    if (keyValues.value("baker.version") != BAKER_VERSION) {
+        return false;
+    }
+
+    const QFileInfo info(sourcePath);
+    if (keyValues.value("source.size") != QByteArray::number(info.size())) {
+        return false;
+    }
+    if (keyValues.value("source.mtime") == QByteArray::number(info.lastModified().toMSecsSinceEpoch())) {
+        return true;
+    }
+    // mtime diferit (ex. fisier copiat sau atins): continutul decide
+    if (keyValues.value("source.sha1") != sourceHash(sourcePath)) {
+        return false;
+    }
+    // Noul mtime este retinut, ca sursa sa nu mai fie citita si hash-uita la fiecare incarcare
+    KeyValues updated = keyValues;
+    updated.insert("source.mtime", QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    rewriteKeyValues(bakedFilePath, updated);
+    return true;
+}
+
+QByteArray writeKtx(quint32 internalFormat, int width, int height, const QVector<QByteArray> &levels,
+                    const KeyValues &keyValues)
+{
+    const bool compressed = internalFormat != GL_RGBA8_;
+    const QByteArray keyValueData = writeKeyValues(keyValues);
+
+    QByteArray out;
+    out.append(KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER));
+    appendUInt32(out, KTX_ENDIANNESS);
+    appendUInt32(out, compressed ? 0 : GL_UNSIGNED_BYTE_);
+    appendUInt32(out, 1);
+    appendUInt32(out, compressed ? 0 : GL_RGBA_);
+    appendUInt32(out, internalFormat);
+    appendUInt32(out, internalFormat == GL_COMPRESSED_RED_RGTC1 ? GL_RED_
+                      : internalFormat == GL_COMPRESSED_RGB_S3TC_DXT1 ? GL_RGB_ : GL_RGBA_);
+    appendUInt32(out, quint32(width));
+    appendUInt32(out, quint32(height));
+    appendUInt32(out, 0);
+    appendUInt32(out, 0);
+    appendUInt32(out, 1);
+    appendUInt32(out, quint32(levels.size()));
+    appendUInt32(out, quint32(keyValueData.size()));
+    out.append(keyValueData);
+
+    for (const QByteArray &level : levels) {
+        appendUInt32(out, quint32(level.size()));
+        out.append(level);
+        appendPadding(out);
+    }
+    return out;
+}
+
+// Pixelul (x, y) al blocului, cu marginile repetate pentru nivelurile mai mici de 4x4
+const uchar *blockPixel(const QImage &image, int blockX, int blockY, int x, int y)
+{
+    const int px = qMin(blockX * 4 + x, image.width() - 1);
+    const int py = qMin(blockY * 4 + y, image.height() - 1);
+    return image.constScanLine(py) + px * 4;
+}
+
+quint16 toRgb565(int r, int g, int b)
+{
+    return quint16(((r * 31 + 127) / 255) << 11 | ((g * 63 + 127) / 255) << 5 | ((b * 31 + 127) / 255));
+}
+
+void fromRgb565(quint16 c, int rgb[3])
+{
+    rgb[0] = ((c >> 11) & 31) * 255 / 31;
+    rgb[1] = ((c >> 5) & 63) * 255 / 63;
+    rgb[2] = (c & 31) * 255 / 31;
+}
+
+// BC1: capetele sunt colturile cutiei RGB a blocului (usor stranse spre interior),
+// fiecare pixel primeste cea mai apropiata dintre cele 4 culori interpolate
+void encodeBc1Block(const QImage &image, int blockX, int blockY, QByteArray &out)
+{
+    int minC[3] = { 255, 255, 255 };
+    int maxC[3] = { 0, 0, 0 };
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            const uchar *p = blockPixel(image, blockX, blockY, x, y);
+            for (int c = 0; c < 3; ++c) {
+                minC[c] = qMin(minC[c], int(p[c]));
+                maxC[c] = qMax(maxC[c], int(p[c]));
+            }
+        }
+    }
+    for (int c = 0; c < 3; ++c) {
+        const int inset = (maxC[c] - minC[c]) / 16;
+        minC[c] += inset;
+        maxC[c] -= inset;
+    }
+
+    quint16 c0 = toRgb565(maxC[0], maxC[1], maxC[2]);
+    quint16 c1 = toRgb565(minC[0], minC[1], minC[2]);
+    if (c0 < c1) {
+        std::swap(c0, c1);
+    }
+
+    quint32 indices = 0;
+    if (c0 != c1) {
+        int palette[4][3];
+        fromRgb565(c0, palette[0]);
+        fromRgb565(c1, palette[1]);
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+
+        for (int i = 0; i < 16; ++i) {
+            const uchar *p = blockPixel(image, blockX, blockY, i % 4, i / 4);
+            int best = 0;
+            int bestDistance = INT_MAX;
+            for (int k = 0; k < 4; ++k) {
+                const int dr = p[0] - palette[k][0];
+                const int dg = p[1] - palette[k][1];
+                const int db = p[2] - palette[k][2];
+                const int distance = dr * dr + dg * dg + db * db;
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = k;
+                }
+            }
+            indices |= quint32(best) << (2 * i);
+        }
+    }
+
+    const quint16 le0 = qToLittleEndian(c0);
+    const quint16 le1 = qToLittleEndian(c1);
+    out.append(reinterpret_cast<const char *>(&le0), 2);
+    out.append(reinterpret_cast<const char *>(&le1), 2);
+    appendUInt32(out, indices);
+}
+
+// BC4: 8 valori intre minimul si maximul canalului rosu al blocului
+void encodeBc4Block(const QImage &image, int blockX, int blockY, QByteArray &out)
+{
+    int values[16];
+    int minV = 255;
+    int maxV = 0;
+    for (int i = 0; i < 16; ++i) {
+        values[i] = blockPixel(image, blockX, blockY, i % 4, i / 4)[0];
+        minV = qMin(minV, values[i]);
+        maxV = qMax(maxV, values[i]);
+    }
+
+    quint64 indices = 0;
+    if (maxV != minV) {
+        for (int i = 0; i < 16; ++i) {
+            // pozitia pe segmentul max -> min, 0..7
+            const int step = ((maxV - values[i]) * 7 + (maxV - minV) / 2) / (maxV - minV);
+            // ordinea indicilor BC4: 0 = max, 1 = min, 2..7 = valorile intermediare
+            const int index = step == 0 ? 0 : step == 7 ? 1 : step + 1;
+            indices |= quint64(index) << (3 * i);
+        }
+    }
+
+    out.append(char(maxV));
+    out.append(char(minV));
+    for (int i = 0; i < 6; ++i) {
+        out.append(char((indices >> (8 * i)) & 0xFF));
+    }
+}
+
+} // namespace
+
+QString TextureBaker::texturesPath()
+{
+    return QCoreApplication::applicationDirPath() + "/../../../Models/Textures/";
+}
+
+QString TextureBaker::bakedPath(const QString &sourcePath)
+{
+    const QFileInfo info(sourcePath);
+    return info.absolutePath() + "/.baked/" + info.fileName() + ".ktx";
+}
+
+TextureBaker::Encoding TextureBaker::encodingFor(const QString &sourcePath)
+{
+    const QString baseName = QFileInfo(sourcePath).completeBaseName().toLower();
+    if (baseName.endsWith("_diff")) {
+        return Encoding::BC1;
+    }
+    if (baseName.endsWith("_roughness") || baseName.endsWith("_metallic")) {
+        return Encoding::BC4;
+    }
+    return Encoding::RGBA8;
+}
+
+bool TextureBaker::loadBaked(const QString &sourcePath, DecodedTexture &texture)
+{
+    const QString bakedFilePath = bakedPath(sourcePath);
+    if (!QFileInfo::exists(bakedFilePath)) {
+        return false;
+    }
+
+    KeyValues keyValues;
+    if (!readKtx(bakedFilePath, keyValues, nullptr) || !matchesSource(sourcePath, bakedFilePath, keyValues)) {
+        qDebug() << "Baked texture is stale:" << bakedFilePath;
+        return false;
+    }
+
+    keyValues.clear();
+    DecodedTexture baked;
+    if (!readKtx(bakedFilePath, keyValues, &baked)) {
+        qDebug() << "Baked texture is corrupt:" << bakedFilePath;
+        return false;
+    }
+    texture = baked;
+    return true;
+}
+
+bool TextureBaker::bake(const QString &sourcePath, DecodedTexture &texture)
+{
+    QImageReader reader(sourcePath);
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qDebug() << "Texture decode failed:" << sourcePath << reader.errorString();
+        return false;
+    }
+
+    const Encoding encoding = encodingFor(sourcePath);
+    const quint32 internalFormat = internalFormatFor(encoding);
+    const QVector<QImage> chain = buildMipChain(image.convertToFormat(QImage::Format_RGBA8888));
+
+    DecodedTexture baked;
+    baked.format = textureFormatFor(internalFormat);
+    QVector<QByteArray> levels;
+    levels.reserve(chain.size());
+    for (const QImage &level : chain) {
+        levels.append(encodeLevel(level, encoding));
+        baked.levels.append(makeLevel(level.width(), level.height(), internalFormat, levels.last()));
+        baked.bytes += levels.last().size();
+    }
+
+    const QFileInfo info(sourcePath);
+    KeyValues keyValues;
+    keyValues.insert("baker.version", BAKER_VERSION);
+    keyValues.insert("source.size", QByteArray::number(info.size()));
+    keyValues.insert("source.mtime", QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    keyValues.insert("source.sha1", sourceHash(sourcePath));
+
+    // QSaveFile: doua cereri pentru aceeasi textura nu pot lasa un fisier pe jumatate scris
+    const QString bakedFilePath = bakedPath(sourcePath);
+    QDir().mkpath(QFileInfo(bakedFilePath).absolutePath());
+    QSaveFile file(bakedFilePath);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(writeKtx(internalFormat, chain.first().width(), chain.first().height(), levels, keyValues));
+        if (!file.commit()) {
+            qDebug() << "Failed to write baked texture:" << bakedFilePath;
+        }
+    } else {
+        qDebug() << "Failed to write baked texture:" << bakedFilePath << file.errorString();
+    }
+
+    texture = baked;
+    return true;
+}
+
+QStringList TextureBaker::pendingSources(const QString &dirPath)
+{
+    static const QStringList filters = {
+        "*_diff.*", "*_nor_gl.*", "*_roughness.*", "*_metallic.*"
+    };
+
+    QStringList pending;
+    const QFileInfoList sources = QDir(dirPath).entryInfoList(filters, QDir::Files);
+    for (const QFileInfo &source : sources) {
+        KeyValues keyValues;
+        const QString bakedFilePath = bakedPath(source.absoluteFilePath());
+        if (!QFileInfo::exists(bakedFilePath) || !readKtx(bakedFilePath, keyValues, nullptr)
+            || !matchesSource(source.absoluteFilePath(), bakedFilePath, keyValues)) {
+            pending.append(source.absoluteFilePath());
+        }
+    }
+    return pending;
+}
+
+QVector<QImage> TextureBaker::buildMipChain(const QImage &image)
+{
+    QVector<QImage> chain;
+    QImage level = image;
+    while (true) {
+        chain.append(level);
+        if (level.width() == 1 && level.height() == 1) {
+            break;
+        }
+        level = level.scaled(qMax(1, level.width() / 2), qMax(1, level.height() / 2),
+                             Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+    return chain;
+}
+
+QByteArray TextureBaker::encodeLevel(const QImage &image, Encoding encoding)
+{
+    QByteArray out;
+
+    if (encoding == Encoding::RGBA8) {
+        out.reserve(image.width() * image.height() * 4);
+        for (int y = 0; y < image.height(); ++y) {
+            out.append(reinterpret_cast<const char *>(image.constScanLine(y)), image.width() * 4);
+        }
+        return out;
+    }
+
+    const int blocksX = (image.width() + 3) / 4;
+    const int blocksY = (image.height() + 3) / 4;
+    out.reserve(blocksX * blocksY * 8);
+    for (int by = 0; by < blocksY; ++by) {
+        for (int bx = 0; bx < blocksX; ++bx) {
+            if (encoding == Encoding::BC1) {
+                encodeBc1Block(image, bx, by, out);
+            } else {
+                encodeBc4Block(image, bx, by, out);
+            }
+        }
+    }
+    return out;
+}
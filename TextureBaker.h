@@ -0,0 +1,46 @@
+#ifndef TEXTUREBAKER_H
+#define TEXTUREBAKER_H
+
+#include <QByteArray>
+#include <QImage>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "TextureLoader.h"
+
+// Cache de texturi compresate pe disc (KTX 1.1, in Models/Textures/.baked).
+// Fiecare harta PBR este convertita o singura data intr-un format pe care GPU-ul il
+// citeste direct, cu lantul de mipmap-uri deja construit:
+//   _diff               -> BC1 (DXT1, RGB, 8 octeti / bloc 4x4)
+//   _roughness/_metallic -> BC4 (RGTC1, un canal, 8 octeti / bloc 4x4)
+//   _nor_gl             -> RGBA8 necompresat (BC1 strica normalele)
+// Fisierul copt retine mtime-ul, dimensiunea si hash-ul SHA-1 al sursei si este
+// refolosit doar cat timp acestea corespund.
+class TextureBaker
+{
+public:
+    enum class Encoding {
+        BC1,
+        BC4,
+        RGBA8
+    };
+
+    static QString texturesPath();
+    static QString bakedPath(const QString &sourcePath);
+    static Encoding encodingFor(const QString &sourcePath);
+
+    // Incarca fisierul copt daca exista si corespunde sursei
+    static bool loadBaked(const QString &sourcePath, DecodedTexture &texture);
+    // Decodeaza sursa, o compreseaza si scrie fisierul copt; texture primeste rezultatul
+    static bool bake(const QString &sourcePath, DecodedTexture &texture);
+
+    // Hartile PBR dintr-un director care nu au inca un fisier copt valid
+    static QStringList pendingSources(const QString &dirPath);
+
+    // Lant de mipmap-uri RGBA8 pana la 1x1, respectiv compresia unui nivel in blocuri 4x4
+    static QVector<QImage> buildMipChain(const QImage &image);
+    static QByteArray encodeLevel(const QImage &image, Encoding encoding);
+};
+
+#endif // TEXTUREBAKER_H
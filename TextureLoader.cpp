@@ -0,0 +1,225 @@
+#include "TextureLoader.h"
+#include "TextureBaker.h"
+#include <QCoreApplication>
+#include <QImage>
+#include <QPointer>
+#include <QRunnable>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <QThread>
+#include <functional>
+
+namespace {
+
+class StaticImageDataGenerator : public Qt3DRender::QTextureImageDataGenerator
+{
+public:
+    explicit StaticImageDataGenerator(const Qt3DRender::QTextureImageDataPtr &data)
+        : m_data(data)
+    {
+    }
+
+    Qt3DRender::QTextureImageDataPtr operator()() override
+    {
+        return m_data;
+    }
+
+    bool operator==(const Qt3DRender::QTextureImageDataGenerator &other) const override
+    {
+        const auto *otherGenerator = dynamic_cast<const StaticImageDataGenerator *>(&other);
+        return otherGenerator && otherGenerator->m_data == m_data;
+    }
+
+    QT3D_FUNCTOR(StaticImageDataGenerator)
+
+private:
+    Qt3DRender::QTextureImageDataPtr m_data;
+};
+
+class TextureDecodeJob : public QRunnable
+{
+public:
+    TextureDecodeJob(const QString &filePath, const TextureLoader::CancelToken &token,
+                     std::function<void(const DecodedTexture &)> deliver)
+        : m_filePath(filePath), m_token(token), m_deliver(std::move(deliver))
+    {
+    }
+
+    void run() override
+    {
+        if (m_token && m_token->loadAcquire()) {
+            m_deliver(DecodedTexture());
+            return;
+        }
+
+        DecodedTexture texture = TextureLoader::decode(m_filePath);
+
+        // clearScene poate rula cat timp decodam; rezultatul nu mai este necesar
+        if (m_token && m_token->loadAcquire()) {
+            texture = DecodedTexture();
+        }
+        m_deliver(texture);
+    }
+
+private:
+    QString m_filePath;
+    TextureLoader::CancelToken m_token;
+    std::function<void(const DecodedTexture &)> m_deliver;
+};
+
+} // namespace
+
+StreamedTextureImage::StreamedTextureImage(const Qt3DRender::QTextureImageDataPtr &data, Qt3DCore::QNode *parent)
+    : Qt3DRender::QAbstractTextureImage(parent), m_data(data)
+{
+}
+
+Qt3DRender::QTextureImageDataGeneratorPtr StreamedTextureImage::dataGenerator() const
+{
+    return Qt3DRender::QTextureImageDataGeneratorPtr(new StaticImageDataGenerator(m_data));
+}
+
+StreamedTexture2D::StreamedTexture2D(const QColor &placeholderColor, Qt3DCore::QNode *parent)
+    : SimpleTexture2D(parent)
+{
+    replaceImages({ TextureLoader::solidColorData(placeholderColor) });
+}
+
+void StreamedTexture2D::applyDecoded(const DecodedTexture &texture)
+{
+    if (!texture.isValid()) {
+        return;
+    }
+    setFormat(texture.format);
+    replaceImages(texture.levels);
+}
+
+void StreamedTexture2D::replaceImages(const QVector<Qt3DRender::QTextureImageDataPtr> &levels)
+{
+    const auto oldImages = textureImages();
+    for (Qt3DRender::QAbstractTextureImage *image : oldImages) {
+        removeTextureImage(image);
+        delete image;
+    }
+
+    for (int level = 0; level < levels.size(); ++level) {
+        auto *image = new StreamedTextureImage(levels[level], this);
+        image->setMipLevel(level);
+        addTextureImage(image);
+    }
+
+    // Cand worker-ul a livrat tot lantul nu mai generam mipmap-uri pe GPU
+    setGenerateMipMaps(levels.size() == 1);
+    setMipLevels(levels.size());
+}
+
+TextureLoader *TextureLoader::instance()
+{
+    static TextureLoader *loader = new TextureLoader(QCoreApplication::instance());
+    return loader;
+}
+
+TextureLoader::TextureLoader(QObject *parent)
+    : QObject(parent), m_bakeToken(createToken())
+{
+    // Lasam un nucleu liber pentru thread-ul GUI si aspectele Qt3D
+    m_pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+}
+
+TextureLoader::~TextureLoader()
+{
+    // QThreadPool asteapta job-urile ramase; coacerea bibliotecii nu trebuie sa intarzie iesirea
+    cancel(m_bakeToken);
+}
+
+TextureLoader::CancelToken TextureLoader::createToken()
+{
+    return CancelToken::create(0);
+}
+
+void TextureLoader::cancel(const CancelToken &token)
+{
+    if (token) {
+        token->storeRelease(1);
+    }
+}
+
+void TextureLoader::load(const QString &filePath, StreamedTexture2D *target, const CancelToken &token)
+{
+    if (!target) {
+        return;
+    }
+
+    // QPointer este creat si folosit doar pe thread-ul GUI
+    QPointer<StreamedTexture2D> guardedTarget(target);
+    m_pending.ref();
+
+    auto deliver = [this, guardedTarget, filePath](const DecodedTexture &texture) {
+        QMetaObject::invokeMethod(this, [this, guardedTarget, filePath, texture]() {
+            const bool last = !m_pending.deref();
+            if (!texture.isValid() || !guardedTarget) {
+                m_cancelled.ref();
+            } else {
+                guardedTarget->applyDecoded(texture);
+                m_completed.ref();
+                qDebug() << "Texture ready:" << filePath << "(" << texture.levels.size() << "levels,"
+                         << texture.bytes << "bytes )";
+            }
+            if (last) {
+                emit idle();
+            }
+        }, Qt::QueuedConnection);
+    };
+
+    m_pool.start(new TextureDecodeJob(filePath, token, deliver));
+}
+
+void TextureLoader::bakeLibrary(const QString &dirPath)
+{
+    const CancelToken token = m_bakeToken;
+    m_pool.start(QRunnable::create([dirPath, token]() {
+        QElapsedTimer timer;
+        timer.start();
+
+        const QStringList sources = TextureBaker::pendingSources(dirPath);
+        int baked = 0;
+        for (const QString &source : sources) {
+            if (token->loadAcquire()) {
+                break;
+            }
+            DecodedTexture texture;
+            if (TextureBaker::bake(source, texture)) {
+                ++baked;
+            }
+        }
+        qDebug() << "Baked" << baked << "of" << sources.size() << "textures in" << dirPath
+                 << "in" << timer.elapsed() << "ms";
+    }), -1);
+}
+
+DecodedTexture TextureLoader::decode(const QString &filePath)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    DecodedTexture texture;
+    if (TextureBaker::loadBaked(filePath, texture)) {
+        qDebug() << "Loaded baked texture" << filePath << "in" << timer.elapsed() << "ms";
+        return texture;
+    }
+
+    if (TextureBaker::bake(filePath, texture)) {
+        qDebug() << "Decoded and baked texture" << filePath << "in" << timer.elapsed() << "ms";
+    }
+    return texture;
+}
+
+Qt3DRender::QTextureImageDataPtr TextureLoader::solidColorData(const QColor &color, int size)
+{
+    QImage image(size, size, QImage::Format_RGBA8888);
+    image.fill(color);
+
+    auto data = Qt3DRender::QTextureImageDataPtr::create();
+    data->setImage(image);
+    return data;
+}
@@ -0,0 +1,96 @@
+#ifndef TEXTURELOADER_H
+#define TEXTURELOADER_H
+
+#include <QAtomicInt>
+#include <QColor>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+#include <Qt3DRender/QAbstractTextureImage>
+#include <Qt3DRender/QTextureImageData>
+#include <Qt3DRender/QTextureImageDataGenerator>
+
+#include "PBRMaterial.h"
+
+// Lantul de mipmap-uri produs de un worker; nivelul 0 este imaginea la rezolutie maxima
+struct DecodedTexture {
+    QVector<Qt3DRender::QTextureImageDataPtr> levels;
+    qint64 bytes = 0;
+    // Formatul in care datele sunt urcate pe GPU (ex. RGB_DXT1 pentru texturile coapte)
+    Qt3DRender::QAbstractTexture::TextureFormat format = Qt3DRender::QAbstractTexture::RGBA8_UNorm;
+
+    bool isValid() const { return !levels.isEmpty(); }
+};
+
+// Imagine de textura cu date deja decodate (nu mai citeste nimic de pe disc)
+class StreamedTextureImage : public Qt3DRender::QAbstractTextureImage
+{
+    Q_OBJECT
+public:
+    explicit StreamedTextureImage(const Qt3DRender::QTextureImageDataPtr &data, Qt3DCore::QNode *parent = nullptr);
+
+protected:
+    Qt3DRender::QTextureImageDataGeneratorPtr dataGenerator() const override;
+
+private:
+    Qt3DRender::QTextureImageDataPtr m_data;
+};
+
+// Textura care porneste cu un placeholder solid si comuta pe imaginea reala
+// cand aceasta a fost decodata in fundal de TextureLoader
+class StreamedTexture2D : public SimpleTexture2D
+{
+    Q_OBJECT
+public:
+    explicit StreamedTexture2D(const QColor &placeholderColor, Qt3DCore::QNode *parent = nullptr);
+
+    void applyDecoded(const DecodedTexture &texture);
+
+private:
+    void replaceImages(const QVector<Qt3DRender::QTextureImageDataPtr> &levels);
+};
+
+// Pool de decodare a texturilor in afara thread-ului GUI.
+// Fiecare cerere primeste un token de anulare; setarea lui (ex. din clearScene)
+// opreste cererile care nu au inceput inca si arunca rezultatele celor in curs.
+class TextureLoader : public QObject
+{
+    Q_OBJECT
+public:
+    using CancelToken = QSharedPointer<QAtomicInt>;
+
+    static TextureLoader *instance();
+    static CancelToken createToken();
+    static void cancel(const CancelToken &token);
+
+    void load(const QString &filePath, StreamedTexture2D *target, const CancelToken &token);
+    // Coace in fundal, cu prioritate mica, toate hartile PBR din director care nu au cache valid
+    void bakeLibrary(const QString &dirPath);
+
+    int pendingCount() const { return m_pending.loadRelaxed(); }
+    int completedCount() const { return m_completed.loadRelaxed(); }
+    int cancelledCount() const { return m_cancelled.loadRelaxed(); }
+
+    // Folosit de worker: citeste textura coapta (vezi TextureBaker) sau, daca lipseste ori
+    // este depasita, decodeaza sursa, construieste lantul de mipmap-uri si o coace acum
+    static DecodedTexture decode(const QString &filePath);
+    static Qt3DRender::QTextureImageDataPtr solidColorData(const QColor &color, int size = 4);
+
+signals:
+    // Ultima cerere in curs s-a terminat (aplicata sau anulata); emis pe thread-ul GUI
+    void idle();
+
+private:
+    explicit TextureLoader(QObject *parent = nullptr);
+    ~TextureLoader();
+
+    QThreadPool m_pool;
+    QAtomicInt m_pending;
+    QAtomicInt m_completed;
+    QAtomicInt m_cancelled;
+    CancelToken m_bakeToken;
+};
+
+#endif // TEXTURELOADER_H
@@ -0,0 +1,249 @@
+// Costul pe cadru al animatiilor individuale (rotate/bounce/float/pulse/swing/glow), fara fereastra.
+// Pentru fiecare numar de obiecte se construieste un SceneStore sintetic (tipuri, marimi si
+// animatii alternate ca intr-o scena generata) si se masoara, dupa cateva cadre de incalzire,
+// timpul mediu al unui cadru de 16 ms pentru fiecare varianta:
+//   strings - bucla initiala din updateAnimations: compara numele animatiilor la fiecare cadru,
+//             recalculeaza scala si volumul din siruri si compune rotatiile cu QQuaternion
+//   scalar  - programele pe biti evaluate de AnimationKernel doar pe calea scalara
+//             (setScalarOnly), urmate de scrierea pozitiilor, rotatiilor si volumelor ca in
+//             SimulationWorker::updateAnimations
+//   kernel  - aceeasi bucla cu AnimationKernel in configuratia aplicatiei (SSE2 daca exista)
+// Scrierea in QTransform (identica in toate variantele) nu este inclusa.
+//   ./animbench --objects 1000,5000,10000 --frames 2000
+
+#include "AnimationKernel.h"
+#include "SceneStore.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QtMath>
+
+namespace {
+
+const float DELTA_TIME = 0.016f; // ~60 FPS, ca timer-ul de animatie
+const float FLOOR_LEVEL = 0.0f;
+const float MODEL_SCALE = 2.0f; // ca MyOpenGLWidget::MODEL_SCALE
+const int WARMUP_FRAMES = 60;
+
+const char *const TYPES[] = { "cube", "sphere", "chair", "table", "teapot" };
+const char *const SIZES[] = { "medium", "small", "large", "tiny", "huge" };
+// Combinatii de animatii din descrierile de scena, inclusiv sinonime
+const QStringList ANIMATION_SETS[] = {
+    { "rotate" },
+    { "bounce" },
+    { "float", "pulse" },
+    { "spin", "swing" },
+    { "floating", "glow" },
+    { "jump", "pulsing", "rotation" },
+    { "oscillate" }
+};
+
+float sizeMultiplier(const QString &size)
+{
+    if (size == "small") return 0.7f;
+    if (size == "large" || size == "big") return 1.5f;
+    if (size == "huge") return 2.0f;
+    if (size == "tiny") return 0.4f;
+    return 1.0f;
+}
+
+// Dimensiunile aproximative din MyOpenGLWidget::calculateBoundingBox (fara ModelBoundsIndex)
+void boundingBox(const QString &type, const QString &size, QVector3D &minBounds, QVector3D &maxBounds)
+{
+    QVector3D dimensions(1.0f, 1.0f, 1.0f);
+    if (type == "chair") {
+        dimensions = QVector3D(1.0f, 2.0f, 1.0f);
+    } else if (type == "table") {
+        dimensions = QVector3D(2.0f, 1.5f, 1.0f);
+    } else if (type == "teapot") {
+        dimensions = QVector3D(1.2f, 1.0f, 1.2f);
+    }
+    dimensions *= sizeMultiplier(size);
+    minBounds = -dimensions / 2.0f;
+    maxBounds = dimensions / 2.0f;
+}
+
+QVector3D floorConstrained(const QVector3D &position, const QVector3D &minBounds)
+{
+    QVector3D constrained = position;
+    const float minY = FLOOR_LEVEL - minBounds.y() + 0.2f;
+    if (constrained.y() < minY) {
+        constrained.setY(minY);
+    }
+    return constrained;
+}
+
+void populate(SceneStore &store, int count)
+{
+    store.clear();
+    for (int i = 0; i < count; ++i) {
+        SceneObject object;
+        object.id = QString("object_%1").arg(i);
+        object.type = TYPES[i % 5];
+        object.size = SIZES[(i / 5) % 5];
+        object.position = QVector3D((i % 100) * 3.0f, 1.0f, (i / 100) * 3.0f);
+        object.originalPosition = object.position;
+        object.animations = ANIMATION_SETS[i % 7];
+
+        QVector3D minBounds, maxBounds;
+        boundingBox(object.type, object.size, minBounds, maxBounds);
+        object.boundingBoxMin = object.position + minBounds;
+        object.boundingBoxMax = object.position + maxBounds;
+
+        const SceneStore::Handle handle = store.add(object);
+        quint8 program = 0;
+        for (const QString &animation : std::as_const(object.animations)) {
+            program |= SceneStore::animationFlagFor(animation);
+        }
+        store.animationFlags[handle] = program;
+        store.baseScales[handle] = sizeMultiplier(object.size) * MODEL_SCALE;
+    }
+}
+
+void stringsFrame(SceneStore &store)
+{
+    for (SceneStore::Handle h = 0; h < store.size(); ++h) {
+        QVector3D currentPosition = store.originalPositions[h];
+        QQuaternion currentRotation;
+        float currentScale = sizeMultiplier(store.sizes[h]);
+
+        for (const QString &animationType : std::as_const(store.animations[h])) {
+            if (animationType == "rotate" || animationType == "rotation" || animationType == "spin") {
+                float &rotationAngle = store.rotationAngles[h];
+                rotationAngle += 30.0f * DELTA_TIME;
+                if (rotationAngle > 360.0f) {
+                    rotationAngle -= 360.0f;
+                }
+                currentRotation = currentRotation * QQuaternion::fromAxisAndAngle(QVector3D(0, 1, 0), rotationAngle);
+            } else if (animationType == "bounce" || animationType == "bouncing" || animationType == "jump") {
+                store.bouncePhases[h] += 2.0f * DELTA_TIME;
+                currentPosition.setY(currentPosition.y() + qAbs(qSin(store.bouncePhases[h])) * 2.0f);
+            } else if (animationType == "float" || animationType == "floating") {
+                store.floatPhases[h] += 0.5f * DELTA_TIME;
+                currentPosition.setY(currentPosition.y() + qSin(store.floatPhases[h]) * 1.0f);
+            } else if (animationType == "pulse" || animationType == "pulsing") {
+                store.pulsePhases[h] += 3.0f * DELTA_TIME;
+                currentScale *= 1.0f + qSin(store.pulsePhases[h]) * 0.2f;
+            } else if (animationType == "swing" || animationType == "swinging" || animationType == "oscillate") {
+                store.swingPhases[h] += 1.5f * DELTA_TIME;
+                const float swingAngle = qSin(store.swingPhases[h]) * 15.0f;
+                currentRotation = currentRotation * QQuaternion::fromAxisAndAngle(QVector3D(0, 0, 1), swingAngle);
+            } else if (animationType == "glow") {
+                store.pulsePhases[h] += 2.0f * DELTA_TIME;
+            }
+
+            // Verificarea podelei facuta dupa fiecare animatie
+            QVector3D minBounds, maxBounds;
+            boundingBox(store.types[h], store.sizes[h], minBounds, maxBounds);
+            QVector3D finalPosition = store.positions[h];
+            const float minAllowedY = FLOOR_LEVEL + (maxBounds.y() - minBounds.y()) * currentScale / 2.0f + 0.1f;
+            if (finalPosition.y() < minAllowedY) {
+                finalPosition.setY(minAllowedY);
+            }
+            store.positions[h] = finalPosition;
+        }
+
+        QVector3D minBounds, maxBounds;
+        boundingBox(store.types[h], store.sizes[h], minBounds, maxBounds);
+        currentPosition = floorConstrained(currentPosition, minBounds);
+
+        store.positions[h] = currentPosition;
+        store.rotations[h] = currentRotation;
+        store.scales[h] = currentScale;
+        store.boundsMin[h] = currentPosition + minBounds;
+        store.boundsMax[h] = currentPosition + maxBounds;
+    }
+}
+
+void kernelFrame(SceneStore &store, AnimationKernel &kernel)
+{
+    kernel.evaluate(store, DELTA_TIME);
+
+    const float *offsetY = kernel.offsetY();
+    const float *scale = kernel.scale();
+    const float *rotationW = kernel.rotationW();
+    const float *rotationX = kernel.rotationX();
+    const float *rotationY = kernel.rotationY();
+    const float *rotationZ = kernel.rotationZ();
+
+    for (SceneStore::Handle h = 0; h < store.size(); ++h) {
+        QVector3D currentPosition = store.originalPositions[h];
+        currentPosition.setY(currentPosition.y() + offsetY[h]);
+        currentPosition = floorConstrained(currentPosition, store.localBoundsMin[h]);
+
+        store.positions[h] = currentPosition;
+        store.rotations[h] = QQuaternion(rotationW[h], rotationX[h], rotationY[h], rotationZ[h]);
+        store.scales[h] = scale[h];
+        store.boundsMin[h] = currentPosition + store.localBoundsMin[h];
+        store.boundsMax[h] = currentPosition + store.localBoundsMax[h];
+    }
+}
+
+// Timpul mediu al unui cadru, in microsecunde
+template <typename Frame>
+double measure(int frames, Frame frame)
+{
+    for (int i = 0; i < WARMUP_FRAMES; ++i) {
+        frame();
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < frames; ++i) {
+        frame();
+    }
+    return double(timer.nsecsElapsed()) / frames / 1000.0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Measures the per-frame cost of individual object animations.");
+    parser.addHelpOption();
+
+    QCommandLineOption objectsOption("objects", "Comma-separated object counts.", "counts", "1000,5000,10000");
+    QCommandLineOption framesOption("frames", "Measured frames per run.", "count", "2000");
+    parser.addOptions({ objectsOption, framesOption });
+    parser.process(app);
+
+    QTextStream out(stdout);
+    const int frames = parser.value(framesOption).toInt();
+    if (frames <= 0) {
+        QTextStream(stderr) << "Invalid --frames" << Qt::endl;
+        return 2;
+    }
+
+    out << "Animation kernel: " << (AnimationKernel::isVectorized() ? "SSE2" : "scalar") << Qt::endl;
+    for (const QString &countText : parser.value(objectsOption).split(',')) {
+        const int count = countText.toInt();
+        if (count <= 0) {
+            QTextStream(stderr) << "Invalid object count: " << countText << Qt::endl;
+            return 2;
+        }
+
+        SceneStore store;
+        populate(store, count);
+        const double stringsUs = measure(frames, [&store]() { stringsFrame(store); });
+
+        populate(store, count);
+        AnimationKernel scalarKernel;
+        scalarKernel.setScalarOnly(true);
+        const double scalarUs = measure(frames, [&store, &scalarKernel]() { kernelFrame(store, scalarKernel); });
+
+        populate(store, count);
+        AnimationKernel kernel;
+        const double kernelUs = measure(frames, [&store, &kernel]() { kernelFrame(store, kernel); });
+
+        out << count << " objects: strings " << QString::number(stringsUs, 'f', 1) << " us/frame, scalar "
+            << QString::number(scalarUs, 'f', 1) << " us/frame, kernel " << QString::number(kernelUs, 'f', 1)
+            << " us/frame (" << QString::number(stringsUs / kernelUs, 'f', 1) << "x strings, "
+            << QString::number(scalarUs / kernelUs, 'f', 1) << "x scalar)" << Qt::endl;
+    }
+    return 0;
+}
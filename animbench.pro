@@ -0,0 +1,17 @@
+# Masurarea costului animatiilor individuale pe cadru, fara fereastra (vezi animbench.cpp)
+QT       += core gui 3dcore 3drender
+QT       -= widgets
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = animbench
+
+SOURCES += \
+    AnimationKernel.cpp \
+    SceneStore.cpp \
+    animbench.cpp
+
+HEADERS += \
+    AnimationKernel.h \
+    SceneStore.h
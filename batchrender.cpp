@@ -0,0 +1,294 @@
+// Randare in lot a scenelor, fara fereastra.
+// Fiecare scena (JSON sau .scnb) dintr-un director este construita cu MyOpenGLWidget in mod
+// offscreen si salvata ca PNG cu acelasi nume de baza. Cu --jobs N scenele sunt impartite intre
+// N procese copil (Qt3D are un singur aspect engine per scena, iar llvmpipe foloseste oricum
+// mai multe fire per proces). Pe o masina fara GPU:
+//   QT_QPA_PLATFORM=offscreen LIBGL_ALWAYS_SOFTWARE=1 ./batchrender --jobs 4 scenes/ thumbnails/
+// Modelele sunt cautate, ca in aplicatie, in Models/primitives relativ la executabil.
+
+#include "myopenglwidget.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFileInfo>
+#include <QHash>
+#include <QProcess>
+#include <QSurfaceFormat>
+#include <QTextStream>
+
+namespace {
+
+const char RESULT_PREFIX[] = "RESULT\t";
+
+struct SceneReport {
+    QString scenePath;
+    bool success = false;
+    qint64 loadMs = 0;
+    qint64 renderMs = 0;
+};
+
+bool verboseOutput = false;
+
+void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    Q_UNUSED(context);
+    // Widget-ul scrie mult la qDebug; in lot afisam doar avertismentele, daca nu se cere altfel
+    if (type == QtDebugMsg && !verboseOutput) {
+        return;
+    }
+    QTextStream(stderr) << message << Qt::endl;
+}
+
+QString outputPathFor(const QString &scenePath, const QString &outputDir)
+{
+    return QDir(outputDir).filePath(QFileInfo(scenePath).completeBaseName() + ".png");
+}
+
+// O linie pe scena, citita de procesul parinte
+QString formatResult(const SceneReport &report)
+{
+    return QString(RESULT_PREFIX) + QStringList{ report.scenePath, report.success ? "1" : "0",
+                                                 QString::number(report.loadMs),
+                                                 QString::number(report.renderMs) }.join('\t');
+}
+
+bool parseResult(const QString &line, SceneReport &report)
+{
+    if (!line.startsWith(RESULT_PREFIX)) {
+        return false;
+    }
+    const QStringList fields = line.mid(int(qstrlen(RESULT_PREFIX))).split('\t');
+    if (fields.size() != 4) {
+        return false;
+    }
+    report.scenePath = fields[0];
+    report.success = fields[1] == "1";
+    report.loadMs = fields[2].toLongLong();
+    report.renderMs = fields[3].toLongLong();
+    return true;
+}
+
+// Randeaza scenele in procesul curent, cu un singur widget refolosit intre ele
+QVector<SceneReport> renderScenes(const QStringList &scenePaths, const QString &outputDir,
+                                  const QSize &size, int timeoutMs, bool printResults)
+{
+    QVector<SceneReport> reports;
+
+    MyOpenGLWidget widget(nullptr, size);
+    // Imagini deterministe: obiectele raman in pozitiile de la incarcare
+    widget.pauseAnimations();
+    widget.pausePhysics();
+
+    for (const QString &scenePath : scenePaths) {
+        SceneReport report;
+        report.scenePath = scenePath;
+
+        QElapsedTimer timer;
+        timer.start();
+        widget.clearScene(); // o scena invalida nu trebuie sa refoloseasca imaginea precedenta
+        widget.loadScene(scenePath);
+        widget.frameScene();
+        report.loadMs = timer.elapsed();
+
+        const QImage image = widget.renderToImage(timeoutMs);
+        report.success = !image.isNull() && image.save(outputPathFor(scenePath, outputDir));
+        report.renderMs = timer.elapsed() - report.loadMs;
+
+        if (printResults) {
+            QTextStream(stdout) << formatResult(report) << Qt::endl;
+        }
+        reports.append(report);
+    }
+
+    return reports;
+}
+
+// Imparte scenele intre jobs procese copil (executabilul curent cu --worker)
+QVector<SceneReport> renderInWorkers(const QStringList &scenePaths, const QString &outputDir,
+                                     const QSize &size, int timeoutMs, int jobs)
+{
+    QVector<QStringList> batches(jobs);
+    for (int i = 0; i < scenePaths.size(); ++i) {
+        batches[i % jobs].append(scenePaths[i]);
+    }
+
+    QHash<QString, SceneReport> reportsByPath;
+    QEventLoop loop;
+    int running = 0;
+
+    for (const QStringList &batch : std::as_const(batches)) {
+        if (batch.isEmpty()) {
+            continue;
+        }
+
+        // stderr-ul copiilor (doar avertismente, fara --verbose) ajunge direct in consola
+        QProcess *process = new QProcess(&loop);
+        process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+
+        auto readResults = [process, &reportsByPath]() {
+            while (process->canReadLine()) {
+                SceneReport report;
+                if (parseResult(QString::fromUtf8(process->readLine()).trimmed(), report)) {
+                    reportsByPath.insert(report.scenePath, report);
+                }
+            }
+        };
+        auto workerDone = [&running, &loop]() {
+            if (--running == 0) {
+                loop.quit();
+            }
+        };
+
+        QObject::connect(process, &QProcess::readyReadStandardOutput, process, readResults);
+        QObject::connect(process, &QProcess::finished, process, [readResults, workerDone]() {
+            readResults();
+            workerDone();
+        });
+        QObject::connect(process, &QProcess::errorOccurred, process, [workerDone](QProcess::ProcessError error) {
+            // Fara finished() in acest caz
+            if (error == QProcess::FailedToStart) {
+                workerDone();
+            }
+        });
+
+        QStringList arguments{ "--worker",
+                               "--size", QString("%1x%2").arg(size.width()).arg(size.height()),
+                               "--timeout", QString::number(timeoutMs) };
+        if (verboseOutput) {
+            arguments << "--verbose";
+        }
+        arguments << outputDir << batch;
+
+        ++running;
+        process->start(QCoreApplication::applicationFilePath(), arguments);
+    }
+
+    if (running > 0) {
+        loop.exec();
+    }
+
+    // Scenele fara rezultat apartin unui proces care a cazut
+    QVector<SceneReport> reports;
+    for (const QString &scenePath : scenePaths) {
+        SceneReport report = reportsByPath.value(scenePath);
+        report.scenePath = scenePath;
+        reports.append(report);
+    }
+    return reports;
+}
+
+void printReport(const QVector<SceneReport> &reports, qint64 wallMs)
+{
+    QTextStream out(stdout);
+    int failures = 0;
+    qint64 totalMs = 0;
+
+    out << QString("%1  %2  %3  %4").arg("scene", -40).arg("status", -6).arg("load ms", 8).arg("render ms", 9)
+        << Qt::endl;
+    for (const SceneReport &report : reports) {
+        out << QString("%1  %2  %3  %4")
+                   .arg(QFileInfo(report.scenePath).fileName(), -40)
+                   .arg(report.success ? "ok" : "FAILED", -6)
+                   .arg(report.loadMs, 8)
+                   .arg(report.renderMs, 9)
+            << Qt::endl;
+        failures += report.success ? 0 : 1;
+        totalMs += report.loadMs + report.renderMs;
+    }
+
+    out << reports.size() << " scenes, " << failures << " failed, " << wallMs << " ms wall, "
+        << (reports.isEmpty() ? 0 : totalMs / reports.size()) << " ms average per scene" << Qt::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    // Fara server grafic: platforma offscreen, OpenGL de la Mesa (llvmpipe) daca nu exista GPU
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QSurfaceFormat format;
+    format.setVersion(3, 3);
+    format.setProfile(QSurfaceFormat::CoreProfile);
+    format.setDepthBufferSize(24);
+    QSurfaceFormat::setDefaultFormat(format);
+
+    QApplication app(argc, argv);
+    // Setari separate de cele ale aplicatiei (camera, podea, ...)
+    QCoreApplication::setApplicationName("3DSceneGenerator-batchrender");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Renders every scene file (JSON or .scnb) in a directory to PNG.");
+    parser.addHelpOption();
+
+    QCommandLineOption jobsOption({ "j", "jobs" }, "Number of renderer processes.", "count", "1");
+    QCommandLineOption sizeOption("size", "Image size.", "WxH", "640x360");
+    QCommandLineOption timeoutOption("timeout", "Per-scene timeout in milliseconds.", "ms", "30000");
+    QCommandLineOption verboseOption("verbose", "Show debug output.");
+    QCommandLineOption workerOption("worker", "Render the listed scene files (internal).");
+    workerOption.setFlags(QCommandLineOption::HiddenFromHelp);
+    parser.addOptions({ jobsOption, sizeOption, timeoutOption, verboseOption, workerOption });
+    parser.addPositionalArgument("scenes", "Directory with scene files.");
+    parser.addPositionalArgument("output", "Directory for the PNG files.");
+    parser.process(app);
+
+    verboseOutput = parser.isSet(verboseOption);
+    qInstallMessageHandler(messageHandler);
+
+    const QStringList sizeParts = parser.value(sizeOption).split('x');
+    const QSize size = sizeParts.size() == 2 ? QSize(sizeParts[0].toInt(), sizeParts[1].toInt()) : QSize();
+    const int timeoutMs = parser.value(timeoutOption).toInt();
+    const QStringList positional = parser.positionalArguments();
+
+    if (!size.isValid() || size.isEmpty() || timeoutMs <= 0) {
+        QTextStream(stderr) << "Invalid --size or --timeout" << Qt::endl;
+        return 2;
+    }
+
+    // Proces copil: output + lista explicita de scene, o linie RESULT per scena
+    if (parser.isSet(workerOption)) {
+        if (positional.size() < 2) {
+            return 2;
+        }
+        renderScenes(positional.mid(1), positional.first(), size, timeoutMs, true);
+        return 0;
+    }
+
+    if (positional.size() != 2) {
+        parser.showHelp(2);
+    }
+
+    const QDir sceneDir(positional[0]);
+    const QString outputDir = positional[1];
+    if (!sceneDir.exists() || !QDir().mkpath(outputDir)) {
+        QTextStream(stderr) << "Cannot read " << positional[0] << " or create " << outputDir << Qt::endl;
+        return 2;
+    }
+
+    QStringList scenePaths;
+    const QFileInfoList files = sceneDir.entryInfoList({ "*.json", "*.scnb" }, QDir::Files, QDir::Name);
+    for (const QFileInfo &file : files) {
+        scenePaths.append(file.absoluteFilePath());
+    }
+
+    const int jobs = qBound(1, parser.value(jobsOption).toInt(), qMax(1, int(scenePaths.size())));
+
+    QElapsedTimer wallTimer;
+    wallTimer.start();
+    const QVector<SceneReport> reports = jobs == 1
+        ? renderScenes(scenePaths, outputDir, size, timeoutMs, false)
+        : renderInWorkers(scenePaths, outputDir, size, timeoutMs, jobs);
+    printReport(reports, wallTimer.elapsed());
+
+    for (const SceneReport &report : reports) {
+        if (!report.success) {
+            return 1;
+        }
+    }
+    return 0;
+}
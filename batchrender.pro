@@ -0,0 +1,14 @@
+# Randare in lot fara fereastra: scene JSON/.scnb dintr-un director -> PNG (vezi batchrender.cpp)
+include(scene.pri)
+
+TARGET = batchrender
+CONFIG += console
+CONFIG -= app_bundle
+
+SOURCES += \
+    batchrender.cpp
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
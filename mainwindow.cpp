@@ -1,5 +1,13 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
+#include "AssetStore.h"
+#include "MeshCooker.h"
+#include "ModelCatalog.h"
+#include "ModelLod.h"
+#include "NlpClient.h"
+#include "SceneBinary.h"
+#include "SceneJsonParser.h"
+#include "TextureBaker.h"
 
 #include <QByteArray>
 #include <QCoreApplication>
@@ -17,21 +25,23 @@
 #include <QFileDialog>
 #include <QDir>
 #include <QProcess>
+#include <QRunnable>
+#include <QThreadPool>
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
-#include <QNetworkAccessManager>
-#include <QNetworkRequest>
-#include <QNetworkReply>
 #include <QJsonDocument>
 #include <QJsonObject>
-#include <QEventLoop>
-#include <QDirIterator>
+#include <QStatusBar>
 #include <QDateTime>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
+    , progressDialog(nullptr)
+    , assetImporter(nullptr)
+    , thumbnailProvider(nullptr)
+    , pendingSceneRequest(0)
 {
     ui->setupUi(this);
 
@@ -66,16 +76,45 @@ MainWindow::MainWindow(QWidget *parent)
     fs->setNameFilters(QStringList() << "*.obj" << "*.fbx");
     fs->setNameFilterDisables(false);
 
+    // Miniaturile generate la import apar ca iconite in arbore
+    const QString primitivesPath = ModelCatalog::instance()->primitivesPath();
+    thumbnailProvider = new ModelThumbnailProvider(primitivesPath);
+    fs->setIconProvider(thumbnailProvider);
+
+    assetImporter = new AssetImporter(primitivesPath, this);
+    connect(assetImporter, &AssetImporter::conflictsFound, this, &MainWindow::onImportConflicts);
+    connect(assetImporter, &AssetImporter::scanProgress, this, &MainWindow::onImportScanProgress);
+    connect(assetImporter, &AssetImporter::progress, this, &MainWindow::onImportProgress);
+    connect(assetImporter, &AssetImporter::finished, this, &MainWindow::onImportFinished);
+    ui->importProgressBar->hide();
+    ui->cancelImportButton->hide();
+
     appSettings = new QSettings("YourCompany", "YourApp", this);
     currentLanguageCode = "en"; // Default
 
+    // Clientul NLP traieste cat fereastra, deci conexiunea catre server este refolosita
+    nlpClient = new NlpClient(NlpClient::defaultServerUrl(), this);
+    connect(nlpClient, &NlpClient::sceneReady, this, &MainWindow::onSceneGenerated);
+    connect(nlpClient, &NlpClient::requestFailed, this, &MainWindow::onSceneGenerationFailed);
+    connect(nlpClient, &NlpClient::requestCancelled, this, &MainWindow::onSceneGenerationCancelled);
+
     setupSettingsTab();
     loadSettings();
+
+    // texturile noi sau modificate sunt coapte in fundal, inainte sa fie cerute de o scena
+    TextureLoader::instance()->bakeLibrary(TextureBaker::texturesPath());
+    // la fel nivelurile de detaliu ale modelelor care nu le au inca
+    ModelLod::generateLibrary(ModelCatalog::instance()->primitivesPath());
+    // si hash-urile de continut folosite la deduplicarea importurilor
+    AssetStore::instance()->indexLibrary();
+    // si modelele gatite, incarcate de GeometryCache fara parser
+    MeshCooker::cookLibrary(ModelCatalog::instance()->primitivesPath());
 }
 
 MainWindow::~MainWindow()
 {
     delete ui;
+    delete thumbnailProvider;
 }
 
 // void MainWindow::on_generate_clicked()
@@ -124,9 +163,7 @@ MainWindow::~MainWindow()
 void MainWindow::on_generate_clicked()
 {
     QString inputText = ui->inputText->toPlainText();
-    QString scriptPath = QCoreApplication::applicationDirPath() + "/../../../NLPprocessing/inp.py";
 
-    qDebug() << "Running Python script:" << scriptPath;
     qDebug() << "Input text:" << inputText;
 
     if (inputText.isEmpty())
@@ -135,17 +172,39 @@ void MainWindow::on_generate_clicked()
         return;
     }
 
-    progressDialog = new QProgressDialog("Generating scene, please wait...", nullptr, 0, 100, this);
-    progressDialog->setWindowModality(Qt::ApplicationModal);
-    progressDialog->setCancelButton(nullptr);
-    progressDialog->setMinimumDuration(200);
-    progressDialog->setValue(50); // Seteaza un progres intermediar
+    // O noua generare inlocuieste cererea care inca asteapta
+    if (pendingSceneRequest != 0) {
+        nlpClient->cancel(pendingSceneRequest);
+    }
+
+    const QString languageCode = getCurrentLanguageCode();
+
+    // Acelasi text (normalizat) in aceeasi limba: scena vine din cache, fara serverul NLP
+    QJsonObject cachedScene;
+    if (!ui->sceneCacheBypassCheckBox->isChecked() && sceneCache.lookup(inputText, languageCode, cachedScene)) {
+        qDebug() << "Scene loaded from cache";
+        currentSceneJson = QString::fromUtf8(QJsonDocument(cachedScene).toJson());
+        currentScenePath.clear();
+        sceneWidget->loadSceneFromJson(cachedScene);
+        updateSceneCacheStats();
+        return;
+    }
 
-    ScriptRunner *scriptRunner = new ScriptRunner(scriptPath, inputText, this);
-    connect(scriptRunner, &ScriptRunner::scriptFinished, this, &MainWindow::on_scriptFinished);
-    connect(scriptRunner, &QThread::finished, scriptRunner, &QObject::deleteLater);
+    pendingScenePrompt = inputText;
+    pendingSceneLanguage = languageCode;
+    pendingSceneRequest = nlpClient->generateScene(inputText, languageCode);
 
-    scriptRunner->start();
+    if (!progressDialog) {
+        progressDialog = new QProgressDialog("Generating scene, please wait...", tr("Cancel"), 0, 0, this);
+        progressDialog->setWindowModality(Qt::ApplicationModal);
+        progressDialog->setMinimumDuration(200);
+        connect(progressDialog, &QProgressDialog::canceled, this, [this]() {
+            if (pendingSceneRequest != 0) {
+                nlpClient->cancel(pendingSceneRequest);
+            }
+        });
+    }
+    progressDialog->show();
 }
 
 // void MainWindow::on_scriptFinished(const QString &outputFile, bool success)
@@ -174,38 +233,51 @@ void MainWindow::on_generate_clicked()
 
 //     sceneWidget->loadScene(fixedOutputFile);
 // }
-void MainWindow::on_scriptFinished(const QString &outputFile, bool success)
+void MainWindow::closeProgressDialog()
 {
-    progressDialog->setValue(100);
-    progressDialog->hide();
-    delete progressDialog;
+    if (progressDialog) {
+        progressDialog->hide();
+    }
+}
 
-    if (!success)
-    {
-        QMessageBox::warning(this, "Error", "Failed to generate scene.");
+void MainWindow::onSceneGenerated(quint64 requestId, const QJsonObject &scene, qint64 elapsedMs)
+{
+    if (requestId != pendingSceneRequest) {
         return;
     }
+    pendingSceneRequest = 0;
+    closeProgressDialog();
 
-    QString fixedOutputFile = QCoreApplication::applicationDirPath() + "/../../../temp/scene_output.json";
-    fixedOutputFile = fixedOutputFile.replace("\\", "/");
+    qDebug() << "Scene generated in" << elapsedMs << "ms; generate latency:" << nlpClient->latency().summary();
 
-    qDebug() << "Script finished, JSON file path:" << fixedOutputFile;
+    sceneCache.store(pendingScenePrompt, pendingSceneLanguage, scene, elapsedMs);
+    updateSceneCacheStats();
 
-    QFile jsonFile(fixedOutputFile);
-    if (!jsonFile.exists())
-    {
-        QMessageBox::warning(this, "Error", "JSON file not found at: " + fixedOutputFile);
+    // Scena vine direct din raspuns; JSON-ul este pastrat pentru salvare ulterioara
+    currentSceneJson = QString::fromUtf8(QJsonDocument(scene).toJson());
+    currentScenePath.clear();
+    sceneWidget->loadSceneFromJson(scene);
+}
+
+void MainWindow::onSceneGenerationFailed(quint64 requestId, const QString &error)
+{
+    if (requestId != pendingSceneRequest) {
         return;
     }
+    pendingSceneRequest = 0;
+    closeProgressDialog();
 
-    // Citeste si pastreaza JSON-ul pentru salvare ulterioara
-    if (jsonFile.open(QIODevice::ReadOnly))
-    {
-        currentSceneJson = jsonFile.readAll();
-        jsonFile.close();
-    }
+    qDebug() << "Scene generation failed:" << error;
+    QMessageBox::warning(this, "Error", "Failed to generate scene.\n" + error);
+}
 
-    sceneWidget->loadScene(fixedOutputFile);
+void MainWindow::onSceneGenerationCancelled(quint64 requestId)
+{
+    if (requestId != pendingSceneRequest) {
+        return;
+    }
+    pendingSceneRequest = 0;
+    closeProgressDialog();
 }
 
 // void MainWindow::on_save_clicked()
@@ -214,6 +286,11 @@ void MainWindow::on_scriptFinished(const QString &outputFile, bool success)
 // }
 void MainWindow::on_save_clicked()
 {
+    if (currentSceneJson.isEmpty() && !currentScenePath.isEmpty())
+    {
+        currentSceneJson = loadedSceneJson();
+    }
+
     if (currentSceneJson.isEmpty())
     {
         QMessageBox::warning(this, "Error", "No scene to save. Please generate a scene first.");
@@ -225,7 +302,7 @@ void MainWindow::on_save_clicked()
         this,
         tr("Save Scene"),
         QDir::homePath() + "/scene.json",
-        tr("JSON Files (*.json);;All Files (*)")
+        tr("JSON Files (*.json);;Binary Scene Files (*.scnb);;All Files (*)")
     );
 
     if (fileName.isEmpty())
@@ -253,6 +330,20 @@ void MainWindow::on_save_clicked()
     sceneObject["saved_timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
     sceneObject["app_version"] = "1.0"; // sau versiunea aplicatiei tale
 
+    // Scenele mari se incarca mult mai repede din formatul binar
+    if (fileName.endsWith(".scnb", Qt::CaseInsensitive))
+    {
+        QString error;
+        if (!SceneBinary::writeFile(sceneObject, fileName, &error))
+        {
+            QMessageBox::critical(this, "Error", "Could not open file for writing: " + error);
+            return;
+        }
+
+        QMessageBox::information(this, "Success", "Scene saved successfully to:\n" + fileName);
+        return;
+    }
+
     // Creeaza noul document JSON
     QJsonDocument saveDoc(sceneObject);
 
@@ -271,6 +362,35 @@ void MainWindow::on_save_clicked()
 }
 
 
+QString MainWindow::loadedSceneJson() const
+{
+    QJsonObject sceneObject;
+    if (SceneBinary::isSceneBinary(currentScenePath))
+    {
+        SceneBinaryReader reader;
+        if (!reader.open(currentScenePath))
+        {
+            return QString();
+        }
+        sceneObject = reader.toJson();
+    }
+    else
+    {
+        QFile loadFile(currentScenePath);
+        if (!loadFile.open(QIODevice::ReadOnly))
+        {
+            return QString();
+        }
+        sceneObject = QJsonDocument::fromJson(loadFile.readAll()).object();
+    }
+
+    // Fara user_input si metadatele de salvare; on_save_clicked le adauga din nou
+    sceneObject.remove("user_input");
+    sceneObject.remove("saved_timestamp");
+    sceneObject.remove("app_version");
+    return sceneObject.isEmpty() ? QString() : QString::fromUtf8(QJsonDocument(sceneObject).toJson());
+}
+
 void MainWindow::on_clear_clicked()
 {
     sceneWidget->clearScene();
@@ -289,7 +409,7 @@ void MainWindow::on_load_clicked()
         this,
         tr("Load Scene"),
         QDir::homePath(),
-        tr("JSON Files (*.json);;All Files (*)")
+        tr("Scene Files (*.json *.scnb);;JSON Files (*.json);;Binary Scene Files (*.scnb);;All Files (*)")
     );
 
     if (fileName.isEmpty())
@@ -297,41 +417,33 @@ void MainWindow::on_load_clicked()
         return; // Utilizatorul a anulat
     }
 
-    // Citeste fisierul
-    QFile loadFile(fileName);
-    if (!loadFile.open(QIODevice::ReadOnly))
+    // Scena este citita direct in SceneDescription: fisierul binar din maparea lui, JSON-ul
+    // intr-o singura trecere (SceneJsonParser), fara un QJsonObject intermediar
+    SceneDescription scene;
+    if (SceneBinary::isSceneBinary(fileName))
     {
-        QMessageBox::critical(this, "Error", "Could not open file for reading: " + loadFile.errorString());
-        return;
-    }
-
-    QByteArray jsonData = loadFile.readAll();
-    loadFile.close();
-
-    // Parseaza JSON-ul
-    QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(jsonData, &parseError);
-
-    if (parseError.error != QJsonParseError::NoError)
-    {
-        QMessageBox::critical(this, "Error", "Failed to parse JSON file: " + parseError.errorString());
-        return;
+        SceneBinaryReader reader;
+        if (!reader.open(fileName))
+        {
+            QMessageBox::critical(this, "Error", "Failed to read binary scene file: " + reader.errorString());
+            return;
+        }
+        reader.toDescription(scene);
     }
-
-    QJsonObject sceneObject = doc.object();
-
-    // Verifica daca este un fisier de scena valid
-    if (!sceneObject.contains("objects") && !sceneObject.contains("scene"))
+    else
     {
-        QMessageBox::warning(this, "Error", "The selected file does not appear to be a valid scene file.");
-        return;
+        SceneJsonParser parser;
+        if (!parser.parseFile(fileName, scene))
+        {
+            QMessageBox::critical(this, "Error", "Failed to parse scene file: " + parser.errorString());
+            return;
+        }
     }
 
     // Extrage si seteaza textul de input daca exista
-    if (sceneObject.contains("user_input"))
+    if (scene.metadata.contains("user_input"))
     {
-        QString userInput = sceneObject["user_input"].toString();
-        ui->inputText->setPlainText(userInput);
+        ui->inputText->setPlainText(scene.metadata.value("user_input"));
     }
     else
     {
@@ -340,38 +452,11 @@ void MainWindow::on_load_clicked()
         QMessageBox::information(this, "Info", "Scene loaded successfully, but no input text was found in the file.");
     }
 
-    // Creeaza un fisier temporar pentru incarcarea scenei
-    QString tempSceneFile = QCoreApplication::applicationDirPath() + "/../../../temp/loaded_scene.json";
+    // JSON-ul pentru salvare este construit doar daca scena chiar este salvata
+    currentSceneJson.clear();
+    currentScenePath = fileName;
 
-    // Creeaza directorul temp daca nu exista
-    QDir tempDir = QFileInfo(tempSceneFile).absoluteDir();
-    if (!tempDir.exists())
-    {
-        tempDir.mkpath(".");
-    }
-
-    // Salveaza JSON-ul pentru incarcare (fara user_input pentru renderer)
-    QJsonObject renderObject = sceneObject;
-    renderObject.remove("user_input");
-    renderObject.remove("saved_timestamp");
-    renderObject.remove("app_version");
-
-    QJsonDocument renderDoc(renderObject);
-    QFile tempFile(tempSceneFile);
-    if (!tempFile.open(QIODevice::WriteOnly))
-    {
-        QMessageBox::critical(this, "Error", "Could not create temporary file for scene rendering.");
-        return;
-    }
-
-    tempFile.write(renderDoc.toJson());
-    tempFile.close();
-
-    // Pastreaza JSON-ul curent pentru salvari ulterioare
-    currentSceneJson = renderDoc.toJson();
-
-    // incarca scena in renderer
-    sceneWidget->loadScene(tempSceneFile);
+    sceneWidget->loadSceneDescription(scene);
 
     QMessageBox::information(this, "Success", "Scene loaded successfully!");
 }
@@ -417,6 +502,17 @@ void MainWindow::on_deleteModel_clicked()
             if (fileInfo.isFile())
             {
                 if (QFile::remove(filePath)) {
+                    // Nivelurile de detaliu generate pentru model dispar odata cu el, pe aceeasi
+                    // coada pe care sunt scrise
+                    if (ModelLod::canGenerate(filePath)) {
+                        ModelLod::queue()->start(QRunnable::create([filePath]() {
+                            ModelLod::removeLods(filePath);
+                            MeshCooker::remove(filePath);
+                        }));
+                    }
+                    AssetStore::instance()->forget(filePath);
+                    QFile::remove(AssetImporter::thumbnailPath(ModelCatalog::instance()->primitivesPath(), filePath));
+                    ModelCatalog::instance()->rescan();
                     QMessageBox::information(this, "Success", "File deleted successfully.");
 
                     // Daca fisierul sters este cel incarcat in scena, sterge modelul din scena
@@ -432,6 +528,7 @@ void MainWindow::on_deleteModel_clicked()
 
                 if  (dir.removeRecursively())
                 {
+                    ModelCatalog::instance()->rescan();
                     QMessageBox::information(this, "Success", "Directory deleted successfully.");
 
                     // Daca fisierul sters este cel incarcat in scena, sterge modelul din scena
@@ -470,7 +567,7 @@ void MainWindow::on_importModel_clicked()
         );
 
         if (!selectedFiles.isEmpty()) {
-            importFiles(selectedFiles);
+            startImport(selectedFiles);
         }
     } else {
         // Import director
@@ -482,205 +579,99 @@ void MainWindow::on_importModel_clicked()
         );
 
         if (!selectedDir.isEmpty()) {
-            importDirectory(selectedDir);
+            startImport(QStringList() << selectedDir);
         }
     }
 }
 
-// Functie pentru importul de fisiere
-void MainWindow::importFiles(const QStringList &filePaths)
+// Importul (fisiere sau directoare) ruleaza in fundal; fereastra ramane utilizabila
+void MainWindow::startImport(const QStringList &sources)
 {
-    QString primitivesDirPath = QCoreApplication::applicationDirPath() + "/../../../Models/primitives/";
-
-    QDir primitivesDir(primitivesDirPath);
-    if (!primitivesDir.exists()) {
-        primitivesDir.mkpath(".");
-    }
-
-    int successCount = 0;
-    int totalCount = filePaths.size();
-    QStringList failedFiles;
-    bool overwriteAll = false;
-    bool skipAll = false;
-
-    for (const QString &filePath : filePaths) {
-        QFileInfo fileInfo(filePath);
-        if (!fileInfo.isFile()) continue;
-
-        QString destinationPath = primitivesDirPath + fileInfo.fileName();
-
-        if (QFile::exists(destinationPath) && !overwriteAll && !skipAll) {
-            QMessageBox msgBox;
-            msgBox.setWindowTitle(tr("File Exists"));
-            msgBox.setText(tr("File '%1' already exists in primitives.").arg(fileInfo.fileName()));
-            msgBox.setInformativeText(tr("What would you like to do?"));
-
-            QPushButton *overwriteBtn = msgBox.addButton(tr("Overwrite"), QMessageBox::AcceptRole);
-            QPushButton *overwriteAllBtn = msgBox.addButton(tr("Overwrite All"), QMessageBox::AcceptRole);
-            QPushButton *skipBtn = msgBox.addButton(tr("Skip"), QMessageBox::RejectRole);
-            QPushButton *skipAllBtn = msgBox.addButton(tr("Skip All"), QMessageBox::RejectRole);
-            msgBox.addButton(QMessageBox::Cancel);
-
-            msgBox.exec();
-
-            if (msgBox.clickedButton() == overwriteAllBtn) {
-                overwriteAll = true;
-            } else if (msgBox.clickedButton() == skipBtn) {
-                continue;
-            } else if (msgBox.clickedButton() == skipAllBtn) {
-                skipAll = true;
-                continue;
-            } else if (msgBox.clickedButton() != overwriteBtn) {
-                break; // Cancel
-            }
-        }
-
-        if (skipAll) continue;
-
-        if (QFile::exists(destinationPath)) {
-            QFile::remove(destinationPath);
-        }
-
-        if (QFile::copy(filePath, destinationPath)) {
-            successCount++;
-        } else {
-            failedFiles.append(fileInfo.fileName());
-        }
+    assetImporter->setHardlinksAllowed(ui->importHardlinksCheckBox->isChecked());
+    if (!assetImporter->start(sources)) {
+        QMessageBox::information(this, tr("Import Running"),
+            tr("Another import is still running. Wait for it to finish or cancel it."));
+        return;
     }
 
-    // Afiseaza rezultatul
-    if (successCount == totalCount) {
-        QMessageBox::information(this, tr("Success"),
-            tr("Successfully imported %1 file(s) to primitives.").arg(successCount));
-    } else {
-        QString message = tr("Imported %1 of %2 files.").arg(successCount).arg(totalCount);
-        if (!failedFiles.isEmpty()) {
-            message += tr("\nFailed files: %1").arg(failedFiles.join(", "));
-        }
-        QMessageBox::warning(this, tr("Import Result"), message);
-    }
+    // Pana la terminarea scanarii nu stim cate fisiere sunt
+    ui->importProgressBar->setRange(0, 0);
+    ui->importProgressBar->show();
+    ui->cancelImportButton->show();
 }
 
-// Functie pentru importul de directoare
-void MainWindow::importDirectory(const QString &dirPath)
+// Un singur raspuns pentru toate fisierele care exista deja
+void MainWindow::onImportConflicts(const QStringList &fileNames, int total)
 {
-    QString primitivesDirPath = QCoreApplication::applicationDirPath() + "/../../../Models/primitives/";
-
-    QDir primitivesDir(primitivesDirPath);
-    if (!primitivesDir.exists()) {
-        primitivesDir.mkpath(".");
-    }
-
-    // Colecteaza toate fisierele de model din director si subdirectoare
-    QStringList modelFiles = collectModelFiles(dirPath);
-
-    if (modelFiles.isEmpty()) {
-        QMessageBox::information(this, tr("No Models Found"),
-            tr("No supported 3D model files found in the selected directory."));
-        return;
-    }
-
-    int successCount = 0;
-    QStringList failedFiles;
-
-    for (const QString &filePath : modelFiles) {
-        QFileInfo fileInfo(filePath);
-        QString destinationPath = primitivesDirPath + fileInfo.fileName();
-
-        // Pentru import masiv, renumeroteaza automat fisierele duplicate
-        if (QFile::exists(destinationPath)) {
-            QString baseName = fileInfo.completeBaseName();
-            QString extension = fileInfo.suffix();
-            int counter = 1;
-
-            do {
-                destinationPath = primitivesDirPath + QString("%1_%2.%3")
-                    .arg(baseName).arg(counter).arg(extension);
-                counter++;
-            } while (QFile::exists(destinationPath));
-        }
-
-        if (QFile::copy(filePath, destinationPath)) {
-            successCount++;
-        } else {
-            failedFiles.append(fileInfo.fileName());
-        }
-    }
-
-    // Afiseaza rezultatul
-    QString message = tr("Successfully imported %1 of %2 model files from directory to primitives.")
-        .arg(successCount).arg(modelFiles.size());
-
-    if (!failedFiles.isEmpty()) {
-        message += tr("\nFailed files: %1").arg(failedFiles.join(", "));
-        QMessageBox::warning(this, tr("Import Complete"), message);
-    } else {
-        QMessageBox::information(this, tr("Import Complete"), message);
-    }
+    QMessageBox msgBox(this);
+    msgBox.setWindowTitle(tr("Files Exist"));
+    msgBox.setText(tr("%1 of %2 files already exist in primitives.").arg(fileNames.size()).arg(total));
+    msgBox.setInformativeText(tr("What would you like to do with all of them?"));
+    msgBox.setDetailedText(fileNames.join("\n"));
+
+    QPushButton *overwriteAllBtn = msgBox.addButton(tr("Overwrite All"), QMessageBox::AcceptRole);
+    QPushButton *keepBothBtn = msgBox.addButton(tr("Keep Both"), QMessageBox::AcceptRole);
+    QPushButton *skipAllBtn = msgBox.addButton(tr("Skip All"), QMessageBox::RejectRole);
+    msgBox.addButton(QMessageBox::Cancel);
+
+    msgBox.exec();
+
+    AssetImporter::ConflictPolicy policy = AssetImporter::ConflictPolicy::Ask; // Cancel
+    if (msgBox.clickedButton() == overwriteAllBtn) {
+        policy = AssetImporter::ConflictPolicy::Overwrite;
+    } else if (msgBox.clickedButton() == keepBothBtn) {
+        policy = AssetImporter::ConflictPolicy::Rename;
+    } else if (msgBox.clickedButton() == skipAllBtn) {
+        policy = AssetImporter::ConflictPolicy::Skip;
+    }
+    assetImporter->resolveConflicts(policy);
 }
 
-// Functie helper pentru colectarea fisierelor de model recursiv
-QStringList MainWindow::collectModelFiles(const QString &dirPath)
+void MainWindow::onImportScanProgress(int hashed, int total)
 {
-    QStringList modelFiles;
-    QStringList nameFilters;
-    nameFilters << "*.obj" << "*.fbx" << "*.gltf" << "*.glb"
-                << "*.3ds" << "*.dae" << "*.ply" << "*.stl";
-
-    QDirIterator iterator(dirPath, nameFilters, QDir::Files, QDirIterator::Subdirectories);
-
-    while (iterator.hasNext()) {
-        modelFiles.append(iterator.next());
-    }
-
-    return modelFiles;
+    ui->importProgressBar->setRange(0, total);
+    ui->importProgressBar->setValue(hashed);
+    ui->importProgressBar->setFormat(tr("Checking %1 / %2 files").arg(hashed).arg(total));
 }
 
-ScriptRunner::ScriptRunner(const QString &scriptPath, const QString &inputText, QObject *parent)
-    : QThread(parent), scriptPath(scriptPath), inputText(inputText) {}
-
-void ScriptRunner::run()
+void MainWindow::onImportProgress(int done, int total, qint64 bytesDone, qint64 bytesTotal)
 {
-    QNetworkAccessManager manager;
-    QNetworkRequest request(QUrl("http://127.0.0.1:5000/process"));
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    ui->importProgressBar->setRange(0, total);
+    ui->importProgressBar->setValue(done);
+    ui->importProgressBar->setFormat(tr("%1 / %2 files (%3 / %4 MB)")
+        .arg(done).arg(total)
+        .arg(bytesDone / (1024 * 1024)).arg(bytesTotal / (1024 * 1024)));
+}
 
-    QJsonObject json;
-    json["text"] = inputText;
+void MainWindow::onImportFinished(const AssetImporter::Summary &summary)
+{
+    ui->importProgressBar->hide();
+    ui->cancelImportButton->hide();
 
-    MainWindow *mainWindow = qobject_cast<MainWindow*>(parent());
-    if (mainWindow) {
-        json["lang"] = mainWindow->getCurrentLanguageCode();
-    } else {
-        json["lang"] = "en"; // Fallback
+    QString message = tr("Imported %1 model file(s) to primitives").arg(summary.imported);
+    if (summary.skipped > 0) {
+        message += tr(", skipped %1").arg(summary.skipped);
     }
-
-    QJsonDocument jsonDoc(json);
-    QByteArray jsonData = jsonDoc.toJson();
-
-    QNetworkReply *reply = manager.post(request, jsonData);
-    QEventLoop loop;
-    connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-    loop.exec();
-
-    if (reply->error() != QNetworkReply::NoError)
-    {
-        qDebug() << "HTTP request failed:" << reply->errorString();
-        emit scriptFinished("", false);
-        return;
+    if (summary.deduplicated > 0 || summary.linked > 0) {
+        message += tr(", %1 already in the library, %2 sharing storage with it (%3 MB saved)")
+            .arg(summary.deduplicated).arg(summary.linked).arg(summary.bytesSaved / (1024 * 1024));
     }
+    if (summary.cancelled) {
+        message += tr(" (cancelled)");
+    }
+    message += ".";
 
-    QByteArray responseData = reply->readAll();
-    qDebug() << "Received JSON response:" << responseData;
-
-    QFile jsonFile("temp/scene.json");
-    if (jsonFile.open(QIODevice::WriteOnly))
-    {
-        jsonFile.write(responseData);
-        jsonFile.close();
+    if (summary.failed > 0) {
+        message += tr("\nFailed files:\n%1").arg(summary.failedFiles.join("\n"));
+        QMessageBox::warning(this, tr("Import Result"), message);
+    } else {
+        statusBar()->showMessage(message, 10000);
     }
+}
 
-    emit scriptFinished("temp/scene.json", true);
+void MainWindow::on_cancelImportButton_clicked()
+{
+    assetImporter->cancel();
 }
 
 void MainWindow::setupSettingsTab()
@@ -700,12 +691,63 @@ void MainWindow::setupSettingsTab()
     // Conecteaza signal-ul
     connect(ui->lLanguageComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &MainWindow::onLanguageChanged);
+
+    // Randarea instantiata poate fi comutata fara reincarcarea scenei
+    ui->instancedRenderingCheckBox->setChecked(sceneWidget->isInstancedRendering());
+    connect(ui->instancedRenderingCheckBox, &QCheckBox::toggled, this, [this](bool checked) {
+        sceneWidget->setInstancedRendering(checked);
+    });
+
+    // Incarcarea incrementala pastreaza obiectele nemodificate (pozitie, faze de animatie),
+    // de aceea ramane o optiune explicita; este salvata odata cu setarile scenei
+    ui->incrementalLoadingCheckBox->setChecked(sceneWidget->isIncrementalLoading());
+    connect(ui->incrementalLoadingCheckBox, &QCheckBox::toggled, this, [this](bool checked) {
+        sceneWidget->setIncrementalLoading(checked);
+    });
+
+    // Cache-ul de scene: ocolire la cerere, invalidare pentru promptul curent sau totala
+    connect(ui->sceneCacheBypassCheckBox, &QCheckBox::toggled, this, [this](bool checked) {
+        appSettings->setValue("sceneCacheBypass", checked);
+    });
+    connect(ui->forgetPromptButton, &QPushButton::clicked, this, [this]() {
+        sceneCache.invalidate(ui->inputText->toPlainText(), getCurrentLanguageCode());
+        updateSceneCacheStats();
+    });
+    connect(ui->clearSceneCacheButton, &QPushButton::clicked, this, [this]() {
+        sceneCache.clear();
+        updateSceneCacheStats();
+    });
+
+    connect(ui->importHardlinksCheckBox, &QCheckBox::toggled, this, [this](bool checked) {
+        appSettings->setValue("importHardlinks", checked);
+    });
+    updateSceneCacheStats();
+}
+
+void MainWindow::updateSceneCacheStats()
+{
+    const quint64 lookups = sceneCache.hits() + sceneCache.misses();
+    ui->sceneCacheStatsLabel->setText(
+        QString("Hits: %1 / %2 (%3%, %4 memory, %5 disk), generation time saved: %6 s | "
+                "memory: %7 scenes, %8 KB | disk: %9 scenes, %10 KB")
+            .arg(sceneCache.hits())
+            .arg(lookups)
+            .arg(qRound(sceneCache.hitRate() * 100.0f))
+            .arg(sceneCache.memoryHits())
+            .arg(sceneCache.diskHits())
+            .arg(sceneCache.savedMilliseconds() / 1000.0, 0, 'f', 1)
+            .arg(sceneCache.memoryEntryCount())
+            .arg(sceneCache.memoryBytes() / 1024)
+            .arg(sceneCache.diskEntryCount())
+            .arg(sceneCache.diskBytes() / 1024));
 }
 
 void MainWindow::loadSettings()
 {
     // incarca limba salvata sau foloseste default-ul
     currentLanguageCode = appSettings->value("language", "en").toString();
+    ui->sceneCacheBypassCheckBox->setChecked(appSettings->value("sceneCacheBypass", false).toBool());
+    ui->importHardlinksCheckBox->setChecked(appSettings->value("importHardlinks", false).toBool());
 
     // Seteaza combo box-ul la limba corecta
     for (int i = 0; i < ui->lLanguageComboBox->count(); ++i) {
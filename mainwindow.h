@@ -2,9 +2,11 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
-#include <QThread>
 #include <QProgressDialog>
 #include "myopenglwidget.h"
+#include "AssetImporter.h"
+#include "NlpClient.h"
+#include "SceneResultCache.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -12,22 +14,6 @@ class MainWindow;
 }
 QT_END_NAMESPACE
 
-class ScriptRunner : public QThread
-{
-    Q_OBJECT
-
-public:
-    explicit ScriptRunner(const QString &scriptPath, const QString &inputText, QObject *parent = nullptr);
-    void run() override;
-
-signals:
-    void scriptFinished(const QString &outputFile, bool success);
-
-private:
-    QString scriptPath;
-    QString inputText;
-};
-
 class MainWindow : public QMainWindow
 {
     Q_OBJECT
@@ -55,20 +41,36 @@ private slots:
 
     void on_importModel_clicked();
 
-    void on_scriptFinished(const QString &outputFile, bool success);
+    void on_cancelImportButton_clicked();
+
+    // Raspunsurile serverului NLP (vezi NlpClient); cele pentru cereri inlocuite sunt ignorate
+    void onSceneGenerated(quint64 requestId, const QJsonObject &scene, qint64 elapsedMs);
+    void onSceneGenerationFailed(quint64 requestId, const QString &error);
+    void onSceneGenerationCancelled(quint64 requestId);
 
     void onLanguageChanged(int index);
 
 private:
-    void importFiles(const QStringList &filePaths);
-    void importDirectory(const QString &dirPath);
+    // Importul ruleaza in fundal (vezi AssetImporter); progresul apare sub arborele de modele
+    void startImport(const QStringList &sources);
+    void onImportConflicts(const QStringList &fileNames, int total);
+    void onImportScanProgress(int hashed, int total);
+    void onImportProgress(int done, int total, qint64 bytesDone, qint64 bytesTotal);
+    void onImportFinished(const AssetImporter::Summary &summary);
 
-    QStringList collectModelFiles(const QString &dirPath);
     Ui::MainWindow *ui;
     MyOpenGLWidget *viewerWidget;
     MyOpenGLWidget *sceneWidget;
     QProgressDialog *progressDialog;
+    AssetImporter *assetImporter;
+    ModelThumbnailProvider *thumbnailProvider;
+    NlpClient *nlpClient;
+    quint64 pendingSceneRequest; // 0 cand nu se genereaza nicio scena
+    QString pendingScenePrompt;
+    QString pendingSceneLanguage;
+    SceneResultCache sceneCache;
     QString currentSceneJson;
+    QString currentScenePath; // scena deschisa din fisier; JSON-ul ei este construit doar la salvare
 
     QSettings *appSettings;
     QString currentLanguageCode;
@@ -76,5 +78,8 @@ private:
     void setupSettingsTab();
     void loadSettings();
     void saveSettings();
+    void closeProgressDialog();
+    QString loadedSceneJson() const;
+    void updateSceneCacheStats();
 };
 #endif // MAINWINDOW_H
@@ -1,5 +1,17 @@
 #include "myopenglwidget.h"
 #include "PBRMaterial.h"
+#include "AssetStore.h"
+#include "ModelCatalog.h"
+#include "GeometryCache.h"
+#include "InstancedRenderer.h"
+#include "MaterialCache.h"
+#include "ModelBounds.h"
+#include "OffscreenRenderer.h"
+#include "TextureLoader.h"
+#include "SceneBinary.h"
+#include "SceneLayoutSolver.h"
+#include "SceneJsonParser.h"
+#include "AnimationKernel.h"
 #include <QOpenGLShaderProgram>
 #include <QVBoxLayout>
 #include <Qt3DCore/QEntity>
@@ -13,6 +25,7 @@
 #include <Qt3DExtras/QOrbitCameraController>
 #include <Qt3DExtras/QForwardRenderer>
 #include <Qt3DExtras/QPlaneMesh>
+#include <Qt3DLogic/QFrameAction>
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -24,39 +37,73 @@
 #include <QCoreApplication>
 #include <QStandardPaths>
 #include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QtMath>
 
-MyOpenGLWidget::MyOpenGLWidget(QWidget *parent)
-    : QWidget(parent), m_floorLevel(-2.0f), m_floorSize(20.0f), m_language("en")
+MyOpenGLWidget::MyOpenGLWidget(QWidget *parent, const QSize &offscreenSize)
+    : QWidget(parent), view(nullptr), m_offscreen(nullptr), m_floorLevel(-2.0f), m_floorSize(20.0f), m_language("en")
 {
-    // Configurare Qt3DWindow
-    view = new Qt3DExtras::Qt3DWindow();
-    view->defaultFrameGraph()->setClearColor(QColor(QRgb(0x4d4d4f)));
-
     // Creare rootEntity
     rootEntity = new Qt3DCore::QEntity();
-    view->setRootEntity(rootEntity);
 
-    // Crearea containerului
-    QWidget *container = QWidget::createWindowContainer(view, this);
-    container->setMinimumSize(QSize(400, 300));
+    // Configurare Qt3DWindow, sau randare intr-o textura cand nu exista fereastra
+    if (offscreenSize.isValid()) {
+        m_offscreen = new OffscreenRenderer(offscreenSize, this);
+        m_offscreen->setClearColor(QColor(QRgb(0x4d4d4f)));
+        m_offscreen->setRootEntity(rootEntity);
+        camera = m_offscreen->camera();
+    } else {
+        view = new Qt3DExtras::Qt3DWindow();
+        view->defaultFrameGraph()->setClearColor(QColor(QRgb(0x4d4d4f)));
+        view->setRootEntity(rootEntity);
+        camera = view->camera();
+    }
 
-    // Layout pentru MyOpenGLWidget
-    QVBoxLayout *layout = new QVBoxLayout(this);
-    layout->addWidget(container);
-    setLayout(layout);
+    // Geometria modelelor este partajata intre entitatile de acelasi tip
+    m_geometryCache = new GeometryCache(rootEntity);
+    m_instancedRenderer = new InstancedRenderer(rootEntity);
+    m_materialCache = new MaterialCache(rootEntity);
+    m_instancedRendering = false;
+    m_incrementalLoading = false;
+    m_frustumCulling = true;
+    m_cullingDistance = 0.0f;
+    m_cullingDirty = true;
+    m_cullingResync = true;
+    m_snapshotResync = true;
+    m_levelOfDetail = true;
+
+    // Animatiile si fizica ruleaza pe un fir separat (dimensiunea celulei se citeste din setari)
+    m_simulation = new SimulationWorker();
+    m_collisionCellSize = DEFAULT_COLLISION_CELL_SIZE;
+    m_averageAnimationFrameTime = 0.0f;
+    qDebug() << "Animation kernel:" << (AnimationKernel::isVectorized() ? "SSE2" : "scalar");
+
+    if (view) {
+        // Crearea containerului
+        QWidget *container = QWidget::createWindowContainer(view, this);
+        container->setMinimumSize(QSize(400, 300));
+
+        // Layout pentru MyOpenGLWidget
+        QVBoxLayout *layout = new QVBoxLayout(this);
+        layout->addWidget(container);
+        setLayout(layout);
+
+        camera->lens()->setPerspectiveProjection(45.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
+    }
 
     // Configurare camera
-    Qt3DRender::QCamera *camera = view->camera();
-    camera->lens()->setPerspectiveProjection(45.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
     camera->setPosition(QVector3D(0, 110, 20));
     camera->setViewCenter(QVector3D(-5, 0, -5));
     camera->setUpVector(QVector3D(0, 1, 0));
 
-    // Controlul camerei
-    Qt3DExtras::QOrbitCameraController *camController = new Qt3DExtras::QOrbitCameraController(rootEntity);
-    camController->setLinearSpeed(50.0f);
-    camController->setLookSpeed(180.0f);
-    camController->setCamera(camera);
+    // Controlul camerei (doar cand exista o fereastra care primeste input)
+    if (view) {
+        Qt3DExtras::QOrbitCameraController *camController = new Qt3DExtras::QOrbitCameraController(rootEntity);
+        camController->setLinearSpeed(50.0f);
+        camController->setLookSpeed(180.0f);
+        camController->setCamera(camera);
+    }
 
     // Crearea podelei imbunatatite
     setupFloor();
@@ -64,27 +111,38 @@ MyOpenGLWidget::MyOpenGLWidget(QWidget *parent)
     // Configurare iluminare
     setupLighting();
 
-    // Configurare timere pentru animatii si fizica
-    m_animationTimer = new QTimer(this);
-    connect(m_animationTimer, &QTimer::timeout, this, &MyOpenGLWidget::updateAnimations);
-    m_animationTimer->start(16); // ~60 FPS
-
-    m_physicsTimer = new QTimer(this);
-    connect(m_physicsTimer, &QTimer::timeout, this, &MyOpenGLWidget::updatePhysics);
-    m_physicsTimer->start(16); // ~60 FPS
-
-    // Initialize animation time
-    m_animationTime = 0.0f;
+    // Rezultatele simularii sunt aplicate o data pe cadru randat
+    Qt3DLogic::QFrameAction *frameAction = new Qt3DLogic::QFrameAction(rootEntity);
+    connect(frameAction, &Qt3DLogic::QFrameAction::triggered, this, &MyOpenGLWidget::applySimulationSnapshot);
+    connect(frameAction, &Qt3DLogic::QFrameAction::triggered, this, &MyOpenGLWidget::updateCulling);
+    rootEntity->addComponent(frameAction);
+
+    // Nivelurile de detaliu generate in fundal apar in catalog la reindexare
+    connect(ModelCatalog::instance(), &ModelCatalog::catalogChanged, this, [this]() {
+        m_lodInfo.clear();
+        m_cullingDirty = true;
+    });
+    // Hash-urile calculate in fundal unesc in GeometryCache caile cu acelasi continut
+    connect(AssetStore::instance(), &AssetStore::entryChanged, this, [this](const QString &modelPath) {
+        m_geometryCache->updateKey(modelPath);
+    });
 
     // Load settings
     m_settings = new QSettings(this);
     loadSettings();
+
+    m_simulation->start();
 }
 
 MyOpenGLWidget::~MyOpenGLWidget()
 {
     saveSettings();
+    delete m_instancedRenderer;
+    delete m_materialCache;
+    delete m_geometryCache;
+    delete m_simulation; // opreste si asteapta firul de simulare
     delete view;
+    delete m_offscreen;
 }
 
 void MyOpenGLWidget::setupFloor()
@@ -141,14 +199,36 @@ void MyOpenGLWidget::setupLighting()
 void MyOpenGLWidget::clearScene()
 {
     if (rootEntity) {
+        // texturile scenei vechi care inca se decodeaza nu mai sunt necesare
+        m_materialCache->cancelPendingTextures();
+
         // sterge obiectele din scene
-        for (auto it = m_sceneObjects.begin(); it != m_sceneObjects.end(); ++it) {
-            if (it.value().entity) {
-                delete it.value().entity;
+        for (int i = 0; i < m_sceneStore.size(); ++i) {
+            if (m_sceneStore.entities[i]) {
+                delete m_sceneStore.entities[i];
             }
+            m_geometryCache->release(ModelLod::levelPath(m_sceneStore.modelPaths[i],
+                                                         m_sceneStore.lodLevels[i]));
+            m_materialCache->release(m_sceneStore.materials[i]);
         }
-        m_sceneObjects.clear();
-        m_orbitalAnimations.clear();
+        m_sceneStore.clear();
+        m_loadedScene.clear();
+        m_culler.invalidate();
+        m_cullingResync = true;
+
+        SimulationCommand command;
+        command.type = SimulationCommand::Clear;
+        m_simulation->post(command);
+        m_instancedRenderer->clear();
+
+        qDebug() << "Geometry cache after clear:" << m_geometryCache->entryCount() << "entries,"
+                 << m_geometryCache->bytesResident() << "bytes resident, hit rate"
+                 << m_geometryCache->hitRate() << "," << m_geometryCache->cookedLoads() << "loaded from cooked meshes";
+        qDebug() << "Material cache after clear:" << m_materialCache->uniqueMaterialCount() << "materials,"
+                 << m_materialCache->uniqueEffectCount() << "effects";
+        qDebug() << "Texture loader:" << TextureLoader::instance()->pendingCount() << "pending,"
+                 << TextureLoader::instance()->completedCount() << "completed,"
+                 << TextureLoader::instance()->cancelledCount() << "cancelled";
     }
 }
 
@@ -161,11 +241,11 @@ void MyOpenGLWidget::loadModel(const QString &filePath)
         return;
     }
 
-    Qt3DRender::QMesh *mesh = new Qt3DRender::QMesh();
-    mesh->setSource(QUrl::fromLocalFile(modelPath));
+    Qt3DRender::QGeometryRenderer *mesh = m_geometryCache->acquire(modelPath);
 
-    Qt3DExtras::QPhongMaterial *material = new Qt3DExtras::QPhongMaterial(rootEntity);
-    material->setDiffuse(QColor(150, 150, 150));
+    // Materialul vine din cache, ca sa fie eliberat de clearScene odata cu modelul
+    Qt3DRender::QMaterial *material =
+        m_materialCache->acquire(QFileInfo(filePath).baseName(), QColor(150, 150, 150), MaterialCache::Kind::Phong);
 
     Qt3DCore::QEntity *modelEntity = new Qt3DCore::QEntity(rootEntity);
     modelEntity->addComponent(mesh);
@@ -180,272 +260,324 @@ void MyOpenGLWidget::loadModel(const QString &filePath)
     sceneObj.type = QFileInfo(filePath).baseName();
     sceneObj.color = "#969696";
     sceneObj.size = "medium";
+    sceneObj.modelPath = modelPath;
     sceneObj.position = QVector3D(0, 0, 0);
     sceneObj.originalPosition = QVector3D(0, 0, 0);
     sceneObj.entity = modelEntity;
     sceneObj.transform = transform;
+    sceneObj.material = material;
     sceneObj.boundingSphereRadius = 1.0f;
 
-    m_sceneObjects["preview_model"] = sceneObj;
+    const SceneStore::Handle handle = m_sceneStore.add(sceneObj);
+    calculateBoundingBox(sceneObj.type, sceneObj.size,
+                         m_sceneStore.localBoundsMin[handle], m_sceneStore.localBoundsMax[handle]);
+    postAddObject(handle);
 
     qDebug() << "Loaded preview model:" << sceneObj.type << "with entity:" << modelEntity;
 }
 
-QJsonObject MyOpenGLWidget::parseSceneFile(const QString &filePath)
+bool MyOpenGLWidget::parseSceneFile(const QString &filePath, SceneDescription &scene)
 {
-    QFile jsonFile(filePath);
-    if (!jsonFile.exists()) {
-        qDebug() << "JSON file not found:" << filePath;
-        return QJsonObject();
-    }
-
-    if (!jsonFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qDebug() << "Could not open JSON file:" << filePath;
-        return QJsonObject();
-    }
-
-    QByteArray jsonData = jsonFile.readAll();
-    jsonFile.close();
-
-    QJsonParseError parseError;
-    QJsonDocument jsonDoc = QJsonDocument::fromJson(jsonData, &parseError);
-
-    if (parseError.error != QJsonParseError::NoError) {
-        qDebug() << "JSON parse error:" << parseError.errorString();
-        return QJsonObject();
+    // Scenele binare sunt citite direct din fisierul mapat; structura este garantata de format
+    if (SceneBinary::isSceneBinary(filePath)) {
+        SceneBinaryReader reader;
+        if (!reader.open(filePath)) {
+            qDebug() << "Could not load binary scene:" << reader.errorString();
+            return false;
+        }
+        reader.toDescription(scene);
+        return true;
     }
 
-    QJsonObject jsonObject = jsonDoc.object();
-
-    if (!validateJsonStructure(jsonObject)) {
-        qDebug() << "Invalid JSON structure";
-        return QJsonObject();
+    // Parsare si validare a schemei intr-o singura trecere
+    SceneJsonParser parser;
+    if (!parser.parseFile(filePath, scene)) {
+        qDebug() << "Scene parse error:" << parser.errorString();
+        return false;
     }
-
-    return jsonObject;
+    return true;
 }
 
-bool MyOpenGLWidget::validateJsonStructure(const QJsonObject &jsonObject)
+void MyOpenGLWidget::loadScene(const QString &filePath)
 {
-    // Verifica structura obligatorie
-    if (!jsonObject.contains("objects") || !jsonObject["objects"].isArray()) {
-        qDebug() << "Missing or invalid 'objects' array";
-        return false;
+    SceneDescription scene;
+    if (!parseSceneFile(filePath, scene)) {
+        return;
     }
 
-    if (!jsonObject.contains("relations") || !jsonObject["relations"].isArray()) {
-        qDebug() << "Missing or invalid 'relations' array";
-        return false;
+    loadSceneDescription(scene);
 }
 
-    QJsonArray objects = jsonObject["objects"].toArray();
-    for (const QJsonValue &value : objects) {
-        QJsonObject obj = value.toObject();
-        if (!obj.contains("object") || !obj.contains("id")) {
-            qDebug() << "Object missing required fields (object, id)";
-            return false;
-        }
+void MyOpenGLWidget::loadSceneFromJson(const QJsonObject &jsonObject)
+{
+    SceneDescription scene;
+    QString error;
+    if (!SceneDescription::fromJson(jsonObject, scene, &error)) {
+        qDebug() << "Invalid JSON structure:" << error;
+        return;
     }
 
-    return true;
+    loadSceneDescription(scene);
 }
 
-void MyOpenGLWidget::loadScene(const QString &filePath)
+void MyOpenGLWidget::loadSceneDescription(const SceneDescription &scene)
 {
-    QJsonObject jsonObject = parseSceneFile(filePath);
-    if (jsonObject.isEmpty()) {
+    // O scena rafinata (acelasi prompt, cateva obiecte in plus) modifica doar ce s-a schimbat
+    if (m_incrementalLoading && !m_sceneStore.isEmpty() && !m_loadedScene.isEmpty()) {
+        applySceneDiff(scene);
+        m_loadedScene = scene;
         return;
     }
 
     clearScene();
 
-    QJsonArray objectsArray = jsonObject["objects"].toArray();
-    QJsonArray relationsArray = jsonObject["relations"].toArray();
-    QJsonArray animationCouplesArray = jsonObject.value("animation_couples").toArray();
-
-    // Generare culori pentru obiecte
-    QMap<QString, QString> objectColors;
-    for (const QJsonValue &value : objectsArray) {
-        QJsonObject obj = value.toObject();
-        QString objectType = obj["object"].toString();
-        QString color = obj["attributes"].toObject()["color"].toString();
-
-        if (color.isEmpty()) {
-            // Generare culoare aleatorie
-            QColor randomColor(QRandomGenerator::global()->bounded(50, 255),
-                             QRandomGenerator::global()->bounded(50, 255),
-                             QRandomGenerator::global()->bounded(50, 255));
-            color = randomColor.name();
-        }
-        objectColors[objectType] = color;
-    }
-
-    // Generare pozitii
-    QMap<QString, QVector3D> objectPositions = generateObjectPositions(objectsArray, relationsArray);
-
-    // Rezolvare coliziuni
-    resolveCollisions(objectPositions);
+    // Generare pozitii (relatii si coliziuni rezolvate impreuna)
+    QMap<QString, QVector3D> objectPositions = generateObjectPositions(scene);
 
     // Spawn obiecte in scena
-    spawnObjectsInScene(objectPositions, objectColors, objectsArray);
+    spawnObjectsInScene(objectPositions, scene);
 
     // Configurare animatii
-    setupAnimations(objectsArray, animationCouplesArray);
+    setupAnimations(scene);
+
+    m_loadedScene = scene;
 }
 
-QMap<QString, QVector3D> MyOpenGLWidget::generateObjectPositions(const QJsonArray &objects, const QJsonArray &relations)
+namespace {
+
+// Relatiile in care apare un obiect, intr-o forma comparabila intre doua scene
+QHash<QString, QStringList> relationSignatures(const SceneDescription &scene)
 {
-    QMap<QString, QVector3D> objectPositions;
-    float initialX = -5.0f;
-    float initialZ = -5.0f;
+    QHash<QString, QStringList> signatures;
+    for (const SceneRelationDescription &relation : scene.relations) {
+        const QString signature = relation.object1 + '|' + relation.relation.toLower() + '|' + relation.object2;
+        signatures[relation.object1].append(signature);
+        signatures[relation.object2].append(signature);
+    }
+    for (QStringList &list : signatures) {
+        list.sort();
+    }
+    return signatures;
+}
 
-    // Pozitionare initiala
-    for (const QJsonValue &value : objects) {
-        QJsonObject obj = value.toObject();
-        QString objectId = obj["id"].toString();
-        QString objectType = obj["object"].toString();
+QString effectiveColor(const SceneObjectDescription &obj)
+{
+    return obj.hasColor ? obj.color : QString("#888888");
+}
 
-        QVector3D position(initialX,  m_floorLevel + 2.0f, initialZ);
+} // namespace
 
-        // Verifica daca modelul exista
-        QString modelPath = getModelPath(objectType);
-        if (!modelPath.isEmpty()) {
-            // Calculeaza inaltimea reala a obiectului
-            QString size = obj["attributes"].toObject()["size"].toString();
+void MyOpenGLWidget::applySceneDiff(const SceneDescription &scene)
+{
+    QElapsedTimer timer;
+    timer.start();
 
-            // FIX: Use proper object height calculation
-            QVector3D minBounds, maxBounds;
-            QVector3D dimensions = calculateBoundingBox(objectType, size, minBounds, maxBounds);
-            float objectHeight = dimensions.y(); // Actual height, not radius
+    QHash<QString, const SceneObjectDescription *> previousById;
+    for (const SceneObjectDescription &obj : m_loadedScene.objects) {
+        previousById.insert(obj.id, &obj);
+    }
+    const QHash<QString, QStringList> previousRelations = relationSignatures(m_loadedScene);
+    const QHash<QString, QStringList> relations = relationSignatures(scene);
+
+    // Obiectele cu aceeasi forma, animatii si relatii raman pe loc (doar culoarea poate diferi);
+    // restul sunt asezate de solver in jurul lor
+    QSet<QString> pinned;
+    QSet<QString> wanted;
+    for (const SceneObjectDescription &obj : scene.objects) {
+        wanted.insert(obj.id);
+        const SceneObjectDescription *previous = previousById.value(obj.id);
+        if (previous && m_sceneStore.contains(obj.id) && previous->type == obj.type && previous->size == obj.size
+            && previous->animations == obj.animations && previousRelations.value(obj.id) == relations.value(obj.id)) {
+            pinned.insert(obj.id);
+        }
+    }
 
-            // ALWAYS apply floor constraint
-            position = getFloorConstrainedPosition(position, objectHeight);
+    // Obiectele care au disparut din descriere
+    int removed = 0;
+    const QStringList loadedIds(m_sceneStore.ids.cbegin(), m_sceneStore.ids.cend());
+    for (const QString &id : loadedIds) {
+        if (!wanted.contains(id)) {
+            removeObject(id);
+            ++removed;
+        }
+    }
 
-            // SAFETY CHECK: Ensure Y is never below floor
-            if (position.y() < m_floorLevel + 0.1f) {
-                position.setY(m_floorLevel + objectHeight/2.0f + 0.5f);
-                qDebug() << "SAFETY: Forced object" << objectId << "above floor to Y=" << position.y();
+    const QMap<QString, QVector3D> positions = generateObjectPositions(scene, pinned);
+
+    int added = 0;
+    int updated = 0;
+    int recolored = 0;
+    for (const SceneObjectDescription &obj : scene.objects) {
+        if (!positions.contains(obj.id)) {
+            // Model necunoscut (ex. tipul s-a schimbat intr-unul fara model)
+            if (m_sceneStore.contains(obj.id)) {
+                removeObject(obj.id);
+                ++removed;
             }
+            continue;
+        }
 
-            objectPositions[objectId] = position;
-            qDebug() << "Placed object" << objectId << "at position:" << position << "with height:" << objectHeight;
+        const SceneStore::Handle handle = m_sceneStore.handleOf(obj.id);
+        const QString color = effectiveColor(obj);
+
+        if (handle == SceneStore::INVALID_HANDLE) {
+            const QVector3D &position = positions[obj.id];
+            loadModelInScene(obj.type, color, obj.size, position.x(), position.y(), position.z(),
+                             obj.animations, obj.id);
+            ++added;
+        } else if (!pinned.contains(obj.id)) {
+            updateObjectInScene(handle, obj, color, positions[obj.id]);
+            ++updated;
+        } else if (m_sceneStore.colors[handle] != color) {
+            swapObjectMaterial(handle, obj.type, color);
+            ++recolored;
+            continue;
         } else {
-            qDebug() << "Model not found for object type:" << objectType << "- skipping";
+            continue; // neschimbat: entitate, mesh, material si transformare pastrate
         }
 
-        initialX += DEFAULT_SPACING;
-        if (initialX > 15.0f) {
-            initialX = -5.0f;
-            initialZ += DEFAULT_SPACING;
+        // Obiect nou sau reinregistrat: programul de animatie porneste de la zero
+        const SceneStore::Handle newHandle = m_sceneStore.handleOf(obj.id);
+        if (newHandle != SceneStore::INVALID_HANDLE) {
+            for (const QString &animationType : obj.animations) {
+                setupObjectAnimation(newHandle, animationType);
+            }
         }
     }
 
-    // Aplicare relatii
-    for (const QJsonValue &value : relations) {
-        QJsonObject relationObj = value.toObject();
-        QString obj1Id = relationObj["object_1"].toString();
-        QString obj2Id = relationObj["object_2"].toString();
-        QString relation = relationObj["relation"].toString();
-
-        if (!objectPositions.contains(obj1Id) || !objectPositions.contains(obj2Id)) {
-            continue; // Skip relatia daca obiectele nu exista
-        }
-
-        QVector3D offset(0, 0, 0);
+    // Animatiile orbitale sunt putine; sunt refacute toate, cu handle-urile noi
+    SimulationCommand clearOrbitals;
+    clearOrbitals.type = SimulationCommand::ClearOrbitals;
+    m_simulation->post(clearOrbitals);
+    for (const AnimationCoupleDescription &couple : scene.animationCouples) {
+        setupOrbitalAnimation(couple.primaryObject, couple.referenceObject, couple.animationType, couple.description);
+    }
 
-        if (relation == "left") offset.setX(-DEFAULT_SPACING);
-        else if (relation == "right") offset.setX(DEFAULT_SPACING);
-        else if (relation == "behind") offset.setZ(-DEFAULT_SPACING);
-        else if (relation == "front") offset.setZ(DEFAULT_SPACING);
-        else if (relation == "above" || relation == "on top of" || relation == "on") {
-            offset.setY(DEFAULT_SPACING);
-        }
-        else if (relation == "below" || relation == "under") offset.setY(-DEFAULT_SPACING * 0.5f);
-        else if (relation == "near") {
-            offset.setX(DEFAULT_SPACING * 0.5f);
-        }
+    if (m_instancedRendering) {
+        rebuildInstancing();
+    }
 
-        QVector3D newPosition = objectPositions[obj2Id] + offset;
+    qDebug() << "Scene diff applied in" << timer.elapsed() << "ms:" << added << "added," << removed << "removed,"
+             << updated << "updated," << recolored << "recolored,"
+             << (m_sceneStore.size() - added - updated - recolored) << "unchanged";
+}
 
-        // Aplica constrangerea podelei pentru noua pozitie
-        QVector3D minBounds, maxBounds;
-        QVector3D dimensions = calculateBoundingBox("cube", "medium", minBounds, maxBounds); // default
-        float objectHeight = dimensions.y();
-        newPosition = getFloorConstrainedPosition(newPosition, objectHeight);
+void MyOpenGLWidget::swapObjectMaterial(SceneStore::Handle handle, const QString &objectType, const QString &color)
+{
+    Qt3DCore::QEntity *entity = m_sceneStore.entities[handle];
+    Qt3DRender::QMaterial *material = m_sceneStore.materials[handle];
+    Qt3DRender::QMaterial *newMaterial = acquireMaterial(objectType, parseColor(color));
 
-        // DOUBLE CHECK: Never below floor
-        if (newPosition.y() < m_floorLevel + 0.1f) {
-            newPosition.setY(m_floorLevel + objectHeight/2.0f + 0.5f);
-            qDebug() << "RELATION SAFETY: Forced object" << obj1Id << "above floor to Y=" << newPosition.y();
+    if (entity && newMaterial != material) {
+        if (material) {
+            entity->removeComponent(material);
         }
-
-        objectPositions[obj1Id] = newPosition;
+        entity->addComponent(newMaterial);
     }
+    m_materialCache->release(material);
 
-    return objectPositions;
+    m_sceneStore.materials[handle] = newMaterial;
+    m_sceneStore.colors[handle] = color;
 }
 
-void MyOpenGLWidget::resolveCollisions(QMap<QString, QVector3D> &positions)
+void MyOpenGLWidget::updateObjectInScene(SceneStore::Handle handle, const SceneObjectDescription &obj,
+                                         const QString &color, const QVector3D &position)
 {
-    QVector<QVector3D> usedPositions;
-
-    for (auto it = positions.begin(); it != positions.end(); ++it) {
-        QVector3D pos = it.value();
-        bool hasCollision = true;
-        int attempts = 0;
-        const int maxAttempts = 10;
-
-        while (hasCollision && attempts < maxAttempts) {
-            hasCollision = false;
-
-            for (const QVector3D &existingPos : usedPositions) {
-                float distance = pos.distanceToPoint(existingPos);
-                if (distance < (DEFAULT_SPACING - COLLISION_TOLERANCE)) {
-                    // Coliziune detectata, muta obiectul
-                    pos.setX(pos.x() + DEFAULT_SPACING);
-                    hasCollision = true;
-                    break;
-                }
-            }
-            attempts++;
+    Qt3DCore::QEntity *entity = m_sceneStore.entities[handle];
+    Qt3DCore::QTransform *transform = m_sceneStore.transforms[handle];
+    // Intrarea noua din store porneste de la nivelul 0; selectia il alege din nou la cadrul urmator
+    switchObjectLod(handle, 0);
+    QString modelPath = m_sceneStore.modelPaths[handle];
+
+    // Mesh nou doar daca s-a schimbat modelul; altfel geometria ramane pe GPU
+    const QString newModelPath = getModelPath(obj.type);
+    if (newModelPath != modelPath) {
+        Qt3DRender::QGeometryRenderer *mesh = m_geometryCache->acquire(newModelPath);
+        const QVector<Qt3DRender::QGeometryRenderer *> oldMeshes =
+            entity->componentsOfType<Qt3DRender::QGeometryRenderer>();
+        for (Qt3DRender::QGeometryRenderer *oldMesh : oldMeshes) {
+            entity->removeComponent(oldMesh);
         }
+        entity->addComponent(mesh);
+        m_geometryCache->release(modelPath);
+        modelPath = newModelPath;
+    }
 
-        // Aplica constrangerea podelei
-        pos = getFloorConstrainedPosition(pos, 1.0f);
-
-        usedPositions.append(pos);
-        it.value() = pos;
+    if (m_sceneStore.colors[handle] != color || m_sceneStore.types[handle] != obj.type) {
+        swapObjectMaterial(handle, obj.type, color);
     }
+    Qt3DRender::QMaterial *material = m_sceneStore.materials[handle];
+
+    // Intrarea din store si din simulare este refacuta; nodurile Qt3D sunt refolosite
+    m_sceneStore.remove(handle);
+    SimulationCommand command;
+    command.type = SimulationCommand::RemoveObject;
+    command.id = obj.id;
+    m_simulation->post(command);
+
+    transform->setRotation(QQuaternion());
+    registerSceneObject(obj.id, obj.type, color, obj.size, modelPath, entity, transform, material,
+                        position, obj.animations);
 }
 
-bool MyOpenGLWidget::checkAABBCollision(const SceneObject &obj1, const SceneObject &obj2)
+QMap<QString, QVector3D> MyOpenGLWidget::generateObjectPositions(const SceneDescription &scene,
+                                                                 const QSet<QString> &pinned)
 {
-    return (obj1.boundingBoxMin.x() <= obj2.boundingBoxMax.x() &&
-            obj1.boundingBoxMax.x() >= obj2.boundingBoxMin.x() &&
-            obj1.boundingBoxMin.y() <= obj2.boundingBoxMax.y() &&
-            obj1.boundingBoxMax.y() >= obj2.boundingBoxMin.y() &&
-            obj1.boundingBoxMin.z() <= obj2.boundingBoxMax.z() &&
-            obj1.boundingBoxMax.z() >= obj2.boundingBoxMin.z());
+    SceneLayoutSolver solver(m_floorLevel, LAYOUT_GAP, DEFAULT_SPACING);
+    QHash<QString, QVector3D> boundsCenters; // solver-ul aseaza centre, scena foloseste origini
+    float initialX = -5.0f;
+    float initialZ = -5.0f;
+
+    // Pozitionare initiala pe grila, cu dimensiunile reale ale fiecarui obiect
+    for (const SceneObjectDescription &obj : scene.objects) {
+        const QString &objectType = obj.type;
+
+        if (!getModelPath(objectType).isEmpty()) {
+            QVector3D minBounds, maxBounds;
+            QVector3D dimensions = calculateBoundingBox(objectType, obj.size, minBounds, maxBounds);
+            const QVector3D boundsCenter = (minBounds + maxBounds) * 0.5f;
+            if (pinned.contains(obj.id)) {
+                // Obiect pastrat din scena curenta: ramane exact unde este
+                const SceneStore::Handle handle = m_sceneStore.handleOf(obj.id);
+                solver.addObject(obj.id, dimensions, m_sceneStore.originalPositions[handle] + boundsCenter, true);
+            } else {
+                solver.addObject(obj.id, dimensions, QVector3D(initialX, m_floorLevel, initialZ));
+            }
+            boundsCenters.insert(obj.id, boundsCenter);
+        } else {
+            qDebug() << "Model not found for object type:" << objectType << "- skipping";
+        }
+
+        initialX += DEFAULT_SPACING;
+        if (initialX > 15.0f) {
+            initialX = -5.0f;
+            initialZ += DEFAULT_SPACING;
+        }
     }
 
-bool MyOpenGLWidget::checkSphereCollision(const SceneObject &obj1, const SceneObject &obj2)
-{
-    float distance = obj1.position.distanceToPoint(obj2.position);
-    return distance < (obj1.boundingSphereRadius + obj2.boundingSphereRadius);
+    // Relatiile devin constrangeri
+    for (const SceneRelationDescription &relationDesc : scene.relations) {
+        if (!solver.addRelation(relationDesc.object1, relationDesc.relation, relationDesc.object2)) {
+            qDebug() << "Skipping relation" << relationDesc.object1 << relationDesc.relation
+                     << relationDesc.object2;
+        }
     }
 
-void MyOpenGLWidget::applyImpulse(SceneObject &staticObj, const SceneObject &dynamicObj)
-{
-    QVector3D direction = staticObj.position - dynamicObj.position;
-    direction.normalize();
+    const SceneLayoutSolver::Result layout = solver.solve();
+    qDebug() << "Layout:" << solver.objectCount() << "objects," << solver.constraintCount()
+             << "constraints," << layout.iterations << "iterations, residual" << layout.residual
+             << "," << layout.overlaps << "overlaps," << layout.elapsedMicroseconds << "us"
+             << (layout.converged ? "" : "(not converged)");
 
-    staticObj.velocity += direction * IMPULSE_STRENGTH;
-    staticObj.isDynamic = true; // Devine dinamic temporar
+    QMap<QString, QVector3D> objectPositions = layout.positions;
+    for (auto it = objectPositions.begin(); it != objectPositions.end(); ++it) {
+        it.value() -= boundsCenters.value(it.key());
+    }
+    return objectPositions;
 }
 
 void MyOpenGLWidget::spawnObjectsInScene(const QMap<QString, QVector3D> &positions,
-                                       const QMap<QString, QString> &colors,
-                                       const QJsonArray &objects)
+                                       const SceneDescription &scene)
 {
     // QMap<QString, QJsonObject> objectsById;
 
@@ -478,24 +610,23 @@ void MyOpenGLWidget::spawnObjectsInScene(const QMap<QString, QVector3D> &positio
     //     loadModelInScene(objectType, color, size, position.x(), position.y(), position.z(), animations, objectId);
     // }
 
-    QMap<QString, QJsonObject> objectsById;
+    QHash<QString, const SceneObjectDescription *> objectsById;
+    objectsById.reserve(scene.objects.size());
 
     // Indexare rapida a obiectelor dupa ID
-    for (const QJsonValue &value : objects) {
-        QJsonObject obj = value.toObject();
-        QString id = obj["id"].toString();
-        objectsById[id] = obj;
+    for (const SceneObjectDescription &obj : scene.objects) {
+        objectsById.insert(obj.id, &obj);
     }
 
     for (auto it = positions.begin(); it != positions.end(); ++it) {
         QString objectId = it.key();
         QVector3D position = it.value();
 
-        if (!objectsById.contains(objectId))
+        const SceneObjectDescription *obj = objectsById.value(objectId);
+        if (!obj)
             continue;
 
-        QJsonObject obj = objectsById[objectId];
-        QString objectType = obj["object"].toString();
+        const QString &objectType = obj->type;
 
         // Verifica daca modelul e cunoscut (exista in primitives)
         if (getModelPath(objectType).isEmpty()) {
@@ -503,95 +634,31 @@ void MyOpenGLWidget::spawnObjectsInScene(const QMap<QString, QVector3D> &positio
             continue;
         }
 
-        QString color;
-        if (obj["attributes"].toObject().contains("color") &&
-            obj["attributes"].toObject()["color"].isString()) {
-            color = obj["attributes"].toObject()["color"].toString();
-        } else {
-            color = "#888888"; // fallback
-        }
-
-        QString size = obj["attributes"].toObject()["size"].toString();
-
-        QJsonArray animationsArray = obj["attributes"].toObject()["animations"].toArray();
-        QStringList animations;
-        for (const QJsonValue &animValue : animationsArray) {
-            animations << animValue.toString();
-        }
+        QString color = obj->hasColor ? obj->color : QString("#888888"); // fallback
+        const QString &size = obj->size;
+        const QStringList &animations = obj->animations;
 
         loadModelInScene(objectType, color, size,
                          position.x(), position.y(), position.z(),
                          animations, objectId);
     }
+
+    if (m_instancedRendering) {
+        rebuildInstancing();
+    }
+
+    qDebug() << "Spawned" << m_sceneStore.size() << "objects using" << m_materialCache->uniqueMaterialCount()
+             << "unique materials and" << m_materialCache->uniqueEffectCount() << "effects";
 }
 
 QString MyOpenGLWidget::getModelPath(const QString &objectType)
 {
-    QString basePath = QCoreApplication::applicationDirPath() + "/../../../Models/primitives/";
-
-    // Support for multiple formats in priority order
-    QStringList extensions = {".fbx", ".obj", ".gltf", ".glb", ".3ds", ".dae", ".ply", ".stl"};
-
-    // MODIFICARE: Adauga cautare case-insensitive
-    for (const QString &ext : extensions) {
-        QString modelPath = basePath + objectType + ext;
-        if (QFile::exists(modelPath)) {
-            qDebug() << "Found model (exact match):" << modelPath;
-            return modelPath;
-        }
-
-        // NOUa: Cautare case-insensitive in directorul primitives
-        QDir primitivesDir(basePath);
-        QStringList allFiles = primitivesDir.entryList(QDir::Files);
-
-        QString targetFileName = objectType + ext;
-        for (const QString &fileName : allFiles) {
-            if (fileName.compare(targetFileName, Qt::CaseInsensitive) == 0) {
-                QString foundPath = basePath + fileName;
-                qDebug() << "Found model (case-insensitive):" << foundPath << "for requested:" << objectType;
-                return foundPath;
-            }
-        }
-    }
-
-    // Also check in subdirectories (common for complex models) - MODIFICAT pentru case-insensitive
-    QDir primitivesDir(basePath);
-    QStringList subdirs = primitivesDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-
-    for (const QString &subdir : subdirs) {
-        // MODIFICAT: Comparatie case-insensitive pentru subdirectoare
-        if (subdir.compare(objectType, Qt::CaseInsensitive) == 0 ||
-            subdir.toLower().contains(objectType.toLower())) {
-
-            QString subdirPath = basePath + subdir + "/";
-            QDir subdirObj(subdirPath);
-            QStringList subdirFiles = subdirObj.entryList(QDir::Files);
-
-            for (const QString &ext : extensions) {
-                QString targetFileName = objectType + ext;
-
-                // NOUa: Cautare case-insensitive in subdirectoare
-                for (const QString &fileName : subdirFiles) {
-                    if (fileName.compare(targetFileName, Qt::CaseInsensitive) == 0) {
-                        QString foundPath = subdirPath + fileName;
-                        qDebug() << "Found model in subdirectory (case-insensitive):" << foundPath;
-                        return foundPath;
-                    }
-
-                    // Also try with subdir name (case-insensitive)
-                    QString subdirFileName = subdir + ext;
-                    if (fileName.compare(subdirFileName, Qt::CaseInsensitive) == 0) {
-                        QString foundPath = subdirPath + fileName;
-                        qDebug() << "Found model with subdir name (case-insensitive):" << foundPath;
-                        return foundPath;
-                    }
-                }
-            }
-        }
+    // Lookup O(1) in indexul construit o singura data (vezi ModelCatalog)
+    QString modelPath = ModelCatalog::instance()->modelPath(objectType);
+    if (modelPath.isEmpty()) {
+        qDebug() << "No model found for object type:" << objectType;
     }
-
-    qDebug() << "No model found for object type:" << objectType;
-    return QString(); // Not found
+    return modelPath;
 }
     // // Support for multiple formats in priority order
     // QStringList extensions = {".fbx", ".obj", ".gltf", ".glb", ".3ds", ".dae", ".ply", ".stl"};
@@ -675,28 +742,15 @@ float MyOpenGLWidget::getSizeMultiplier(const QString &size)
     return 1.0f; // medium/default
 }
 
-QVector3D MyOpenGLWidget::getFloorConstrainedPosition(const QVector3D &position, float objectHeight)
+QVector3D MyOpenGLWidget::getFloorConstrainedPosition(const QVector3D &position, const QVector3D &minBounds)
 {
-    // qDebug() << "getFloorConstrainedPosition() CALLED!";
-    // qDebug() << "Input position:" << position;
-    // qDebug() << "Object height:" << objectHeight;
-    // qDebug() << "Floor level:" << m_floorLevel;
+    // minBounds este relativ la originea modelului, care nu e neaparat in centrul lui
     QVector3D constrainedPos = position;
-    float minY = m_floorLevel + (objectHeight / 2.0f) + 0.2f; // Putin deasupra podelei
-
-    // qDebug() << "Calculated minY:" << minY;
-    // qDebug() << "Current Y:" << constrainedPos.y();
+    float minY = m_floorLevel - minBounds.y() + 0.2f; // Putin deasupra podelei
 
     if (constrainedPos.y() < minY) {
-        // qDebug() << "APPLYING CONSTRAINT: Moving from Y=" << constrainedPos.y() << "to Y=" << minY;
-
         constrainedPos.setY(minY);
-        // qDebug() << "FLOOR CONSTRAINT: Moved object from Y=" << position.y() << "to Y=" << minY;
     }
-    // else
-    // {
-    //     // qDebug() << "NO CONSTRAINT NEEDED - object already above minY";
-    // }
 
     return constrainedPos;
 }
@@ -706,7 +760,16 @@ QVector3D MyOpenGLWidget::calculateBoundingBox(const QString &objectType, const
 {
     float sizeMultiplier = getSizeMultiplier(size);
 
-    // Dimensiuni aproximative pentru diferite tipuri de obiecte
+    // Volume reale, citite o singura data din varfurile modelului (vezi ModelBoundsIndex)
+    const ModelBounds &bounds = ModelBoundsIndex::instance()->bounds(getModelPath(objectType));
+    if (bounds.valid) {
+        const float scale = sizeMultiplier * MODEL_SCALE;
+        minBounds = bounds.minimum * scale;
+        maxBounds = bounds.maximum * scale;
+        return maxBounds - minBounds;
+    }
+
+    // Dimensiuni aproximative pentru modelele ale caror varfuri nu pot fi citite
     QVector3D dimensions(1.0f, 1.0f, 1.0f);
 
     if (objectType == "cube" || objectType == "box") {
@@ -731,6 +794,11 @@ QVector3D MyOpenGLWidget::calculateBoundingBox(const QString &objectType, const
 
 float MyOpenGLWidget::calculateBoundingSphere(const QString &objectType, const QString &size)
 {
+    const ModelBounds &bounds = ModelBoundsIndex::instance()->bounds(getModelPath(objectType));
+    if (bounds.valid) {
+        return bounds.sphereRadius * getSizeMultiplier(size) * MODEL_SCALE;
+    }
+
     QVector3D minBounds, maxBounds;
     QVector3D dimensions = calculateBoundingBox(objectType, size, minBounds, maxBounds);
 
@@ -739,31 +807,18 @@ float MyOpenGLWidget::calculateBoundingSphere(const QString &objectType, const Q
 
 bool MyOpenGLWidget::hasPBRTextures(const QString &objectType)
 {
-    QString basePath = QCoreApplication::applicationDirPath() + "/../../../Models/textures/";
-
-    // Common PBR texture naming conventions with multiple format support
-    QStringList pbrPrefixes = {
-        "_diff", "_albedo", "_diffuse", "_basecolor",    // Albedo/Diffuse
-        "_nor", "_nor_gl", "_normal", "_norm",           // Normal maps
-        "_metallic", "_metal",                           // Metallic
-        "_roughness", "_rough"                           // Roughness
-    };
-
-    // Supported texture formats
-    QStringList supportedFormats = {"png", "jpg", "jpeg", "tga", "bmp", "exr", "hdr"};
+    // Aceleasi harti, extensii si director ca PBRMaterial; listarea directorului este memorata
+    return PBRMaterial::hasTextures(objectType);
+}
 
-    // Check if any PBR texture exists in any supported format
-    for (const QString &prefix : pbrPrefixes) {
-        for (const QString &format : supportedFormats) {
-            QString texturePath = basePath + objectType + prefix + "." + format;
-            if (QFile::exists(texturePath)) {
-                qDebug() << "Found PBR texture for" << objectType << ":" << texturePath;
-                return true;
-            }
-        }
+Qt3DRender::QMaterial *MyOpenGLWidget::acquireMaterial(const QString &objectType, const QColor &color)
+{
+    // Modelele fara texturi raman pe Phong: PBR fara harti ar adauga doar costul shader-ului
+    if (hasPBRTextures(objectType)) {
+        qDebug() << "Using PBR material with textures for:" << objectType;
+        return m_materialCache->acquire(objectType, color, MaterialCache::Kind::PBR);
     }
-
-    return false;
+    return m_materialCache->acquire(objectType, color, MaterialCache::Kind::Phong);
 }
 
 void MyOpenGLWidget::loadModelInScene(const QString &objectType, const QString &color,
@@ -778,9 +833,8 @@ void MyOpenGLWidget::loadModelInScene(const QString &objectType, const QString &
         return;
     }
 
-    // Create mesh
-    Qt3DRender::QMesh *mesh = new Qt3DRender::QMesh();
-    mesh->setSource(QUrl::fromLocalFile(modelPath));
+    // Geometrie partajata: acelasi tip de obiect inseamna o singura incarcare pe GPU
+    Qt3DRender::QGeometryRenderer *mesh = m_geometryCache->acquire(modelPath);
 
     // Create entity
     Qt3DCore::QEntity *entity = new Qt3DCore::QEntity(rootEntity);
@@ -789,64 +843,42 @@ void MyOpenGLWidget::loadModelInScene(const QString &objectType, const QString &
     // Parse color
     QColor objColor = parseColor(color);
 
-    // Try PBR material first
-    Qt3DRender::QMaterial *material = nullptr;
-
-    // try {
-    //     if (hasPBRTextures(objectType)) {
-    //         qDebug() << "Using PBR material with textures for:" << objectType;
-    //         material = new PBRMaterial(entity, objectType, objColor);
-    //     } else {
-    //         qDebug() << "Using PBR material with color only for:" << objectType;
-    //         material = new PBRMaterial(entity, QString(), objColor);
-    //     }
-    // } catch (const std::exception &e) {
-    //     qDebug() << "PBR material failed:" << e.what();
-    //     material = nullptr;
-    // }
-
-    // Fallback to Qt3DExtras materials if PBR fails
-    if (!material) {
-        qDebug() << "Using Phong fallback material for:" << objectType;
-        Qt3DExtras::QPhongMaterial *phongMaterial = new Qt3DExtras::QPhongMaterial();
-        phongMaterial->setDiffuse(objColor);
-        phongMaterial->setSpecular(objColor.lighter(110));
-        phongMaterial->setShininess(50.0f);
-        phongMaterial->setAmbient(objColor.darker(150));
-        material = phongMaterial;
-    }
-
+    // Obiectele cu acelasi tip si aceeasi culoare partajeaza acelasi nod de material (vezi MaterialCache)
+    Qt3DRender::QMaterial *material = acquireMaterial(objectType, objColor);
     entity->addComponent(material);
 
     // Transform with proper positioning
     Qt3DCore::QTransform *transform = new Qt3DCore::QTransform();
+    entity->addComponent(transform);
+
+    registerSceneObject(id, objectType, color, size, modelPath, entity, transform, material,
+                        QVector3D(x, y, z), animations);
+}
+
+void MyOpenGLWidget::registerSceneObject(const QString &id, const QString &objectType, const QString &color,
+                                         const QString &size, const QString &modelPath,
+                                         Qt3DCore::QEntity *entity, Qt3DCore::QTransform *transform,
+                                         Qt3DRender::QMaterial *material, const QVector3D &layoutPosition,
+                                         const QStringList &animations)
+{
     float sizeMultiplier = getSizeMultiplier(size);
 
     // Good visible scale
-    float finalScale = sizeMultiplier * 2.0f;
+    float finalScale = sizeMultiplier * MODEL_SCALE;
     transform->setScale3D(QVector3D(finalScale, finalScale, finalScale));
 
     // Aplicare constrangeri podea
     QVector3D minBounds, maxBounds;
     QVector3D dimensions = calculateBoundingBox(objectType, size, minBounds, maxBounds);
-    float actualHeight = dimensions.y() * sizeMultiplier * 2.0f; // Account for scale
+    float actualHeight = dimensions.y(); // deja la scala transformarii
 
     // Start with input position
-    QVector3D position(x, y, z);
-
-    // ALWAYS apply floor constraint with actual height
-    position = getFloorConstrainedPosition(position, actualHeight);
+    QVector3D position = layoutPosition;
 
-    // TRIPLE CHECK: Never ever below floor
-    float absoluteMinY = m_floorLevel + 0.5f; // Minimum buffer above floor
-    if (position.y() < absoluteMinY) {
-        position.setY(absoluteMinY + actualHeight/2.0f);
-        qDebug() << "ABSOLUTE SAFETY: Forced object" << id << "to Y=" << position.y();
-    }
+    // ALWAYS apply floor constraint with the model's real lowest point
+    position = getFloorConstrainedPosition(position, minBounds);
 
     transform->setTranslation(position);
-
-    entity->addComponent(transform);
     qDebug() << "FINAL POSITION for" << id << ":" << position << "Floor level:" << m_floorLevel << "Object height:" << actualHeight;
 
     // Creare obiect scena
@@ -855,6 +887,8 @@ void MyOpenGLWidget::loadModelInScene(const QString &objectType, const QString &
     sceneObj.type = objectType;
     sceneObj.color = color;
     sceneObj.size = size;
+    sceneObj.modelPath = modelPath;
+    sceneObj.material = material;
     sceneObj.position = position;
     sceneObj.originalPosition = position; // Store original position for animations
     sceneObj.entity = entity;
@@ -872,79 +906,91 @@ void MyOpenGLWidget::loadModelInScene(const QString &objectType, const QString &
     // Calculate bounding box
     // QVector3D minBounds, maxBounds;
     // calculateBoundingBox(objectType, size, minBounds, maxBounds);
-    sceneObj.boundingBoxMin = position + (minBounds * finalScale);
-    sceneObj.boundingBoxMax = position + (maxBounds * finalScale);
+    sceneObj.boundingBoxMin = position + minBounds;
+    sceneObj.boundingBoxMax = position + maxBounds;
 
-    m_sceneObjects[id] = sceneObj;
+    const SceneStore::Handle handle = m_sceneStore.add(sceneObj);
+
+    // Parametrii folositi la fiecare pas de animatie/fizica, calculati o singura data
+    m_sceneStore.baseScales[handle] = finalScale; // aceeasi scala ca volumele din calculateBoundingBox
+    m_sceneStore.scales[handle] = finalScale;
+    m_sceneStore.localBoundsMin[handle] = minBounds;
+    m_sceneStore.localBoundsMax[handle] = maxBounds;
+    postAddObject(handle);
 
     qDebug() << "Loaded object:" << id << "of type:" << objectType << "at position:" << position;
 }
 
 // Implementarea functiilor de animatie
-void MyOpenGLWidget::setupAnimations(const QJsonArray &objects, const QJsonArray &animationCouples)
+void MyOpenGLWidget::setupAnimations(const SceneDescription &scene)
 {
     // Setup animatii individuale pentru obiecte
-    for (const QJsonValue &value : objects) {
-        QJsonObject obj = value.toObject();
-        QString objectId = obj["id"].toString();
-        QJsonArray animationsArray = obj["attributes"].toObject()["animations"].toArray();
-
-        if (!m_sceneObjects.contains(objectId)) {
+    for (const SceneObjectDescription &obj : scene.objects) {
+        const SceneStore::Handle handle = m_sceneStore.handleOf(obj.id);
+        if (handle == SceneStore::INVALID_HANDLE) {
             continue;
         }
 
-        SceneObject &sceneObj = m_sceneObjects[objectId];
-
-        for (const QJsonValue &animValue : animationsArray) {
-            QString animationType = animValue.toString();
-            setupObjectAnimation(sceneObj, animationType);
+        for (const QString &animationType : obj.animations) {
+            setupObjectAnimation(handle, animationType);
         }
     }
 
     // Setup animatii cuplu (orbitale)
-    for (const QJsonValue &value : animationCouples) {
-        QJsonObject couple = value.toObject();
-        QString primaryId = couple["primary_object"].toString();
-        QString referenceId = couple["reference_object"].toString();
-        QString animationType = couple["animation_type"].toString();
-        QString description = couple["description"].toString();
+    for (const AnimationCoupleDescription &couple : scene.animationCouples) {
+        const QString &primaryId = couple.primaryObject;
+        const QString &referenceId = couple.referenceObject;
+        const QString &animationType = couple.animationType;
+        const QString &description = couple.description;
 
         setupOrbitalAnimation(primaryId, referenceId, animationType, description);
     }
 }
 
-void MyOpenGLWidget::setupObjectAnimation(SceneObject &obj, const QString &animationType)
+void MyOpenGLWidget::postAddObject(SceneStore::Handle handle)
+{
+    m_culler.invalidate();
+    m_cullingResync = true;
+    m_cullingDirty = true;
+
+    // Simularea primeste propria copie; nu atinge entitatea sau transformarea
+    SimulationCommand command;
+    command.type = SimulationCommand::AddObject;
+    command.object = m_sceneStore.object(handle);
+    command.baseScale = m_sceneStore.baseScales[handle];
+    command.scale = m_sceneStore.scales[handle];
+    command.localBoundsMin = m_sceneStore.localBoundsMin[handle];
+    command.localBoundsMax = m_sceneStore.localBoundsMax[handle];
+    m_simulation->post(command);
+}
+
+void MyOpenGLWidget::setupObjectAnimation(SceneStore::Handle handle, const QString &animationType)
 {
-    if (!obj.entity || !obj.transform) {
+    if (!m_sceneStore.entities[handle] || !m_sceneStore.transforms[handle]) {
         return;
     }
 
-    if (animationType == "rotate" || animationType == "rotation") {
-        // Animatia va fi gestionata in updateAnimations()
-        qDebug() << "Setup rotation animation for object:" << obj.id;
-    }
-    else if (animationType == "bounce" || animationType == "bouncing") {
-        // Animatia va fi gestionata in updateAnimations()
-        qDebug() << "Setup bounce animation for object:" << obj.id;
-    }
-    else if (animationType == "float" || animationType == "floating") {
-        // Animatia va fi gestionata in updateAnimations()
-        qDebug() << "Setup float animation for object:" << obj.id;
-    }
-    else if (animationType == "pulse" || animationType == "pulsing") {
-        // Animatia va fi gestionata in updateAnimations()
-        qDebug() << "Setup pulse animation for object:" << obj.id;
-    }
-    else if (animationType == "swing" || animationType == "swinging") {
-        // Animatia va fi gestionata in updateAnimations()
-        qDebug() << "Setup swing animation for object:" << obj.id;
+    // Animatia este compilata in programul obiectului si evaluata in updateAnimations()
+    const quint8 flag = SceneStore::animationFlagFor(animationType);
+    if (!flag) {
+        qDebug() << "Unknown animation type" << animationType << "for object:" << m_sceneStore.ids[handle];
+        return;
     }
+
+    m_sceneStore.animationFlags[handle] |= flag;
+
+    SimulationCommand command;
+    command.type = SimulationCommand::SetAnimationFlags;
+    command.id = m_sceneStore.ids[handle];
+    command.animationFlags = m_sceneStore.animationFlags[handle];
+    m_simulation->post(command);
+    qDebug() << "Setup" << animationType << "animation for object:" << m_sceneStore.ids[handle];
 }
 
 void MyOpenGLWidget::setupOrbitalAnimation(const QString &primaryId, const QString &referenceId,
                                          const QString &animationType, const QString &description)
 {
-    if (!m_sceneObjects.contains(primaryId) || !m_sceneObjects.contains(referenceId)) {
+    if (!m_sceneStore.contains(primaryId) || !m_sceneStore.contains(referenceId)) {
         qDebug() << "Cannot setup orbital animation - objects not found:" << primaryId << referenceId;
         return;
     }
@@ -952,6 +998,8 @@ void MyOpenGLWidget::setupOrbitalAnimation(const QString &primaryId, const QStri
     OrbitalAnimation orbital;
     orbital.primaryObjectId = primaryId;
     orbital.referenceObjectId = referenceId;
+    orbital.primaryHandle = m_sceneStore.handleOf(primaryId);
+    orbital.referenceHandle = m_sceneStore.handleOf(referenceId);
     orbital.animationType = animationType;
     orbital.description = description;
 
@@ -969,347 +1017,79 @@ void MyOpenGLWidget::setupOrbitalAnimation(const QString &primaryId, const QStri
         orbital.speed = 0.3f;
     }
 
-    m_orbitalAnimations.append(orbital);
+    SimulationCommand command;
+    command.type = SimulationCommand::AddOrbital;
+    command.orbital = orbital;
+    m_simulation->post(command);
     qDebug() << "Setup orbital animation:" << primaryId << animationType << "around" << referenceId;
 }
 
-// void MyOpenGLWidget::updateAnimations()
-// {
-//     static float animationTime = 0.0f;
-//     animationTime += 0.016f; // ~60 FPS
-
-//     // Update animatii individuale
-//     for (auto it = m_sceneObjects.begin(); it != m_sceneObjects.end(); ++it) {
-//         SceneObject &obj = it.value();
-
-//         if (!obj.entity || !obj.transform) {
-//             continue;
-//         }
-
-//         for (const QString &animationType : obj.animations) {
-//             if (animationType == "rotate" || animationType == "rotation") {
-//                 // Rotatie continua pe axa Y
-//                 QQuaternion currentRotation = obj.transform->rotation();
-//                 QQuaternion yRotation = QQuaternion::fromAxisAndAngle(QVector3D(0, 1, 0),
-//                                                                      animationTime * 30.0f);
-//                 obj.transform->setRotation(yRotation);
-//             }
-//             else if (animationType == "bounce" || animationType == "bouncing") {
-//                 // Sarire verticala
-//                 float bounceOffset = abs(sin(animationTime * 2.0f)) * 2.0f;
-//                 QVector3D newPos = obj.position;
-//                 newPos.setY(obj.position.y() + bounceOffset);
-//                 obj.transform->setTranslation(newPos);
-//             }
-//             else if (animationType == "float" || animationType == "floating") {
-//                 // Plutire lenta
-//                 float floatOffset = sin(animationTime * 0.5f) * 1.0f;
-//                 QVector3D newPos = obj.position;
-//                 newPos.setY(obj.position.y() + floatOffset);
-//                 obj.transform->setTranslation(newPos);
-//             }
-//             else if (animationType == "pulse" || animationType == "pulsing") {
-//                 // Scalare pulsanta
-//                 float pulseScale = 1.0f + sin(animationTime * 3.0f) * 0.2f;
-//                 float baseSizeMultiplier = getSizeMultiplier(obj.size);
-//                 obj.transform->setScale(baseSizeMultiplier * pulseScale);
-//             }
-//             else if (animationType == "swing" || animationType == "swinging") {
-//                 // Pendulare pe axa Z
-//                 float swingAngle = sin(animationTime * 1.5f) * 15.0f;
-//                 QQuaternion swingRotation = QQuaternion::fromAxisAndAngle(QVector3D(0, 0, 1), swingAngle);
-//                 obj.transform->setRotation(swingRotation);
-//             }
-//         }
-//     }
-
-//     // Update animatii orbitale
-//     for (OrbitalAnimation &orbital : m_orbitalAnimations) {
-//         if (!m_sceneObjects.contains(orbital.primaryObjectId) ||
-//             !m_sceneObjects.contains(orbital.referenceObjectId)) {
-//             continue;
-//         }
-
-//         SceneObject &primaryObj = m_sceneObjects[orbital.primaryObjectId];
-//         const SceneObject &referenceObj = m_sceneObjects[orbital.referenceObjectId];
-
-//         if (!primaryObj.transform) {
-//             continue;
-//         }
-
-//         // Calculare pozitie orbitala
-//         orbital.currentAngle += orbital.speed * 0.016f;
-//         if (orbital.currentAngle > 2.0f * M_PI) {
-//             orbital.currentAngle -= 2.0f * M_PI;
-//         }
-
-//         float x = referenceObj.position.x() + cos(orbital.currentAngle) * orbital.radius;
-//         float z = referenceObj.position.z() + sin(orbital.currentAngle) * orbital.radius;
-//         float y = referenceObj.position.y(); // Mentine aceeasi inaltime
-
-//         QVector3D newPosition(x, y, z);
-//         newPosition = getFloorConstrainedPosition(newPosition, primaryObj.boundingSphereRadius);
-
-//         primaryObj.transform->setTranslation(newPosition);
-//         primaryObj.position = newPosition;
-
-//         // Update bounding box
-//         QVector3D minBounds, maxBounds;
-//         calculateBoundingBox(primaryObj.type, primaryObj.size, minBounds, maxBounds);
-//         primaryObj.boundingBoxMin = newPosition + minBounds;
-//         primaryObj.boundingBoxMax = newPosition + maxBounds;
-//     }
-// }
-
-void MyOpenGLWidget::updateAnimations()
+void MyOpenGLWidget::applySimulationSnapshot()
 {
-    const float deltaTime = 0.016f; // ~60 FPS
-    m_animationTime += deltaTime;
-
-    // Update individual object animations
-    for (auto it = m_sceneObjects.begin(); it != m_sceneObjects.end(); ++it) {
-        SceneObject &obj = it.value();
-
-        if (!obj.entity || !obj.transform) {
-            continue;
-        }
-
-        // Start with the original position and identity transforms
-        QVector3D currentPosition = obj.originalPosition;
-        QQuaternion currentRotation = QQuaternion();
-        float currentScale = getSizeMultiplier(obj.size);
-
-        // Apply all individual animations additively
-        for (const QString &animationType : obj.animations) {
-            if (animationType == "rotate" || animationType == "rotation" || animationType == "spin") {
-                // Continuous rotation on Y axis
-                obj.animationState.rotationAngle += 30.0f * deltaTime; // 30 degrees per second
-                if (obj.animationState.rotationAngle > 360.0f) {
-                    obj.animationState.rotationAngle -= 360.0f;
-                }
-                QQuaternion yRotation = QQuaternion::fromAxisAndAngle(QVector3D(0, 1, 0), obj.animationState.rotationAngle);
-                currentRotation = currentRotation * yRotation;
-            }
-            else if (animationType == "bounce" || animationType == "bouncing" || animationType == "jump") {
-                // Vertical bouncing
-                obj.animationState.bouncePhase += 2.0f * deltaTime;
-                float bounceOffset = qAbs(qSin(obj.animationState.bouncePhase)) * 2.0f;
-                currentPosition.setY(currentPosition.y() + bounceOffset);
-            }
-            else if (animationType == "float" || animationType == "floating") {
-                // Gentle floating motion
-                obj.animationState.floatPhase += 0.5f * deltaTime;
-                float floatOffset = qSin(obj.animationState.floatPhase) * 1.0f;
-                currentPosition.setY(currentPosition.y() + floatOffset);
-            }
-            else if (animationType == "pulse" || animationType == "pulsing") {
-                // Scale pulsing
-                obj.animationState.pulsePhase += 3.0f * deltaTime;
-                float pulseScale = 1.0f + qSin(obj.animationState.pulsePhase) * 0.2f;
-                currentScale *= pulseScale;
-            }
-            else if (animationType == "swing" || animationType == "swinging" || animationType == "oscillate") {
-                // Pendulum motion on Z axis
-                obj.animationState.swingPhase += 1.5f * deltaTime;
-                float swingAngle = qSin(obj.animationState.swingPhase) * 15.0f;
-                QQuaternion swingRotation = QQuaternion::fromAxisAndAngle(QVector3D(0, 0, 1), swingAngle);
-                currentRotation = currentRotation * swingRotation;
-            }
-            else if (animationType == "glow") {
-                // For glow effect, you might want to modify material properties
-                // This is a placeholder - actual glow would require shader modifications
-                obj.animationState.pulsePhase += 2.0f * deltaTime;
-                // Could modify material emission or intensity here
-            }
-
-            // AT THE END, ALWAYS check floor constraint:
-            QVector3D finalPosition = obj.transform->translation();
-
-            // NEVER allow objects below floor during animation
-            QVector3D minBounds, maxBounds;
-            QVector3D dimensions = calculateBoundingBox(obj.type, obj.size, minBounds, maxBounds);
-            float objectHeight = dimensions.y() * obj.transform->scale3D().y();
-
-            float minAllowedY = m_floorLevel + objectHeight/2.0f + 0.1f;
-            if (finalPosition.y() < minAllowedY) {
-                finalPosition.setY(minAllowedY);
-                obj.transform->setTranslation(finalPosition);
-                // qDebug() << "ANIMATION FLOOR CHECK: Corrected" << obj.id << "to Y=" << finalPosition.y();
-            }
-
-            obj.position = finalPosition;
-        }
-
-        // Apply floor constraint to the final position
-        currentPosition = getFloorConstrainedPosition(currentPosition, obj.boundingSphereRadius);
-
-        // Update transform with all combined animations
-        obj.transform->setTranslation(currentPosition);
-        obj.transform->setRotation(currentRotation);
-        obj.transform->setScale(currentScale);
-
-        // Update logical position for physics/collision detection
-        obj.position = currentPosition;
-
-        // Update bounding box
-        QVector3D minBounds, maxBounds;
-        calculateBoundingBox(obj.type, obj.size, minBounds, maxBounds);
-        obj.boundingBoxMin = currentPosition + minBounds;
-        obj.boundingBoxMax = currentPosition + maxBounds;
+    // Snapshot-urile produse inainte ca simularea sa aplice ultimele editari nu mai
+    // corespund handle-urilor din m_sceneStore; urmatorul snapshot va fi la zi
+    const SimulationSnapshot *snapshot = m_simulation->takeSnapshot();
+    if (!snapshot) {
+        return;
+    }
+    if (snapshot->commandSequence != m_simulation->postedCommandCount()
+        || snapshot->positions.size() != m_sceneStore.size()) {
+        // Mutarile din el nu vor mai aparea in lista urmatorului snapshot
+        m_snapshotResync = true;
+        return;
     }
 
-    // Update orbital animations (these override position but preserve other animations)
-    for (OrbitalAnimation &orbital : m_orbitalAnimations) {
-        if (!m_sceneObjects.contains(orbital.primaryObjectId) ||
-            !m_sceneObjects.contains(orbital.referenceObjectId))
-            continue;
-
-        SceneObject &primaryObj = m_sceneObjects[orbital.primaryObjectId];
-        const SceneObject &referenceObj = m_sceneObjects[orbital.referenceObjectId];
-
-        if (!primaryObj.transform) continue;
-
-        orbital.currentAngle += orbital.speed * deltaTime;
-        if (orbital.currentAngle > 2.0f * M_PI) {
-            orbital.currentAngle -= 2.0f * M_PI;
+    // De obicei doar obiectele mutate; toate dupa un snapshot sarit sau o schimbare a scenei
+    auto apply = [this, snapshot](SceneStore::Handle h) {
+        Qt3DCore::QTransform *transform = m_sceneStore.transforms[h];
+        if (!m_sceneStore.entities[h] || !transform) {
+            return;
         }
-
-        float x = referenceObj.position.x() + qCos(orbital.currentAngle) * orbital.radius;
-        float z = referenceObj.position.z() + qSin(orbital.currentAngle) * orbital.radius;
-        float y = referenceObj.position.y(); // Maintain same height as reference
-
-        QVector3D newOrbitalPosition(x, y, z);
-
-        // Apply collision avoidance for orbital objects
-        bool hasCollision = false;
-        for (auto it = m_sceneObjects.begin(); it != m_sceneObjects.end(); ++it) {
-            if (it.key() == orbital.primaryObjectId || it.key() == orbital.referenceObjectId)
-                continue;
-
-            SceneObject &other = it.value();
-            SceneObject temp = primaryObj;
-            temp.position = newOrbitalPosition;
-
-            if (checkSphereCollision(temp, other)) {
-                hasCollision = true;
-                newOrbitalPosition.setY(newOrbitalPosition.y() + primaryObj.boundingSphereRadius * 2.0f);
-                break;
-            }
+        transform->setTranslation(snapshot->positions[h]);
+        transform->setRotation(snapshot->rotations[h]);
+        transform->setScale(snapshot->scales[h]);
+        m_sceneStore.positions[h] = snapshot->positions[h];
+    };
+    if (m_snapshotResync || snapshot->allMoved) {
+        for (SceneStore::Handle h = 0; h < m_sceneStore.size(); ++h) {
+            apply(h);
         }
+        m_snapshotResync = false;
+        m_cullingResync = true;
+    } else {
+        for (SceneStore::Handle h : snapshot->moved) {
+            apply(h);
+        }
+        m_movedHandles += snapshot->moved;
+    }
+    if (m_cullingResync || !snapshot->moved.isEmpty()) {
+        m_cullingDirty = true;
+    }
 
-        // Update the original position for orbital objects so other animations work from orbital position
-        primaryObj.originalPosition = newOrbitalPosition;
-
-        // Get current transform state (rotation and scale might have been modified by individual animations)
-        QQuaternion currentRotation = primaryObj.transform->rotation();
-        float currentScale = primaryObj.transform->scale3D().x(); // Assuming uniform scaling
-
-        // Apply orbital position while preserving other animation effects
-        primaryObj.transform->setTranslation(newOrbitalPosition);
-        primaryObj.position = newOrbitalPosition;
+    m_collisionStats = snapshot->collisionStats;
+    m_averageAnimationFrameTime = snapshot->averageStepTime;
 
-        // Update bounding box for orbital position
-        QVector3D minBounds, maxBounds;
-        calculateBoundingBox(primaryObj.type, primaryObj.size, minBounds, maxBounds);
-        primaryObj.boundingBoxMin = newOrbitalPosition + minBounds;
-        primaryObj.boundingBoxMax = newOrbitalPosition + maxBounds;
+    // Doar instantele care s-au miscat sunt rescrise in buffer
+    if (m_instancedRendering) {
+        m_instancedRenderer->sync();
     }
 }
 
-void MyOpenGLWidget::updatePhysics()
+void MyOpenGLWidget::setCollisionCellSize(float size)
 {
-    const float deltaTime = 0.016f; // ~60 FPS
-    const float damping = 0.98f;
-    const float minVelocity = 0.01f;
-
-    // Update fizica pentru obiectele dinamice
-    for (auto it = m_sceneObjects.begin(); it != m_sceneObjects.end(); ++it) {
-        SceneObject &obj = it.value();
-
-        if (!obj.isDynamic || !obj.transform) {
-            continue;
-        }
-
-        // Aplicare gravitatie
-        obj.velocity.setY(obj.velocity.y() + GRAVITY * deltaTime);
-
-        // Update pozitie
-        QVector3D newPosition = obj.position + obj.velocity * deltaTime;
-
-        // Verificare coliziune cu podea
-        float minY = m_floorLevel + obj.boundingSphereRadius + 0.1f;
-        if (newPosition.y() <= minY) {
-            newPosition.setY(minY);
-            obj.velocity.setY(-obj.velocity.y() * 0.6f); // Bounce cu pierdere de energie
-
-            // Oprire daca viteza este prea mica
-            if (abs(obj.velocity.y()) < minVelocity) {
-                obj.velocity.setY(0);
-                obj.isDynamic = false; // Devine static din nou
-            }
-        }
-
-        // Aplicare damping
-        obj.velocity *= damping;
+    m_collisionCellSize = qMax(0.01f, size);
 
-        // Oprire daca viteza este prea mica
-        if (obj.velocity.length() < minVelocity) {
-            obj.velocity = QVector3D(0, 0, 0);
-            obj.isDynamic = false;
-        }
-
-        // Update pozitie si transform
-        obj.position = newPosition;
-        obj.transform->setTranslation(newPosition);
-
-        // Update bounding box
-        QVector3D minBounds, maxBounds;
-        calculateBoundingBox(obj.type, obj.size, minBounds, maxBounds);
-        obj.boundingBoxMin = newPosition + minBounds;
-        obj.boundingBoxMax = newPosition + maxBounds;
-    }
+    SimulationCommand command;
+    command.type = SimulationCommand::SetCollisionCellSize;
+    command.value = m_collisionCellSize;
+    m_simulation->post(command);
 
-    // Verificare coliziuni intre obiecte
-    checkObjectCollisions();
+    saveSettings();
 }
 
-void MyOpenGLWidget::checkObjectCollisions()
+float MyOpenGLWidget::collisionCellSize() const
 {
-    QVector<QString> objectIds = m_sceneObjects.keys().toVector();
-
-    for (int i = 0; i < objectIds.size(); ++i) {
-        for (int j = i + 1; j < objectIds.size(); ++j) {
-            SceneObject &obj1 = m_sceneObjects[objectIds[i]];
-            SceneObject &obj2 = m_sceneObjects[objectIds[j]];
-
-            // Verificare coliziune sphere
-            if (checkSphereCollision(obj1, obj2)) {
-                // Aplicare impuls doar daca unul dintre obiecte este dinamic
-                if (obj1.isDynamic && !obj2.isDynamic) {
-                    applyImpulse(obj2, obj1);
-                }
-                else if (obj2.isDynamic && !obj1.isDynamic) {
-                    applyImpulse(obj1, obj2);
-                }
-                else if (obj1.isDynamic && obj2.isDynamic) {
-                    // Ambele dinamice - schimb de impuls
-                    QVector3D direction = obj2.position - obj1.position;
-                    direction.normalize();
-
-                    QVector3D relativeVelocity = obj1.velocity - obj2.velocity;
-                    float velocityAlongNormal = QVector3D::dotProduct(relativeVelocity, direction);
-
-                    if (velocityAlongNormal > 0) continue; // Obiectele se indeparteaza
-
-                    float impulse = 2 * velocityAlongNormal / 2; // Masa egala pentru simplitate
-                    QVector3D impulseVector = direction * impulse;
-
-                    obj1.velocity -= impulseVector;
-                    obj2.velocity += impulseVector;
-                }
-            }
-        }
-    }
+    return m_collisionCellSize;
 }
 
 // Implementare Settings
@@ -1318,14 +1098,30 @@ void MyOpenGLWidget::loadSettings()
     m_language = m_settings->value("language", "en").toString();
     m_floorLevel = m_settings->value("floorLevel", -2.0f).toFloat();
     m_floorSize = m_settings->value("floorSize", 20.0f).toFloat();
+    m_instancedRendering = m_settings->value("instancedRendering", false).toBool();
+    m_incrementalLoading = m_settings->value("incrementalLoading", false).toBool();
+    m_frustumCulling = m_settings->value("frustumCulling", true).toBool();
+    m_cullingDistance = m_settings->value("cullingDistance", 0.0f).toFloat();
+    m_levelOfDetail = m_settings->value("levelOfDetail", true).toBool();
+    m_collisionCellSize = m_settings->value("collisionCellSize", DEFAULT_COLLISION_CELL_SIZE).toFloat();
+
+    SimulationCommand floorCommand;
+    floorCommand.type = SimulationCommand::SetFloorLevel;
+    floorCommand.value = m_floorLevel;
+    m_simulation->post(floorCommand);
+
+    SimulationCommand cellCommand;
+    cellCommand.type = SimulationCommand::SetCollisionCellSize;
+    cellCommand.value = m_collisionCellSize;
+    m_simulation->post(cellCommand);
 
     // Configurari camera
-    if (view && view->camera()) {
+    if (camera) {
         QVector3D cameraPos = m_settings->value("cameraPosition", QVector3D(0, 15, 30)).value<QVector3D>();
         QVector3D cameraTarget = m_settings->value("cameraTarget", QVector3D(0, 0, 0)).value<QVector3D>();
 
-        view->camera()->setPosition(cameraPos);
-        view->camera()->setViewCenter(cameraTarget);
+        camera->setPosition(cameraPos);
+        camera->setViewCenter(cameraTarget);
     }
 }
 
@@ -1334,11 +1130,17 @@ void MyOpenGLWidget::saveSettings()
     m_settings->setValue("language", m_language);
     m_settings->setValue("floorLevel", m_floorLevel);
     m_settings->setValue("floorSize", m_floorSize);
+    m_settings->setValue("instancedRendering", m_instancedRendering);
+    m_settings->setValue("incrementalLoading", m_incrementalLoading);
+    m_settings->setValue("frustumCulling", m_frustumCulling);
+    m_settings->setValue("cullingDistance", m_cullingDistance);
+    m_settings->setValue("levelOfDetail", m_levelOfDetail);
+    m_settings->setValue("collisionCellSize", m_collisionCellSize);
 
     // Salvare configurari camera
-    if (view && view->camera()) {
-        m_settings->setValue("cameraPosition", view->camera()->position());
-        m_settings->setValue("cameraTarget", view->camera()->viewCenter());
+    if (camera) {
+        m_settings->setValue("cameraPosition", camera->position());
+        m_settings->setValue("cameraTarget", camera->viewCenter());
     }
 
     m_settings->sync();
@@ -1347,11 +1149,80 @@ void MyOpenGLWidget::saveSettings()
 // Functii utilitare suplimentare
 void MyOpenGLWidget::resetCamera()
 {
-    if (view && view->camera()) {
-        view->camera()->setPosition(QVector3D(0, 15, 30.0f));
-        view->camera()->setViewCenter(QVector3D(0, 0, 0));
-        view->camera()->setUpVector(QVector3D(0, 1, 0));
+    if (camera) {
+        camera->setPosition(QVector3D(0, 15, 30.0f));
+        camera->setViewCenter(QVector3D(0, 0, 0));
+        camera->setUpVector(QVector3D(0, 1, 0));
+    }
+}
+
+void MyOpenGLWidget::frameScene()
+{
+    if (!camera || m_sceneStore.isEmpty()) {
+        return;
+    }
+
+    QVector3D sceneMin = m_sceneStore.boundsMin.first();
+    QVector3D sceneMax = m_sceneStore.boundsMax.first();
+    for (SceneStore::Handle h = 1; h < m_sceneStore.size(); ++h) {
+        const QVector3D &objectMin = m_sceneStore.boundsMin[h];
+        const QVector3D &objectMax = m_sceneStore.boundsMax[h];
+        sceneMin = QVector3D(qMin(sceneMin.x(), objectMin.x()), qMin(sceneMin.y(), objectMin.y()),
+                             qMin(sceneMin.z(), objectMin.z()));
+        sceneMax = QVector3D(qMax(sceneMax.x(), objectMax.x()), qMax(sceneMax.y(), objectMax.y()),
+                             qMax(sceneMax.z(), objectMax.z()));
     }
+
+    // Distanta la care sfera care cuprinde scena intra in campul vizual vertical
+    const QVector3D center = (sceneMin + sceneMax) * 0.5f;
+    const float radius = qMax((sceneMax - sceneMin).length() * 0.5f, 1.0f);
+    const float halfFov = qDegreesToRadians(camera->lens()->fieldOfView() * 0.5f);
+    const float distance = radius / qSin(halfFov);
+
+    camera->setViewCenter(center);
+    camera->setPosition(center + QVector3D(0.0f, 0.5f, 1.0f).normalized() * distance);
+    camera->setUpVector(QVector3D(0, 1, 0));
+}
+
+bool MyOpenGLWidget::isSceneReady() const
+{
+    return m_geometryCache->pendingCount() == 0 && TextureLoader::instance()->pendingCount() == 0;
+}
+
+QImage MyOpenGLWidget::renderToImage(int timeoutMs)
+{
+    if (!m_offscreen) {
+        return QImage();
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Mesh-urile si texturile se incarca asincron: fiecare mesh sau lot de texturi terminat
+    // reverifica scena, iar bucla se opreste cand totul este gata sau la timeout. Conexiunile
+    // sunt facute inainte de verificare, ca un semnal emis intre timp sa nu fie pierdut.
+    QEventLoop loop;
+    auto quitWhenReady = [this, &loop]() {
+        if (isSceneReady()) {
+            loop.quit();
+        }
+    };
+    connect(TextureLoader::instance(), &TextureLoader::idle, &loop, quitWhenReady);
+    const QVector<Qt3DRender::QMesh *> pendingMeshes = m_geometryCache->pendingMeshes();
+    for (Qt3DRender::QMesh *mesh : pendingMeshes) {
+        connect(mesh, &Qt3DRender::QMesh::statusChanged, &loop, quitWhenReady);
+    }
+    if (!isSceneReady()) {
+        QTimer::singleShot(timeoutMs, &loop, &QEventLoop::quit);
+        loop.exec();
+    }
+    if (!isSceneReady()) {
+        qDebug() << "Scene not ready after" << timeoutMs << "ms, capturing anyway";
+    }
+
+    // Nu e nevoie de un cadru de incalzire: QRenderCapture raspunde cu primul cadru randat dupa
+    // cerere, iar datele incarcate mai sus sunt deja trimise backend-ului la acel cadru
+    return m_offscreen->capture(qMax(int(timeoutMs - timer.elapsed()), 1));
 }
 
 void MyOpenGLWidget::setFloorLevel(float level)
@@ -1367,17 +1238,11 @@ void MyOpenGLWidget::setFloorLevel(float level)
         }
     }
 
-    // Repozitionare obiecte daca e nevoie
-    for (auto it = m_sceneObjects.begin(); it != m_sceneObjects.end(); ++it) {
-        SceneObject &obj = it.value();
-        QVector3D newPos = getFloorConstrainedPosition(obj.position, obj.boundingSphereRadius);
-        if (newPos != obj.position) {
-            obj.position = newPos;
-            if (obj.transform) {
-                obj.transform->setTranslation(newPos);
-            }
-        }
-    }
+    // Repozitionarea obiectelor se face in simulare; rezultatul vine cu urmatorul snapshot
+    SimulationCommand command;
+    command.type = SimulationCommand::SetFloorLevel;
+    command.value = m_floorLevel;
+    m_simulation->post(command);
 }
 
 void MyOpenGLWidget::setFloorSize(float size)
@@ -1403,49 +1268,316 @@ QStringList MyOpenGLWidget::getAvailableAnimations() const
 
 QStringList MyOpenGLWidget::getLoadedObjectIds() const
 {
-    return m_sceneObjects.keys();
+    // Ordinea handle-urilor nu este stabila; id-urile sunt intoarse sortate, ca inainte
+    QStringList ids(m_sceneStore.ids.cbegin(), m_sceneStore.ids.cend());
+    ids.sort();
+    return ids;
 }
 
 SceneObject MyOpenGLWidget::getObjectById(const QString &id) const
 {
-    return m_sceneObjects.value(id, SceneObject());
+    return m_sceneStore.object(m_sceneStore.handleOf(id));
 }
 
 void MyOpenGLWidget::removeObject(const QString &id)
 {
-    if (m_sceneObjects.contains(id)) {
-        SceneObject &obj = m_sceneObjects[id];
-        if (obj.entity) {
-            delete obj.entity;
+    const SceneStore::Handle handle = m_sceneStore.handleOf(id);
+    if (handle != SceneStore::INVALID_HANDLE) {
+        if (m_sceneStore.entities[handle]) {
+            delete m_sceneStore.entities[handle];
         }
-        m_sceneObjects.remove(id);
-
-        // Elimina animatiile orbitale asociate
-        for (int i = m_orbitalAnimations.size() - 1; i >= 0; --i) {
-            if (m_orbitalAnimations[i].primaryObjectId == id ||
-                m_orbitalAnimations[i].referenceObjectId == id) {
-                m_orbitalAnimations.removeAt(i);
-            }
+        m_geometryCache->release(ModelLod::levelPath(m_sceneStore.modelPaths[handle],
+                                                     m_sceneStore.lodLevels[handle]));
+        m_materialCache->release(m_sceneStore.materials[handle]);
+        m_sceneStore.remove(handle);
+        m_culler.invalidate();
+        m_cullingResync = true;
+
+        // Simularea sterge aceeasi intrare (si animatiile orbitale asociate)
+        SimulationCommand command;
+        command.type = SimulationCommand::RemoveObject;
+        command.id = id;
+        m_simulation->post(command);
+
+        if (m_instancedRendering) {
+            rebuildInstancing();
         }
     }
 }
 
 void MyOpenGLWidget::pauseAnimations()
 {
-    m_animationTimer->stop();
+    SimulationCommand command;
+    command.type = SimulationCommand::SetAnimationsPaused;
+    command.enabled = true;
+    m_simulation->post(command);
 }
 
 void MyOpenGLWidget::resumeAnimations()
 {
-    m_animationTimer->start(16);
+    SimulationCommand command;
+    command.type = SimulationCommand::SetAnimationsPaused;
+    command.enabled = false;
+    m_simulation->post(command);
 }
 
 void MyOpenGLWidget::pausePhysics()
 {
-    m_physicsTimer->stop();
+    SimulationCommand command;
+    command.type = SimulationCommand::SetPhysicsPaused;
+    command.enabled = true;
+    m_simulation->post(command);
 }
 
 void MyOpenGLWidget::resumePhysics()
 {
-    m_physicsTimer->start(16);
+    SimulationCommand command;
+    command.type = SimulationCommand::SetPhysicsPaused;
+    command.enabled = false;
+    m_simulation->post(command);
+}
+
+void MyOpenGLWidget::setInstancedRendering(bool enabled)
+{
+    if (m_instancedRendering == enabled) {
+        return;
+    }
+    m_instancedRendering = enabled;
+
+    if (enabled) {
+        rebuildInstancing();
+    } else {
+        m_instancedRenderer->clear();
+        for (SceneStore::Handle h = 0; h < m_sceneStore.size(); ++h) {
+            m_sceneStore.flags[h] &= quint8(~SceneStore::Batched);
+            if (m_sceneStore.entities[h]) {
+                m_sceneStore.entities[h]->setEnabled(true);
+            }
+        }
+        m_cullingDirty = true;
+        m_cullingResync = true;
+    }
+
+    qDebug() << "Instanced rendering" << (enabled ? "enabled" : "disabled");
+}
+
+void MyOpenGLWidget::rebuildInstancing()
+{
+    m_instancedRenderer->beginRebuild();
+
+    for (SceneStore::Handle h = 0; h < m_sceneStore.size(); ++h) {
+        Qt3DCore::QEntity *entity = m_sceneStore.entities[h];
+        if (!entity || !m_sceneStore.transforms[h]) {
+            continue;
+        }
+
+        // Entitatea ramane activa doar daca modelul nu poate fi instantiat
+        bool batched = m_instancedRenderer->addInstance(m_sceneStore.modelPaths[h], m_sceneStore.transforms[h],
+                                                        parseColor(m_sceneStore.colors[h]));
+        entity->setEnabled(!batched);
+        if (batched) {
+            m_sceneStore.flags[h] |= SceneStore::Batched;
+        } else {
+            m_sceneStore.flags[h] &= quint8(~SceneStore::Batched);
+        }
+    }
+
+    m_instancedRenderer->endRebuild();
+    m_cullingDirty = true;
+    m_cullingResync = true;
+}
+
+void MyOpenGLWidget::setFrustumCulling(bool enabled)
+{
+    if (m_frustumCulling == enabled) {
+        return;
+    }
+    m_frustumCulling = enabled;
+    m_cullingDirty = true;
+    m_cullingResync = true;
+
+    if (!enabled) {
+        // Toate obiectele redevin vizibile (cu exceptia celor desenate instantiat)
+        for (SceneStore::Handle h = 0; h < m_sceneStore.size(); ++h) {
+            if (m_sceneStore.entities[h]) {
+                m_sceneStore.entities[h]->setEnabled(!(m_sceneStore.flags[h] & SceneStore::Batched));
+            }
+        }
+    }
+}
+
+void MyOpenGLWidget::setCullingDistance(float distance)
+{
+    m_cullingDistance = qMax(0.0f, distance);
+    m_cullingDirty = true;
+}
+
+void MyOpenGLWidget::setLevelOfDetail(bool enabled)
+{
+    if (m_levelOfDetail == enabled) {
+        return;
+    }
+    m_levelOfDetail = enabled;
+    m_cullingDirty = true;
+
+    if (!enabled) {
+        for (SceneStore::Handle h = 0; h < m_sceneStore.size(); ++h) {
+            switchObjectLod(h, 0);
+        }
+        m_lodStats = LodStats();
+    }
+}
+
+void MyOpenGLWidget::updateCulling()
+{
+    if ((!m_frustumCulling && !m_levelOfDetail) || !camera || m_sceneStore.isEmpty()) {
+        // Mutarile nu sunt urmarite cat timp culling-ul sta; la repornire totul este refacut
+        m_movedHandles.resize(0);
+        m_cullingResync = true;
+        return;
+    }
+
+    // Nimic nou de testat daca nici camera, nici obiectele nu s-au miscat
+    const QMatrix4x4 viewProjection = camera->projectionMatrix() * camera->viewMatrix();
+    if (!m_cullingDirty && viewProjection == m_lastViewProjection) {
+        return;
+    }
+    m_cullingDirty = false;
+    m_lastViewProjection = viewProjection;
+
+    // Sfera centrata in originea obiectului cuprinde cutia in orice rotatie. Dupa o schimbare
+    // a scenei sunt refacute toate; altfel doar centrele obiectelor mutate de simulare.
+    const int count = m_sceneStore.size();
+    const bool resync = m_cullingResync || m_cullCenters.size() != count || m_movedHandles.size() > count;
+    if (resync) {
+        m_cullCenters.resize(count);
+        m_cullRadii.resize(count);
+        for (SceneStore::Handle h = 0; h < count; ++h) {
+            m_cullCenters[h] = m_sceneStore.positions[h];
+            m_cullRadii[h] = qMax(m_sceneStore.localBoundsMin[h].length(), m_sceneStore.localBoundsMax[h].length())
+                             * CULLING_RADIUS_MARGIN;
+        }
+        m_culler.invalidateBounds();
+    } else {
+        for (SceneStore::Handle h : std::as_const(m_movedHandles)) {
+            m_cullCenters[h] = m_sceneStore.positions[h];
+            m_culler.markMoved(h);
+        }
+    }
+    m_movedHandles.resize(0);
+    m_cullingResync = false;
+
+    if (m_frustumCulling) {
+        m_culler.setMaxDistance(m_cullingDistance);
+        m_culler.update(viewProjection, camera->position(), m_cullCenters, m_cullRadii, m_visible);
+
+        // setEnabled doar pentru obiectele care si-au schimbat vizibilitatea
+        auto applyVisibility = [this](SceneStore::Handle h) {
+            if (m_sceneStore.entities[h]) {
+                m_sceneStore.entities[h]->setEnabled(m_visible[h] && !(m_sceneStore.flags[h] & SceneStore::Batched));
+            }
+        };
+        if (resync) {
+            for (SceneStore::Handle h = 0; h < count; ++h) {
+                applyVisibility(h);
+            }
+        } else {
+            for (int h : m_culler.changedHandles()) {
+                applyVisibility(h);
+            }
+        }
+    } else {
+        m_visible.fill(true, count);
+    }
+
+    if (m_levelOfDetail) {
+        updateLevelsOfDetail();
+    }
+}
+
+void MyOpenGLWidget::updateLevelsOfDetail()
+{
+    // Acoperirea: raza proiectata raportata la jumatatea inaltimii ecranului
+    const float tanHalfFov = qTan(qDegreesToRadians(camera->fieldOfView() * 0.5f));
+    const QVector3D eye = camera->position();
+
+    LodStats stats;
+    int switches = 0;
+    for (SceneStore::Handle h = 0; h < m_sceneStore.size(); ++h) {
+        // Obiectele ascunse isi pastreaza nivelul; cele instantiate folosesc modelul original
+        if (!m_visible[h] || !m_sceneStore.entities[h] || (m_sceneStore.flags[h] & SceneStore::Batched)) {
+            continue;
+        }
+
+        const ModelLod::Info &info = lodInfo(m_sceneStore.modelPaths[h]);
+        if (!info.isValid()) {
+            // Nivelurile au fost sterse sau sursa s-a schimbat
+            if (m_sceneStore.lodLevels[h] != 0) {
+                switchObjectLod(h, 0);
+                ++switches;
+            }
+            ++stats.objectsWithoutLod;
+            continue;
+        }
+
+        const float radius = m_cullRadii[h];
+        const float distance = (m_cullCenters[h] - eye).length();
+        const float coverage = distance > radius ? radius / (distance * tanHalfFov) : 1.0f;
+
+        int level = qMin(int(m_sceneStore.lodLevels[h]), info.levelCount() - 1);
+        while (level + 1 < info.levelCount() && coverage < LOD_COVERAGE[level]) {
+            ++level;
+        }
+        while (level > 0 && coverage > LOD_COVERAGE[level - 1] * (1.0f + LOD_HYSTERESIS)) {
+            --level;
+        }
+        if (level != m_sceneStore.lodLevels[h]) {
+            switchObjectLod(h, level);
+            ++switches;
+        }
+
+        stats.fullDetailTriangles += info.triangles[0];
+        stats.drawnTriangles += info.triangles[level];
+        ++stats.objectsPerLevel[level];
+    }
+    m_lodStats = stats;
+
+    if (switches > 0) {
+        qDebug() << "LOD:" << switches << "switches," << stats.drawnTriangles << "of"
+                 << stats.fullDetailTriangles << "triangles drawn, objects per level"
+                 << stats.objectsPerLevel[0] << stats.objectsPerLevel[1] << stats.objectsPerLevel[2]
+                 << stats.objectsPerLevel[3];
+    }
+}
+
+void MyOpenGLWidget::switchObjectLod(SceneStore::Handle handle, int level)
+{
+    const int current = m_sceneStore.lodLevels[handle];
+    if (current == level) {
+        return;
+    }
+
+    // Fiecare nivel este o intrare separata in GeometryCache, partajata de obiectele de acelasi tip
+    const QString &modelPath = m_sceneStore.modelPaths[handle];
+    Qt3DRender::QGeometryRenderer *mesh = m_geometryCache->acquire(ModelLod::levelPath(modelPath, level));
+    Qt3DCore::QEntity *entity = m_sceneStore.entities[handle];
+    if (entity) {
+        const QVector<Qt3DRender::QGeometryRenderer *> oldMeshes =
+            entity->componentsOfType<Qt3DRender::QGeometryRenderer>();
+        for (Qt3DRender::QGeometryRenderer *oldMesh : oldMeshes) {
+            entity->removeComponent(oldMesh);
+        }
+        entity->addComponent(mesh);
+    }
+    m_geometryCache->release(ModelLod::levelPath(modelPath, current));
+    m_sceneStore.lodLevels[handle] = quint8(level);
+}
+
+const ModelLod::Info &MyOpenGLWidget::lodInfo(const QString &modelPath)
+{
+    auto it = m_lodInfo.find(modelPath);
+    if (it == m_lodInfo.end()) {
+        it = m_lodInfo.insert(modelPath, ModelLod::info(modelPath));
+    }
+    return *it;
 }
@@ -7,6 +7,9 @@
 #include <QMouseEvent>
 #include <QTimer>
 #include <QSettings>
+#include <QImage>
+#include <QHash>
+#include <QSet>
 
 #include <Qt3DCore/QEntity>
 #include <Qt3DRender/QCamera>
@@ -19,69 +22,44 @@
 #include <Qt3DAnimation/QKeyframeAnimation>
 #include <Qt3DAnimation/QMorphingAnimation>
 
-// Animation state structure for individual object animations
-struct AnimationState {
-    float bouncePhase;
-    float floatPhase;
-    float pulsePhase;
-    float swingPhase;
-    float rotationAngle;
+#include "FrustumCuller.h"
+#include "ModelLod.h"
+#include "SceneDescription.h"
+#include "SceneStore.h"
+#include "SimulationWorker.h"
 
-    AnimationState() : bouncePhase(0.0f), floatPhase(0.0f), pulsePhase(0.0f),
-                      swingPhase(0.0f), rotationAngle(0.0f) {}
-};
-
-// Object in scene struct
-struct SceneObject {
-    QString id;
-    QString type;
-    QString color;
-    QString size;
-    QVector3D position;
-    QVector3D originalPosition; // Store original position for animation calculations
-    QVector3D boundingBoxMin;
-    QVector3D boundingBoxMax;
-    float boundingSphereRadius;
-    Qt3DCore::QEntity* entity;
-    Qt3DCore::QTransform* transform;
-    QStringList animations;
-    AnimationState animationState; // Track animation phases
-    bool isDynamic;
-    QVector3D velocity;
-
-    SceneObject() : entity(nullptr), transform(nullptr), isDynamic(false),
-                   boundingSphereRadius(1.0f), velocity(QVector3D(0,0,0)) {}
-};
-
-// Orbiting animation struct
-struct OrbitalAnimation {
-    QString primaryObjectId;
-    QString referenceObjectId;
-    QString animationType;
-    float radius;
-    float speed;
-    float currentAngle;
-    QString description;
-
-    OrbitalAnimation() : radius(3.0f), speed(1.0f), currentAngle(0.0f) {}
-};
+class GeometryCache;
+class InstancedRenderer;
+class MaterialCache;
+class OffscreenRenderer;
 
 class MyOpenGLWidget : public QWidget
 {
     Q_OBJECT
 public:
-    MyOpenGLWidget(QWidget *parent = nullptr);
+    // Cu offscreenSize valid scena este randata intr-o textura, fara fereastra (vezi OffscreenRenderer)
+    MyOpenGLWidget(QWidget *parent = nullptr, const QSize &offscreenSize = QSize());
     ~MyOpenGLWidget();
 
     void loadModel(const QString &filePath);
     void clearScene();
+    // Accepta atat scene JSON cat si scene binare (.scnb, vezi SceneBinary)
     void loadScene(const QString &filePath);
+    // Scena deja parsata (ex. din MainWindow), fara a o mai scrie intr-un fisier temporar
+    void loadSceneFromJson(const QJsonObject &jsonObject);
+    // Cu incarcarea incrementala activa (setarea "incrementalLoading", bifa din Settings), o scena
+    // noua este comparata cu cea curenta dupa id: doar obiectele adaugate, sterse sau modificate
+    // sunt create, distruse sau actualizate
+    void loadSceneDescription(const SceneDescription &scene);
+    void setIncrementalLoading(bool enabled) { m_incrementalLoading = enabled; }
+    bool isIncrementalLoading() const { return m_incrementalLoading; }
     void setLanguage(const QString &lang) { m_language = lang; }
     QString getLanguage() const { return m_language; }
     void setupFloor();
     void setupLighting();
-    void checkObjectCollisions();
     void resetCamera();
+    // Pozitioneaza camera astfel incat toate obiectele incarcate sa fie vizibile
+    void frameScene();
     void setFloorLevel(float level);
     void setFloorSize(float size);
     QStringList getAvailableAnimations() const;
@@ -93,34 +71,76 @@ public:
     void pausePhysics();
     void resumePhysics();
 
+    // Randare instantiata: obiectele cu acelasi model sunt desenate intr-un singur draw call
+    void setInstancedRendering(bool enabled);
+    bool isInstancedRendering() const { return m_instancedRendering; }
+
+    // Dimensiunea celulei grilei de coliziuni (~ diametrul unui obiect tipic)
+    void setCollisionCellSize(float size);
+    float collisionCellSize() const;
+    CollisionStats lastCollisionStats() const { return m_collisionStats; }
+
+    // Obiectele din afara campului vizual (sau mai departe de cullingDistance, daca e > 0)
+    // sunt dezactivate inainte de randare; vezi FrustumCuller
+    void setFrustumCulling(bool enabled);
+    bool isFrustumCulling() const { return m_frustumCulling; }
+    void setCullingDistance(float distance);
+    float cullingDistance() const { return m_cullingDistance; }
+    CullingStats cullingStats() const { return m_culler.stats(); }
+
+    // Obiectele ale caror modele au niveluri de detaliu (vezi ModelLod) sunt desenate cu
+    // versiunea potrivita dimensiunii lor pe ecran; selectia ruleaza impreuna cu culling-ul
+    void setLevelOfDetail(bool enabled);
+    bool isLevelOfDetail() const { return m_levelOfDetail; }
+    LodStats lodStats() const { return m_lodStats; }
+
+    // Durata medie (microsecunde) a unui pas de simulare pe ultimii 60 de pasi
+    float averageAnimationFrameTime() const { return m_averageAnimationFrameTime; }
+
+    // Randare fara fereastra: geometria si texturile scenei curente au terminat de incarcat
+    bool isOffscreen() const { return m_offscreen != nullptr; }
+    bool isSceneReady() const;
+    // Asteapta scena (cel mult timeoutMs) si intoarce cadrul randat; imagine nula la esec
+    QImage renderToImage(int timeoutMs = 30000);
+
 
 protected slots:
-    void updateAnimations();
-    void updatePhysics();
+    // Aplica ultimul snapshot al simularii pe QTransform-uri, o data pe cadru randat
+    void applySimulationSnapshot();
+    // Testeaza obiectele fata de camera cand aceasta sau obiectele s-au miscat
+    void updateCulling();
+    void updateLevelsOfDetail();
 
 protected:
-    // JSON parsing and validation
-    QJsonObject parseSceneFile(const QString &filePath);
-    bool validateJsonStructure(const QJsonObject &jsonObject);
+    // Scene parsing (JSON streaming sau binar) si validarea schemei
+    bool parseSceneFile(const QString &filePath, SceneDescription &scene);
+
+    // Generate positions (vezi SceneLayoutSolver); obiectele din pinned raman pe loc
+    QMap<QString, QVector3D> generateObjectPositions(const SceneDescription &scene,
+                                                     const QSet<QString> &pinned = QSet<QString>());
 
-    // Generate positions and resolve collisions
-    QMap<QString, QVector3D> generateObjectPositions(const QJsonArray &objects, const QJsonArray &relations);
-    void resolveCollisions(QMap<QString, QVector3D> &positions);
-    bool checkAABBCollision(const SceneObject &obj1, const SceneObject &obj2);
-    bool checkSphereCollision(const SceneObject &obj1, const SceneObject &obj2);
-    void applyImpulse(SceneObject &staticObj, const SceneObject &dynamicObj);
+    // Aplicarea diferentelor fata de scena incarcata (m_loadedScene)
+    void applySceneDiff(const SceneDescription &scene);
+    void updateObjectInScene(SceneStore::Handle handle, const SceneObjectDescription &obj,
+                             const QString &color, const QVector3D &position);
+    void swapObjectMaterial(SceneStore::Handle handle, const QString &objectType, const QString &color);
 
     // Spawn and object management
     void spawnObjectsInScene(const QMap<QString, QVector3D> &positions,
-                           const QMap<QString, QString> &colors,
-                           const QJsonArray &objects);
+                           const SceneDescription &scene);
     void loadModelInScene(const QString &objectType, const QString &color,
                          const QString &size, float x, float y, float z,
                          const QStringList &animations, const QString &id);
+    // Transformarea, intrarea din SceneStore si din simulare pentru o entitate deja construita
+    void registerSceneObject(const QString &id, const QString &objectType, const QString &color,
+                             const QString &size, const QString &modelPath,
+                             Qt3DCore::QEntity *entity, Qt3DCore::QTransform *transform,
+                             Qt3DRender::QMaterial *material, const QVector3D &layoutPosition,
+                             const QStringList &animations);
 
     // Animation setup
-    void setupAnimations(const QJsonArray &objects, const QJsonArray &animationCouples);
-    void setupObjectAnimation(SceneObject &obj, const QString &animationType);
+    void setupAnimations(const SceneDescription &scene);
+    void setupObjectAnimation(SceneStore::Handle handle, const QString &animationType);
     void setupOrbitalAnimation(const QString &primaryId, const QString &referenceId,
                               const QString &animationType, const QString &description);
 
@@ -130,9 +150,16 @@ protected:
     float calculateBoundingSphere(const QString &objectType, const QString &size);
     QString getModelPath(const QString &objectType);
     bool hasPBRTextures(const QString &objectType);
+    // Material din MaterialCache: PBR pentru tipurile cu texturi, Phong pentru restul
+    Qt3DRender::QMaterial *acquireMaterial(const QString &objectType, const QColor &color);
     QColor parseColor(const QString &colorString);
     float getSizeMultiplier(const QString &size);
-    QVector3D getFloorConstrainedPosition(const QVector3D &position, float objectHeight);
+    QVector3D getFloorConstrainedPosition(const QVector3D &position, const QVector3D &minBounds);
+    void rebuildInstancing();
+    void postAddObject(SceneStore::Handle handle);
+    // Inlocuieste geometria obiectului cu nivelul cerut (0 = modelul original)
+    void switchObjectLod(SceneStore::Handle handle, int level);
+    const ModelLod::Info &lodInfo(const QString &modelPath);
 
     // Settings
     void loadSettings();
@@ -140,18 +167,45 @@ protected:
 
 private:
     Qt3DExtras::Qt3DWindow *view;
+    OffscreenRenderer *m_offscreen;
     Qt3DCore::QEntity *rootEntity;
     Qt3DCore::QEntity *floorEntity;
     Qt3DRender::QCamera *camera;
 
     // Scene management
-    QMap<QString, SceneObject> m_sceneObjects;
-    QVector<OrbitalAnimation> m_orbitalAnimations;
-
-    // Animation and physics
-    QTimer *m_animationTimer;
-    QTimer *m_physicsTimer;
-    float m_animationTime; // Global animation time for synchronization
+    SceneStore m_sceneStore;
+    GeometryCache *m_geometryCache;
+    InstancedRenderer *m_instancedRenderer;
+    MaterialCache *m_materialCache;
+    bool m_instancedRendering;
+    bool m_incrementalLoading;
+    SceneDescription m_loadedScene; // descrierea din care a fost construita scena curenta
+
+    // Culling (vezi updateCulling)
+    FrustumCuller m_culler;
+    bool m_frustumCulling;
+    float m_cullingDistance;
+    bool m_cullingDirty;
+    // Setul de obiecte sau starea entitatilor s-a schimbat in afara culling-ului: urmatorul
+    // updateCulling reface toate sferele si aplica vizibilitatea fiecarui obiect
+    bool m_cullingResync;
+    bool m_snapshotResync; // un snapshot a fost preluat fara sa fie aplicat
+    QMatrix4x4 m_lastViewProjection;
+    QVector<QVector3D> m_cullCenters;
+    QVector<float> m_cullRadii;
+    QVector<bool> m_visible;
+    QVector<SceneStore::Handle> m_movedHandles; // din snapshot-uri, de la ultimul updateCulling
+
+    // Niveluri de detaliu (vezi updateLevelsOfDetail)
+    bool m_levelOfDetail;
+    QHash<QString, ModelLod::Info> m_lodInfo; // manifestele citite, golit la catalogChanged
+    LodStats m_lodStats;
+
+    // Animatii, fizica si coliziuni (fir separat, vezi SimulationWorker)
+    SimulationWorker *m_simulation;
+    float m_collisionCellSize;
+    CollisionStats m_collisionStats;
+    float m_averageAnimationFrameTime;
 
     // Floor configuration
     float m_floorLevel;
@@ -162,10 +216,14 @@ private:
     QSettings *m_settings;
 
     // Constants
-    static constexpr float GRAVITY = -9.81f;
     static constexpr float DEFAULT_SPACING = 3.0f;
-    static constexpr float COLLISION_TOLERANCE = 0.1f;
-    static constexpr float IMPULSE_STRENGTH = 2.0f;
+    static constexpr float MODEL_SCALE = 2.0f; // scala transformarii pentru dimensiunea "medium"
+    static constexpr float LAYOUT_GAP = 0.5f; // distanta minima intre obiectele asezate
+    static constexpr float DEFAULT_COLLISION_CELL_SIZE = 4.0f;
+    static constexpr float CULLING_RADIUS_MARGIN = 1.2f; // animatia pulse mareste obiectul cu pana la 20%
+    // Sub aceste fractiuni din jumatatea inaltimii ecranului obiectul trece la nivelul urmator
+    static constexpr float LOD_COVERAGE[ModelLod::MAX_LEVELS - 1] = { 0.25f, 0.1f, 0.04f };
+    static constexpr float LOD_HYSTERESIS = 0.15f; // revenirea la un nivel mai detaliat cere cu 15% mai mult
 };
 
 #endif // MYOPENGLWIDGET_H
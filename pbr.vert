@@ -1,10 +1,10 @@
 #version 330 core
 
-layout(location = 0) in vec3 position;
-layout(location = 1) in vec3 normal;
-layout(location = 2) in vec2 texCoords;
-// Tangent optional
-layout(location = 3) in vec3 tangent;
+layout(location = 0) in vec3 vertexPosition;
+layout(location = 1) in vec3 vertexNormal;
+layout(location = 2) in vec2 vertexTexCoord;
+// Tangent optional; w = sensul bitangentei (+1/-1)
+layout(location = 3) in vec4 vertexTangent;
 
 out vec2 TexCoords;
 out vec3 FragPos;
@@ -17,19 +17,24 @@ uniform mat4 projectionMatrix;
 
 void main()
 {
-    FragPos = vec3(modelMatrix * vec4(position, 1.0));
-    TexCoords = texCoords;
+    FragPos = vec3(modelMatrix * vec4(vertexPosition, 1.0));
+    TexCoords = vertexTexCoord;
 
-    vec3 N = normalize(mat3(modelMatrix) * normal);
-    vec3 T = normalize(mat3(modelMatrix) * tangent);
-    vec3 B = cross(N, T);
+    vec3 N = normalize(mat3(modelMatrix) * vertexNormal);
+    vec3 T = mat3(modelMatrix) * vertexTangent.xyz;
+    vec3 B;
 
-    // fallback simplu daca tangenta e nula
+    // fallback simplu daca tangenta e nula (verificata inainte de normalizare, altfel NaN)
     if (length(T) < 0.01)
     {
         T = normalize(cross(N, vec3(0.0, 1.0, 0.0)));
         B = cross(N, T);
     }
+    else
+    {
+        T = normalize(T);
+        B = cross(N, T) * (vertexTangent.w < 0.0 ? -1.0 : 1.0);
+    }
 
     TBN = mat3(T, B, N);
     Normal = N;
@@ -0,0 +1,24 @@
+#version 330 core
+
+in vec2 TexCoords;
+in vec3 FragPos;
+in vec3 Normal;
+in vec3 InstanceColor;
+
+out vec4 FragColor;
+
+uniform vec3 lightPositions[1];
+uniform vec3 lightColors[1];
+uniform float lightIntensity;
+
+void main()
+{
+    vec3 N = normalize(Normal);
+    vec3 L = normalize(lightPositions[0] - FragPos);
+    float diff = max(dot(N, L), 0.0);
+
+    vec3 ambient = 0.2 * InstanceColor;
+    vec3 color = ambient + InstanceColor * lightColors[0] * diff * lightIntensity;
+
+    FragColor = vec4(color, 1.0);
+}
@@ -0,0 +1,37 @@
+#version 330 core
+
+// Varianta instantiata a pbr.vert: transformarea si culoarea vin per instanta
+in vec3 vertexPosition;
+in vec3 vertexNormal;
+in vec2 vertexTexCoord;
+
+in vec4 instanceTranslationScale; // xyz = translatie, w = scala uniforma
+in vec4 instanceRotation;         // quaternion (x, y, z, w)
+in vec4 instanceColor;
+
+out vec2 TexCoords;
+out vec3 FragPos;
+out vec3 Normal;
+out vec3 InstanceColor;
+
+uniform mat4 modelMatrix;
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+
+vec3 rotateByQuaternion(vec3 v, vec4 q)
+{
+    return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);
+}
+
+void main()
+{
+    vec3 local = rotateByQuaternion(vertexPosition * instanceTranslationScale.w, instanceRotation)
+               + instanceTranslationScale.xyz;
+
+    FragPos = vec3(modelMatrix * vec4(local, 1.0));
+    Normal = normalize(mat3(modelMatrix) * rotateByQuaternion(vertexNormal, instanceRotation));
+    TexCoords = vertexTexCoord;
+    InstanceColor = instanceColor.rgb;
+
+    gl_Position = projectionMatrix * viewMatrix * vec4(FragPos, 1.0);
+}
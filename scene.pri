@@ -0,0 +1,67 @@
+# Constructia scenei (MyOpenGLWidget si tot ce foloseste), comuna aplicatiei si randarii in lot
+QT       += core gui 3dcore 3drender 3dinput 3dextras 3dquick 3dlogic
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets openglwidgets
+
+CONFIG += c++17
+
+SOURCES += \
+    AnimationKernel.cpp \
+    AssetStore.cpp \
+    FrustumCuller.cpp \
+    GeometryCache.cpp \
+    InstancedRenderer.cpp \
+    MaterialCache.cpp \
+    MeshCooker.cpp \
+    MeshData.cpp \
+    MeshSimplifier.cpp \
+    ModelBounds.cpp \
+    ModelCatalog.cpp \
+    ModelLod.cpp \
+    OffscreenRenderer.cpp \
+    PBRMaterial.cpp \
+    SceneBinary.cpp \
+    SceneDescription.cpp \
+    SceneJsonParser.cpp \
+    SceneLayoutSolver.cpp \
+    SceneStore.cpp \
+    SimulationWorker.cpp \
+    SpatialHash.cpp \
+    TextureBaker.cpp \
+    TextureLoader.cpp \
+    myopenglwidget.cpp
+
+HEADERS += \
+    AnimationKernel.h \
+    AssetStore.h \
+    FrustumCuller.h \
+    GeometryCache.h \
+    InstancedRenderer.h \
+    MaterialCache.h \
+    MeshCooker.h \
+    MeshData.h \
+    MeshSimplifier.h \
+    ModelBounds.h \
+    ModelCatalog.h \
+    ModelLod.h \
+    OffscreenRenderer.h \
+    PBRMaterial.h \
+    SceneBinary.h \
+    SceneDescription.h \
+    SceneJsonParser.h \
+    SceneLayoutSolver.h \
+    SceneStore.h \
+    SimulationWorker.h \
+    SpatialHash.h \
+    SpscQueue.h \
+    TextureBaker.h \
+    TextureLoader.h \
+    myopenglwidget.h
+
+DISTFILES += \
+    pbr.frag \
+    pbr.vert \
+    pbr_instanced.frag \
+    pbr_instanced.vert
+
+win32: LIBS += -lopengl32